@@ -0,0 +1,298 @@
+#ifndef MATH_PRACTICE_AND_OPERATING_SYSTEMS_BIG_FLOAT_H
+#define MATH_PRACTICE_AND_OPERATING_SYSTEMS_BIG_FLOAT_H
+
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <string>
+
+#include <big_integer.h>
+
+// mantissa * 2^exponent with the mantissa rounded to a fixed count of bits after every operation,
+// so long computations keep their operands at the same size instead of growing them as fractions do
+class big_float final
+{
+
+public:
+
+    enum class rounding_mode
+    {
+        to_nearest_even,
+        toward_zero,
+        toward_positive_infinity,
+        toward_negative_infinity
+    };
+
+    static constexpr size_t default_precision = 256;
+
+private:
+
+    // odd or zero, of at most _precision bits; zero has a zero exponent, so equal values have equal representations
+    big_integer _mantissa;
+
+    int64_t _exponent;
+
+    size_t _precision;
+
+    rounding_mode _rounding;
+
+public:
+
+    // zero
+    explicit big_float(
+        size_t precision = default_precision,
+        rounding_mode rounding = rounding_mode::to_nearest_even);
+
+    explicit big_float(
+        big_integer const &value,
+        size_t precision = default_precision,
+        rounding_mode rounding = rounding_mode::to_nearest_even);
+
+    // numerator / denominator rounded once; throws std::logic_error for a zero denominator
+    big_float(
+        big_integer const &numerator,
+        big_integer const &denominator,
+        size_t precision = default_precision,
+        rounding_mode rounding = rounding_mode::to_nearest_even);
+
+    // decimal digits with an optional point and an optional exponent of ten, as in "-12.5e-3";
+    // throws std::invalid_argument for anything else
+    explicit big_float(
+        std::string const &value_as_string,
+        size_t precision = default_precision,
+        rounding_mode rounding = rounding_mode::to_nearest_even);
+
+public:
+
+    [[nodiscard]] size_t get_precision() const noexcept;
+
+    [[nodiscard]] rounding_mode get_rounding() const noexcept;
+
+    // rounds the value when the precision shrinks
+    big_float &set_precision(
+        size_t precision);
+
+    big_float &set_rounding(
+        rounding_mode rounding) noexcept;
+
+    [[nodiscard]] big_integer const &get_mantissa() const noexcept;
+
+    [[nodiscard]] int64_t get_exponent() const noexcept;
+
+public:
+
+    bool operator==(
+        big_float const &other) const;
+
+    bool operator!=(
+        big_float const &other) const;
+
+public:
+
+    bool operator<(
+        big_float const &other) const;
+
+    bool operator>(
+        big_float const &other) const;
+
+    bool operator<=(
+        big_float const &other) const;
+
+    bool operator>=(
+        big_float const &other) const;
+
+public:
+
+    // results take the larger precision of the operands and the rounding of the left one
+
+    big_float operator-() const;
+
+    big_float &operator+=(
+        big_float const &other);
+
+    big_float operator+(
+        big_float const &other) const;
+
+    big_float &operator-=(
+        big_float const &other);
+
+    big_float operator-(
+        big_float const &other) const;
+
+    big_float &operator*=(
+        big_float const &other);
+
+    big_float operator*(
+        big_float const &other) const;
+
+    // throws std::logic_error for a zero divisor
+    big_float &operator/=(
+        big_float const &other);
+
+    big_float operator/(
+        big_float const &other) const;
+
+public:
+
+    // the functions are rounded correctly to the precision and the rounding of the argument: their approximations
+    // widen until the whole error interval rounds to one value, and the exact values are taken apart;
+    // the ones outside their domain throw std::invalid_argument, poles throw std::logic_error
+
+    big_float sin() const;
+
+    big_float cos() const;
+
+    big_float tg() const;
+
+    big_float ctg() const;
+
+    big_float sec() const;
+
+    big_float cosec() const;
+
+    big_float arcsin() const;
+
+    big_float arccos() const;
+
+    big_float arctg() const;
+
+    // in (0, pi)
+    big_float arcctg() const;
+
+    big_float arcsec() const;
+
+    big_float arccosec() const;
+
+public:
+
+    // 0^0 = 1
+    big_float pow(
+        size_t degree) const;
+
+public:
+
+    // correctly rounded; negative values take odd degrees only
+    big_float root(
+        size_t degree) const;
+
+public:
+
+    big_float log2() const;
+
+    big_float ln() const;
+
+    big_float lg() const;
+
+public:
+
+    // pi and the logarithms of 2 and 10 the functions take come from the process-wide caches of the constants,
+    // shared with fraction
+
+    static big_float pi(
+        size_t precision = default_precision,
+        rounding_mode rounding = rounding_mode::to_nearest_even);
+
+public:
+
+    // the shortest scientific notation of significant_digits decimal digits, as in "-1.25e-3";
+    // zero digits take enough of them to tell apart any two values of the precision
+    std::string to_string(
+        size_t significant_digits = 0) const;
+
+public:
+
+    friend std::ostream &operator<<(
+        std::ostream &stream,
+        big_float const &value);
+
+    // keeps the precision and the rounding of value
+    friend std::istream &operator>>(
+        std::istream &stream,
+        big_float &value);
+
+private:
+
+    // *this = (mantissa + something of less than a unit of its last bit when is_inexact) * 2^exponent,
+    // rounded to the own precision; an inexact mantissa is taken at two bits over the precision at least
+    void assign_rounded(
+        big_integer &&mantissa,
+        int64_t exponent,
+        bool is_inexact);
+
+    // *this = dividend / divisor * 2^exponent, rounded once; throws std::logic_error for a zero divisor
+    void assign_quotient(
+        big_integer const &dividend,
+        big_integer const &divisor,
+        int64_t exponent);
+
+    // a copy rounded to other settings
+    big_float with_precision(
+        size_t precision,
+        rounding_mode rounding) const;
+
+    bool is_zero() const noexcept;
+
+    bool is_negative() const;
+
+    // the exponent of the bit above the highest one of the mantissa, so 2^(top - 1) <= |*this| < 2^top
+    int64_t get_top() const noexcept;
+
+    // *this * 2^bits, rounded towards minus infinity
+    big_integer to_fixed(
+        size_t bits) const;
+
+    // rounds (value +- error) * 2^exponent and keeps the result if both ends round to the same value
+    bool assign_rounded_within(
+        big_integer const &value,
+        big_integer const &error,
+        int64_t exponent);
+
+    // the same for an approximation of the precision within the error of the fixed point kernels
+    bool assign_rounded_within(
+        big_float const &approximation,
+        size_t precision);
+
+    // the same for the quotient of a dividend and a divisor within error each
+    bool assign_quotient_within(
+        big_integer const &dividend,
+        big_integer const &divisor,
+        big_integer const &error,
+        int64_t exponent);
+
+    // the first result attempt(result, precision) rounds, for the working precision and the wider ones after it;
+    // result comes at the own precision and rounding
+    big_float round_correctly(
+        std::function<bool(big_float &, size_t)> const &attempt) const;
+
+    // *this moved by less than a unit of its last bit, up or down in magnitude, and rounded
+    big_float nudged(
+        bool is_magnitude_up) const;
+
+    // x^2 - 1 rounded once to precision bits to nearest
+    big_float get_square_less_one(
+        size_t precision) const;
+
+    // |*this| < 2^-(precision + 2), so the functions that are about x or about one from x^2 on are nudged x or one
+    bool is_tiny() const noexcept;
+
+    // the precision functions are evaluated with first
+    size_t get_working_precision() const noexcept;
+
+    // sine and cosine scaled by 2^bits; bits comes in as the precision to keep and grows for the small arguments
+    // and until the argument reduced modulo pi / 2 keeps enough significant bits
+    void fixed_sin_cos(
+        big_integer &sine,
+        big_integer &cosine,
+        size_t &bits) const;
+
+    // the natural logarithm scaled by 2^bits; bits comes in as the precision to keep and grows for the values close to one
+    big_integer fixed_ln(
+        size_t &bits) const;
+
+    static int compare(
+        big_float const &first,
+        big_float const &second);
+
+};
+
+#endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_BIG_FLOAT_H
\ No newline at end of file
@@ -0,0 +1,1503 @@
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+
+#include <constants.h>
+
+#include "../include/big_float.h"
+
+namespace
+{
+
+    // region big integer helpers
+
+    bool is_negative_integer(
+        big_integer const &value)
+    {
+        return value < big_integer(0);
+    }
+
+    big_integer absolute(
+        big_integer const &value)
+    {
+        return is_negative_integer(value)
+            ? -value
+            : value;
+    }
+
+    big_integer power_of_ten(
+        size_t exponent)
+    {
+        return big_integer::pow(big_integer(10), exponent);
+    }
+
+    // value * 2^shift, rounded towards minus infinity for negative shifts
+    big_integer shifted(
+        big_integer value,
+        int64_t shift)
+    {
+        if (shift >= 0)
+        {
+            value <<= static_cast<size_t>(shift);
+        }
+        else
+        {
+            value >>= static_cast<size_t>(-shift);
+        }
+        return value;
+    }
+
+    // the lowest bits of value, count < 64
+    size_t low_bits(
+        big_integer const &value,
+        size_t count)
+    {
+        big_integer const masked = value & big_integer((uint64_t(1) << count) - 1);
+        size_t result = 0;
+        while (masked != big_integer(result))
+        {
+            ++result;
+        }
+        return result;
+    }
+
+    // the fixed point kernels are good to this many units of their last bit
+    big_integer const &fixed_error()
+    {
+        static big_integer const value(16);
+        return value;
+    }
+
+    void throw_if_invalid_precision(
+        size_t precision)
+    {
+        if (precision == 0)
+        {
+            throw std::invalid_argument("precision can't be zero");
+        }
+    }
+
+    // endregion big integer helpers
+
+    // region fixed point kernels
+
+    // fixed point values are integers scaled by 2^bits, every operation truncates
+
+    big_integer fixed_multiply(
+        big_integer const &first,
+        big_integer const &second,
+        size_t bits)
+    {
+        big_integer result = big_integer::multiply(first, second);
+        result >>= bits;
+        return result;
+    }
+
+    big_integer fixed_divide(
+        big_integer const &dividend,
+        big_integer const &divisor,
+        size_t bits)
+    {
+        return (dividend << bits) / divisor;
+    }
+
+    // sine and cosine of |x| <= 1: the series run for x / 2^halvings, then the angle doubles back
+    void fixed_sin_cos_reduced(
+        big_integer const &x,
+        size_t bits,
+        big_integer &sine,
+        big_integer &cosine)
+    {
+        size_t const halvings = static_cast<size_t>(std::sqrt(static_cast<double>(bits))) / 2;
+        size_t const guard = constants::guard_bits(bits);
+        size_t const working_bits = bits + halvings + guard;
+        big_integer const one_fixed = big_integer::power_of_two(working_bits);
+
+        // the terms are kept positive, so the truncations end the series
+        big_integer const argument = absolute(x) << guard;
+        big_integer const square = fixed_multiply(argument, argument, working_bits);
+
+        sine = argument;
+        big_integer term = argument;
+        for (uint64_t n = 2; term != big_integer(0); n += 2)
+        {
+            term = fixed_multiply(term, square, working_bits) / big_integer(n * (n + 1));
+            if (n % 4 == 2)
+            {
+                sine -= term;
+            }
+            else
+            {
+                sine += term;
+            }
+        }
+
+        cosine = one_fixed;
+        term = one_fixed;
+        for (uint64_t n = 1; term != big_integer(0); n += 2)
+        {
+            term = fixed_multiply(term, square, working_bits) / big_integer(n * (n + 1));
+            if (n % 4 == 1)
+            {
+                cosine -= term;
+            }
+            else
+            {
+                cosine += term;
+            }
+        }
+
+        for (size_t i = 0; i < halvings; ++i)
+        {
+            // sin 2a = 2 sin a cos a, cos 2a = 1 - 2 sin^2 a
+            big_integer const sine_square = fixed_multiply(sine, sine, working_bits);
+            sine = fixed_multiply(sine, cosine, working_bits) << 1;
+            cosine = one_fixed - (sine_square << 1);
+        }
+
+        sine >>= working_bits - bits;
+        cosine >>= working_bits - bits;
+        if (is_negative_integer(x))
+        {
+            sine = -sine;
+        }
+    }
+
+    // atan x for 0 <= x <= 1: atan x = 2 atan(x / (1 + sqrt(1 + x^2))) takes the argument down before the series
+    big_integer fixed_arctangent_reduced(
+        big_integer const &x,
+        size_t bits)
+    {
+        size_t const halvings = static_cast<size_t>(std::sqrt(static_cast<double>(bits))) / 4;
+        size_t const guard = constants::guard_bits(bits);
+        size_t const working_bits = bits + halvings + guard;
+        big_integer const one_fixed = big_integer::power_of_two(working_bits);
+        big_integer const one_fixed_square = big_integer::power_of_two(2 * working_bits);
+
+        big_integer argument = x << (halvings + guard);
+        for (size_t i = 0; i < halvings; ++i)
+        {
+            big_integer const hypotenuse = big_integer::isqrt(one_fixed_square + argument * argument);
+            argument = fixed_divide(argument, one_fixed + hypotenuse, working_bits);
+        }
+
+        big_integer const square = fixed_multiply(argument, argument, working_bits);
+        big_integer result = argument;
+        big_integer power = argument;
+        for (uint64_t n = 3; power != big_integer(0); n += 2)
+        {
+            power = fixed_multiply(power, square, working_bits);
+            big_integer const term = power / big_integer(n);
+            if (n % 4 == 3)
+            {
+                result -= term;
+            }
+            else
+            {
+                result += term;
+            }
+        }
+
+        // the halvings scale the result back up
+        result >>= guard;
+        return result;
+    }
+
+    // ln y = 2 atanh((y - 1) / (y + 1)) for y between 1 / sqrt 2 and sqrt 2;
+    // ln y = 2^halvings ln y^(1 / 2^halvings) takes y closer to one before the series
+    big_integer fixed_ln_reduced(
+        big_integer const &y,
+        size_t bits)
+    {
+        size_t const halvings = static_cast<size_t>(std::sqrt(static_cast<double>(bits))) / 4;
+        size_t const guard = constants::guard_bits(bits);
+        size_t const working_bits = bits + halvings + guard;
+        big_integer const one_fixed = big_integer::power_of_two(working_bits);
+
+        big_integer argument = y << (halvings + guard);
+        for (size_t i = 0; i < halvings; ++i)
+        {
+            argument = big_integer::isqrt(argument << working_bits);
+        }
+        big_integer const difference = argument - one_fixed;
+
+        big_integer const ratio = fixed_divide(absolute(difference), argument + one_fixed, working_bits);
+        big_integer const square = fixed_multiply(ratio, ratio, working_bits);
+        big_integer result = ratio;
+        big_integer power = ratio;
+        for (uint64_t n = 3; power != big_integer(0); n += 2)
+        {
+            power = fixed_multiply(power, square, working_bits);
+            result += power / big_integer(n);
+        }
+
+        // the halvings scale the result back up
+        result <<= 1;
+        result >>= guard;
+        return is_negative_integer(difference)
+            ? -result
+            : result;
+    }
+
+    // endregion fixed point kernels
+
+}
+
+big_float::big_float(
+    size_t precision,
+    rounding_mode rounding):
+        _mantissa(big_integer(0)),
+        _exponent(0),
+        _precision(precision),
+        _rounding(rounding)
+{
+    throw_if_invalid_precision(precision);
+}
+
+big_float::big_float(
+    big_integer const &value,
+    size_t precision,
+    rounding_mode rounding):
+        big_float(precision, rounding)
+{
+    assign_rounded(big_integer(value), 0, false);
+}
+
+big_float::big_float(
+    big_integer const &numerator,
+    big_integer const &denominator,
+    size_t precision,
+    rounding_mode rounding):
+        big_float(precision, rounding)
+{
+    assign_quotient(numerator, denominator, 0);
+}
+
+big_float::big_float(
+    std::string const &value_as_string,
+    size_t precision,
+    rounding_mode rounding):
+        big_float(precision, rounding)
+{
+    auto const is_digit = [](char symbol) { return std::isdigit(static_cast<unsigned char>(symbol)) != 0; };
+
+    size_t position = 0;
+    bool is_negative_value = false;
+    if (position < value_as_string.size() && (value_as_string[position] == '-' || value_as_string[position] == '+'))
+    {
+        is_negative_value = value_as_string[position++] == '-';
+    }
+
+    std::string digits;
+    int64_t decimal_exponent = 0;
+    for (; position < value_as_string.size() && is_digit(value_as_string[position]); ++position)
+    {
+        digits += value_as_string[position];
+    }
+    if (position < value_as_string.size() && value_as_string[position] == '.')
+    {
+        for (++position; position < value_as_string.size() && is_digit(value_as_string[position]); ++position)
+        {
+            digits += value_as_string[position];
+            --decimal_exponent;
+        }
+    }
+    if (digits.empty())
+    {
+        throw std::invalid_argument("no digits in \"" + value_as_string + "\"");
+    }
+
+    if (position < value_as_string.size() && (value_as_string[position] == 'e' || value_as_string[position] == 'E'))
+    {
+        size_t const exponent_start = ++position;
+        if (position < value_as_string.size() && (value_as_string[position] == '-' || value_as_string[position] == '+'))
+        {
+            ++position;
+        }
+        if (position == value_as_string.size() || !is_digit(value_as_string[position]))
+        {
+            throw std::invalid_argument("no exponent digits in \"" + value_as_string + "\"");
+        }
+        for (; position < value_as_string.size() && is_digit(value_as_string[position]); ++position)
+        {
+        }
+
+        try
+        {
+            decimal_exponent += std::stoll(value_as_string.substr(exponent_start, position - exponent_start));
+        }
+        catch (std::out_of_range const &)
+        {
+            throw std::invalid_argument("exponent is out of range in \"" + value_as_string + "\"");
+        }
+    }
+    if (position != value_as_string.size())
+    {
+        throw std::invalid_argument("unexpected symbols in \"" + value_as_string + "\"");
+    }
+
+    big_integer value(digits, 10);
+    if (is_negative_value)
+    {
+        value = -value;
+    }
+
+    if (decimal_exponent >= 0)
+    {
+        assign_rounded(value * power_of_ten(static_cast<size_t>(decimal_exponent)), 0, false);
+    }
+    else
+    {
+        assign_quotient(value, power_of_ten(static_cast<size_t>(-decimal_exponent)), 0);
+    }
+}
+
+size_t big_float::get_precision() const noexcept
+{
+    return _precision;
+}
+
+big_float::rounding_mode big_float::get_rounding() const noexcept
+{
+    return _rounding;
+}
+
+big_float &big_float::set_precision(
+    size_t precision)
+{
+    throw_if_invalid_precision(precision);
+
+    _precision = precision;
+    assign_rounded(std::move(_mantissa), _exponent, false);
+    return *this;
+}
+
+big_float &big_float::set_rounding(
+    rounding_mode rounding) noexcept
+{
+    _rounding = rounding;
+    return *this;
+}
+
+big_integer const &big_float::get_mantissa() const noexcept
+{
+    return _mantissa;
+}
+
+int64_t big_float::get_exponent() const noexcept
+{
+    return _exponent;
+}
+
+bool big_float::operator==(
+    big_float const &other) const
+{
+    return _exponent == other._exponent && _mantissa == other._mantissa;
+}
+
+bool big_float::operator!=(
+    big_float const &other) const
+{
+    return !(*this == other);
+}
+
+bool big_float::operator<(
+    big_float const &other) const
+{
+    return compare(*this, other) < 0;
+}
+
+bool big_float::operator>(
+    big_float const &other) const
+{
+    return compare(*this, other) > 0;
+}
+
+bool big_float::operator<=(
+    big_float const &other) const
+{
+    return compare(*this, other) <= 0;
+}
+
+bool big_float::operator>=(
+    big_float const &other) const
+{
+    return compare(*this, other) >= 0;
+}
+
+big_float big_float::operator-() const
+{
+    big_float result = *this;
+    result._mantissa = -result._mantissa;
+    return result;
+}
+
+big_float &big_float::operator+=(
+    big_float const &other)
+{
+    _precision = std::max(_precision, other._precision);
+    if (other.is_zero())
+    {
+        return *this;
+    }
+    if (is_zero())
+    {
+        _mantissa = other._mantissa;
+        _exponent = other._exponent;
+        return *this;
+    }
+
+    big_float const &larger = get_top() >= other.get_top()
+        ? *this
+        : other;
+    big_float const &smaller = &larger == this
+        ? other
+        : *this;
+
+    // two zero bits and the rounding bits over a unit at cut
+    int64_t const cut = std::min(larger.get_top() - static_cast<int64_t>(_precision) - 3, larger._exponent - 2);
+    if (smaller.get_top() <= cut)
+    {
+        // the smaller operand is below the unit at cut, and one such unit of its sign rounds the same way
+        big_integer sum = larger._mantissa << static_cast<size_t>(larger._exponent - cut);
+        if (smaller.is_negative())
+        {
+            sum -= big_integer(1);
+        }
+        else
+        {
+            sum += big_integer(1);
+        }
+        assign_rounded(std::move(sum), cut, false);
+        return *this;
+    }
+
+    int64_t const exponent = std::min(_exponent, other._exponent);
+    big_integer sum = _mantissa << static_cast<size_t>(_exponent - exponent);
+    sum += other._mantissa << static_cast<size_t>(other._exponent - exponent);
+    assign_rounded(std::move(sum), exponent, false);
+    return *this;
+}
+
+big_float big_float::operator+(
+    big_float const &other) const
+{
+    return big_float(*this) += other;
+}
+
+big_float &big_float::operator-=(
+    big_float const &other)
+{
+    return *this += -other;
+}
+
+big_float big_float::operator-(
+    big_float const &other) const
+{
+    return big_float(*this) -= other;
+}
+
+big_float &big_float::operator*=(
+    big_float const &other)
+{
+    _precision = std::max(_precision, other._precision);
+    assign_rounded(_mantissa * other._mantissa, _exponent + other._exponent, false);
+    return *this;
+}
+
+big_float big_float::operator*(
+    big_float const &other) const
+{
+    return big_float(*this) *= other;
+}
+
+big_float &big_float::operator/=(
+    big_float const &other)
+{
+    _precision = std::max(_precision, other._precision);
+    big_integer const dividend = _mantissa;
+    assign_quotient(dividend, other._mantissa, _exponent - other._exponent);
+    return *this;
+}
+
+big_float big_float::operator/(
+    big_float const &other) const
+{
+    return big_float(*this) /= other;
+}
+
+big_float big_float::sin() const
+{
+    if (is_zero())
+    {
+        return *this;
+    }
+    // sin x = x (1 - x^2 / 6 + ...)
+    if (is_tiny())
+    {
+        return nudged(false);
+    }
+
+    return round_correctly([this](big_float &result, size_t precision)
+    {
+        big_integer sine(0);
+        big_integer cosine(0);
+        size_t bits = precision;
+        fixed_sin_cos(sine, cosine, bits);
+        return result.assign_rounded_within(sine, fixed_error(), -static_cast<int64_t>(bits));
+    });
+}
+
+big_float big_float::cos() const
+{
+    big_float const unit(big_integer(1), _precision, _rounding);
+    if (is_zero())
+    {
+        return unit;
+    }
+    // cos x = 1 - x^2 / 2 + ...
+    if (is_tiny())
+    {
+        return unit.nudged(false);
+    }
+
+    return round_correctly([this](big_float &result, size_t precision)
+    {
+        big_integer sine(0);
+        big_integer cosine(0);
+        size_t bits = precision;
+        fixed_sin_cos(sine, cosine, bits);
+        return result.assign_rounded_within(cosine, fixed_error(), -static_cast<int64_t>(bits));
+    });
+}
+
+big_float big_float::tg() const
+{
+    if (is_zero())
+    {
+        return *this;
+    }
+    // tg x = x (1 + x^2 / 3 + ...)
+    if (is_tiny())
+    {
+        return nudged(true);
+    }
+
+    return round_correctly([this](big_float &result, size_t precision)
+    {
+        big_integer sine(0);
+        big_integer cosine(0);
+        size_t bits = precision;
+        fixed_sin_cos(sine, cosine, bits);
+        return result.assign_quotient_within(sine, cosine, fixed_error(), 0);
+    });
+}
+
+big_float big_float::ctg() const
+{
+    if (is_zero())
+    {
+        throw std::logic_error("attempt to divide by zero");
+    }
+    // ctg x = (1 - x^2 / 3 - ...) / x, and 1 / x is exact for the powers of two
+    if (is_tiny() && absolute(_mantissa) == big_integer(1))
+    {
+        return (big_float(big_integer(1), _precision, _rounding) / *this).nudged(false);
+    }
+
+    return round_correctly([this](big_float &result, size_t precision)
+    {
+        big_integer sine(0);
+        big_integer cosine(0);
+        size_t bits = precision;
+        fixed_sin_cos(sine, cosine, bits);
+        return result.assign_quotient_within(cosine, sine, fixed_error(), 0);
+    });
+}
+
+big_float big_float::sec() const
+{
+    big_float const unit(big_integer(1), _precision, _rounding);
+    if (is_zero())
+    {
+        return unit;
+    }
+    // sec x = 1 + x^2 / 2 + ...
+    if (is_tiny())
+    {
+        return unit.nudged(true);
+    }
+
+    return round_correctly([this](big_float &result, size_t precision)
+    {
+        big_integer sine(0);
+        big_integer cosine(0);
+        size_t bits = precision;
+        fixed_sin_cos(sine, cosine, bits);
+        return result.assign_quotient_within(big_integer::power_of_two(bits), cosine, fixed_error(), 0);
+    });
+}
+
+big_float big_float::cosec() const
+{
+    if (is_zero())
+    {
+        throw std::logic_error("attempt to divide by zero");
+    }
+    // cosec x = (1 + x^2 / 6 + ...) / x
+    if (is_tiny() && absolute(_mantissa) == big_integer(1))
+    {
+        return (big_float(big_integer(1), _precision, _rounding) / *this).nudged(true);
+    }
+
+    return round_correctly([this](big_float &result, size_t precision)
+    {
+        big_integer sine(0);
+        big_integer cosine(0);
+        size_t bits = precision;
+        fixed_sin_cos(sine, cosine, bits);
+        return result.assign_quotient_within(big_integer::power_of_two(bits), sine, fixed_error(), 0);
+    });
+}
+
+big_float big_float::arcsin() const
+{
+    if (is_zero())
+    {
+        return *this;
+    }
+
+    big_float const unit(big_integer(1), _precision);
+    int const magnitude_order = is_negative()
+        ? compare(-*this, unit)
+        : compare(*this, unit);
+    if (magnitude_order > 0)
+    {
+        throw std::invalid_argument("arcsin argument is out of [-1, 1]");
+    }
+
+    if (magnitude_order == 0)
+    {
+        return round_correctly([this](big_float &result, size_t precision)
+        {
+            big_integer const half_pi = constants::pi(precision - 1);
+            return result.assign_rounded_within(is_negative()
+                ? -half_pi
+                : half_pi, fixed_error(), -static_cast<int64_t>(precision));
+        });
+    }
+    // arcsin x = x (1 + x^2 / 6 + ...)
+    if (is_tiny())
+    {
+        return nudged(true);
+    }
+
+    // arcsin x = atan(x / sqrt(1 - x^2)), with 1 - x^2 taken exactly from the mantissa; atan takes the relative error
+    // of its argument down
+    return round_correctly([this](big_float &result, size_t precision)
+    {
+        size_t const bits = precision + static_cast<size_t>(-get_top());
+        big_integer const x = to_fixed(bits);
+        big_float rest(precision);
+        rest.assign_rounded(big_integer::power_of_two(2 * bits) - big_integer::square(x, nullptr), -2 * static_cast<int64_t>(bits), false);
+
+        big_float const approximation = (with_precision(precision, rounding_mode::to_nearest_even) / rest.root(2)).arctg();
+        return result.assign_rounded_within(approximation, precision);
+    });
+}
+
+big_float big_float::arccos() const
+{
+    big_float const unit(big_integer(1), _precision);
+    int const magnitude_order = is_negative()
+        ? compare(-*this, unit)
+        : compare(*this, unit);
+    if (magnitude_order > 0)
+    {
+        throw std::invalid_argument("arccos argument is out of [-1, 1]");
+    }
+
+    if (magnitude_order == 0)
+    {
+        return is_negative()
+            ? pi(_precision, _rounding)
+            : big_float(_precision, _rounding);
+    }
+
+    // arccos x = 2 atan(sqrt((1 - x) / (1 + x))) keeps the relative precision near both ends;
+    // the arguments far below 2^-precision only take part in the sums as far as they are represented
+    return round_correctly([this](big_float &result, size_t precision)
+    {
+        int64_t const top = is_zero()
+            ? 0
+            : get_top();
+        size_t const bits = precision + static_cast<size_t>(std::min<int64_t>(-std::min<int64_t>(top, 0), precision));
+        big_integer const x = to_fixed(bits);
+        big_float ratio(precision);
+        ratio.assign_quotient(big_integer::power_of_two(bits) - x, big_integer::power_of_two(bits) + x, 0);
+
+        big_float approximation = ratio.root(2).arctg();
+        ++approximation._exponent;
+        return result.assign_rounded_within(approximation, precision);
+    });
+}
+
+big_float big_float::arctg() const
+{
+    if (is_zero())
+    {
+        return *this;
+    }
+    // atan x = x (1 - x^2 / 3 + ...)
+    if (is_tiny())
+    {
+        return nudged(false);
+    }
+
+    return round_correctly([this](big_float &result, size_t precision)
+    {
+        // atan x is about x for the small arguments, so they take the bits below one too
+        size_t const bits = precision + static_cast<size_t>(std::max<int64_t>(-get_top(), 0));
+        big_integer const one_fixed = big_integer::power_of_two(bits);
+        big_integer const x = absolute(to_fixed(bits));
+
+        // atan x = pi / 2 - atan(1 / x) over one
+        big_integer arctangent = x <= one_fixed
+            ? fixed_arctangent_reduced(x, bits)
+            : constants::pi(bits - 1) - fixed_arctangent_reduced(fixed_divide(one_fixed, x, bits), bits);
+        if (is_negative())
+        {
+            arctangent = -arctangent;
+        }
+        return result.assign_rounded_within(arctangent, fixed_error(), -static_cast<int64_t>(bits));
+    });
+}
+
+big_float big_float::arcctg() const
+{
+    if (is_zero())
+    {
+        return round_correctly([](big_float &result, size_t precision)
+        {
+            return result.assign_rounded_within(constants::pi(precision - 1), fixed_error(), -static_cast<int64_t>(precision));
+        });
+    }
+
+    // acot x = atan(1 / x), and pi more for the negative arguments to stay in (0, pi)
+    return round_correctly([this](big_float &result, size_t precision)
+    {
+        big_float approximation = (big_float(big_integer(1), precision) / with_precision(precision, rounding_mode::to_nearest_even)).arctg();
+        if (is_negative())
+        {
+            approximation += pi(precision);
+        }
+        return result.assign_rounded_within(approximation, precision);
+    });
+}
+
+big_float big_float::arcsec() const
+{
+    big_float const unit(big_integer(1), _precision);
+    int const magnitude_order = is_zero()
+        ? -1
+        : (is_negative()
+            ? compare(-*this, unit)
+            : compare(*this, unit));
+    if (magnitude_order < 0)
+    {
+        throw std::invalid_argument("arcsec argument is inside (-1, 1)");
+    }
+
+    if (magnitude_order == 0)
+    {
+        return is_negative()
+            ? pi(_precision, _rounding)
+            : big_float(_precision, _rounding);
+    }
+
+    // arcsec x = atan(sqrt(x^2 - 1)), or pi less it for the negative arguments; atan takes the relative error
+    // of its argument down
+    return round_correctly([this](big_float &result, size_t precision)
+    {
+        big_float approximation = get_square_less_one(precision).root(2).arctg();
+        if (is_negative())
+        {
+            approximation = pi(precision) - approximation;
+        }
+        return result.assign_rounded_within(approximation, precision);
+    });
+}
+
+big_float big_float::arccosec() const
+{
+    big_float const unit(big_integer(1), _precision);
+    int const magnitude_order = is_zero()
+        ? -1
+        : (is_negative()
+            ? compare(-*this, unit)
+            : compare(*this, unit));
+    if (magnitude_order < 0)
+    {
+        throw std::invalid_argument("arccosec argument is inside (-1, 1)");
+    }
+
+    if (magnitude_order == 0)
+    {
+        return round_correctly([this](big_float &result, size_t precision)
+        {
+            big_integer const half_pi = constants::pi(precision - 1);
+            return result.assign_rounded_within(is_negative()
+                ? -half_pi
+                : half_pi, fixed_error(), -static_cast<int64_t>(precision));
+        });
+    }
+
+    // arccosec x = atan(1 / sqrt(x^2 - 1)) with the sign of x, as arcsec
+    return round_correctly([this](big_float &result, size_t precision)
+    {
+        big_float approximation = (big_float(big_integer(1), precision) / get_square_less_one(precision).root(2)).arctg();
+        if (is_negative())
+        {
+            approximation = -approximation;
+        }
+        return result.assign_rounded_within(approximation, precision);
+    });
+}
+
+big_float big_float::pow(
+    size_t degree) const
+{
+    if (degree == 0)
+    {
+        return big_float(big_integer(1), _precision, _rounding);
+    }
+
+    // every squaring and product rounds once, the guard bits take degree such roundings
+    big_float const base = with_precision(get_working_precision() + big_integer(static_cast<uint64_t>(degree)).bit_length(), rounding_mode::to_nearest_even);
+    big_float result = base;
+    size_t mask = 1;
+    while (mask <= degree / 2)
+    {
+        mask <<= 1;
+    }
+    for (mask >>= 1; mask != 0; mask >>= 1)
+    {
+        result *= result;
+        if ((degree & mask) != 0)
+        {
+            result *= base;
+        }
+    }
+
+    return result.with_precision(_precision, _rounding);
+}
+
+big_float big_float::root(
+    size_t degree) const
+{
+    if (degree == 0)
+    {
+        throw std::invalid_argument("root degree can't be zero");
+    }
+    if (is_negative() && degree % 2 == 0)
+    {
+        throw std::invalid_argument("even degree root of a negative value");
+    }
+    if (degree == 1 || is_zero())
+    {
+        return *this;
+    }
+
+    // the root of degree * (precision + 2) bits keeps two bits over the precision, and the exponent left is a multiple of degree
+    int64_t const signed_degree = static_cast<int64_t>(degree);
+    int64_t shift = std::max<int64_t>(signed_degree * static_cast<int64_t>(_precision + 2) - static_cast<int64_t>(_mantissa.bit_length()), 0);
+    shift += ((_exponent - shift) % signed_degree + signed_degree) % signed_degree;
+
+    big_integer const radicand = absolute(_mantissa) << static_cast<size_t>(shift);
+    big_integer root = radicand;
+    big_integer::iroot(root, degree);
+    bool const is_inexact = big_integer::pow(static_cast<big_integer const &>(root), degree) != radicand;
+
+    big_float result(_precision, _rounding);
+    result.assign_rounded(is_negative()
+        ? -root
+        : std::move(root), (_exponent - shift) / signed_degree, is_inexact);
+    return result;
+}
+
+big_float big_float::log2() const
+{
+    // the powers of two are exact
+    if (!is_negative() && _mantissa == big_integer(1))
+    {
+        big_float result(_precision, _rounding);
+        result.assign_rounded(_exponent < 0
+            ? -big_integer(static_cast<uint64_t>(-_exponent))
+            : big_integer(static_cast<uint64_t>(_exponent)), 0, false);
+        return result;
+    }
+
+    return round_correctly([this](big_float &result, size_t precision)
+    {
+        size_t bits = precision;
+        big_integer const logarithm = fixed_ln(bits);
+        return result.assign_quotient_within(logarithm, constants::ln2(bits), fixed_error(), 0);
+    });
+}
+
+big_float big_float::ln() const
+{
+    if (!is_negative() && _mantissa == big_integer(1) && _exponent == 0)
+    {
+        return big_float(_precision, _rounding);
+    }
+
+    return round_correctly([this](big_float &result, size_t precision)
+    {
+        size_t bits = precision;
+        big_integer const logarithm = fixed_ln(bits);
+        return result.assign_rounded_within(logarithm, fixed_error(), -static_cast<int64_t>(bits));
+    });
+}
+
+big_float big_float::lg() const
+{
+    // the powers of ten are exact: 10^k = 5^k * 2^k has an odd mantissa of over 2k bits
+    if (!is_negative() && _exponent >= 0 && static_cast<uint64_t>(_exponent) <= _mantissa.bit_length()
+        && _mantissa == big_integer::pow(big_integer(5), static_cast<size_t>(_exponent)))
+    {
+        return big_float(big_integer(static_cast<uint64_t>(_exponent)), _precision, _rounding);
+    }
+
+    return round_correctly([this](big_float &result, size_t precision)
+    {
+        size_t bits = precision;
+        big_integer const logarithm = fixed_ln(bits);
+        return result.assign_quotient_within(logarithm, constants::ln10(bits), fixed_error(), 0);
+    });
+}
+
+big_float big_float::pi(
+    size_t precision,
+    rounding_mode rounding)
+{
+    return big_float(precision, rounding).round_correctly([](big_float &result, size_t working_precision)
+    {
+        return result.assign_rounded_within(constants::pi(working_precision), fixed_error(), -static_cast<int64_t>(working_precision));
+    });
+}
+
+std::string big_float::to_string(
+    size_t significant_digits) const
+{
+    if (is_zero())
+    {
+        return "0";
+    }
+
+    size_t const digits_count = significant_digits != 0
+        ? significant_digits
+        : static_cast<size_t>(std::ceil(static_cast<double>(_precision) * 0.30102999566398120)) + 1;
+    big_integer const lower_bound = power_of_ten(digits_count - 1);
+    big_integer const upper_bound = lower_bound * big_integer(10);
+
+    // round(|x| * 10^(digits_count - 1 - decimal_exponent)) has digits_count digits for the right decimal exponent
+    int64_t decimal_exponent = static_cast<int64_t>(std::floor(static_cast<double>(get_top() - 1) * 0.30102999566398120));
+    big_integer scaled(0);
+    while (true)
+    {
+        int64_t const scale = static_cast<int64_t>(digits_count) - 1 - decimal_exponent;
+        big_integer numerator = absolute(_mantissa);
+        big_integer denominator(1);
+        if (scale >= 0)
+        {
+            numerator *= power_of_ten(static_cast<size_t>(scale));
+        }
+        else
+        {
+            denominator = power_of_ten(static_cast<size_t>(-scale));
+        }
+        if (_exponent >= 0)
+        {
+            numerator <<= static_cast<size_t>(_exponent);
+        }
+        else
+        {
+            denominator <<= static_cast<size_t>(-_exponent);
+        }
+
+        scaled = ((numerator << 1) + denominator) / (denominator << 1);
+        if (scaled >= upper_bound)
+        {
+            ++decimal_exponent;
+        }
+        else if (scaled < lower_bound)
+        {
+            --decimal_exponent;
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    std::string const digits = scaled.to_string();
+    size_t const significant_end = digits.find_last_not_of('0') + 1;
+
+    std::string result = is_negative()
+        ? "-"
+        : "";
+    result += digits[0];
+    if (significant_end > 1)
+    {
+        result += '.';
+        result.append(digits, 1, significant_end - 1);
+    }
+    if (decimal_exponent != 0)
+    {
+        result += 'e';
+        result += std::to_string(decimal_exponent);
+    }
+    return result;
+}
+
+std::ostream &operator<<(
+    std::ostream &stream,
+    big_float const &value)
+{
+    return stream << value.to_string();
+}
+
+std::istream &operator>>(
+    std::istream &stream,
+    big_float &value)
+{
+    std::string value_as_string;
+    if (stream >> value_as_string)
+    {
+        value = big_float(value_as_string, value._precision, value._rounding);
+    }
+    return stream;
+}
+
+void big_float::assign_rounded(
+    big_integer &&mantissa,
+    int64_t exponent,
+    bool is_inexact)
+{
+    bool const is_negative_value = is_negative_integer(mantissa);
+    big_integer magnitude = is_negative_value
+        ? -mantissa
+        : std::move(mantissa);
+    size_t bits = magnitude.bit_length();
+    if (bits == 0)
+    {
+        _mantissa = big_integer(0);
+        _exponent = 0;
+        return;
+    }
+
+    if (is_inexact && bits < _precision + 2)
+    {
+        magnitude <<= _precision + 2 - bits;
+        exponent -= static_cast<int64_t>(_precision + 2 - bits);
+        bits = _precision + 2;
+    }
+
+    if (bits > _precision)
+    {
+        size_t const shift = bits - _precision;
+        big_integer truncated = magnitude >> shift;
+        big_integer const rest = magnitude - (truncated << shift);
+        bool const is_rest_nonzero = is_inexact || rest != big_integer(0);
+
+        bool is_rounded_up = false;
+        switch (_rounding)
+        {
+            case rounding_mode::to_nearest_even:
+            {
+                big_integer const half = big_integer::power_of_two(shift - 1);
+                is_rounded_up = rest > half || (rest == half && (is_inexact || low_bits(truncated, 1) == 1));
+                break;
+            }
+            case rounding_mode::toward_zero:
+                break;
+            case rounding_mode::toward_positive_infinity:
+                is_rounded_up = !is_negative_value && is_rest_nonzero;
+                break;
+            case rounding_mode::toward_negative_infinity:
+                is_rounded_up = is_negative_value && is_rest_nonzero;
+                break;
+        }
+
+        if (is_rounded_up)
+        {
+            truncated += big_integer(1);
+        }
+        magnitude = std::move(truncated);
+        exponent += static_cast<int64_t>(shift);
+    }
+
+    size_t const zero_bits = magnitude.trailing_zero_bits_count();
+    magnitude >>= zero_bits;
+    exponent += static_cast<int64_t>(zero_bits);
+
+    _mantissa = is_negative_value
+        ? -magnitude
+        : std::move(magnitude);
+    _exponent = exponent;
+}
+
+void big_float::assign_quotient(
+    big_integer const &dividend,
+    big_integer const &divisor,
+    int64_t exponent)
+{
+    if (divisor == big_integer(0))
+    {
+        throw std::logic_error("attempt to divide by zero");
+    }
+
+    bool const is_negative_value = is_negative_integer(dividend) != is_negative_integer(divisor);
+    big_integer const divisor_magnitude = absolute(divisor);
+    big_integer dividend_magnitude = absolute(dividend);
+    if (dividend_magnitude == big_integer(0))
+    {
+        _mantissa = big_integer(0);
+        _exponent = 0;
+        return;
+    }
+
+    // the quotient takes two bits over the precision, the remainder tells whether it is exact
+    int64_t const shift = std::max<int64_t>(static_cast<int64_t>(_precision + 3 + divisor_magnitude.bit_length()) - static_cast<int64_t>(dividend_magnitude.bit_length()), 0);
+    dividend_magnitude <<= static_cast<size_t>(shift);
+
+    auto quotient_and_remainder = big_integer::divmod(dividend_magnitude, divisor_magnitude);
+    bool const is_inexact = quotient_and_remainder.second != big_integer(0);
+    assign_rounded(is_negative_value
+        ? -quotient_and_remainder.first
+        : std::move(quotient_and_remainder.first), exponent - shift, is_inexact);
+}
+
+big_float big_float::with_precision(
+    size_t precision,
+    rounding_mode rounding) const
+{
+    big_float result = *this;
+    result._rounding = rounding;
+    result.set_precision(precision);
+    return result;
+}
+
+bool big_float::is_zero() const noexcept
+{
+    return _mantissa.bit_length() == 0;
+}
+
+bool big_float::is_negative() const
+{
+    return is_negative_integer(_mantissa);
+}
+
+int64_t big_float::get_top() const noexcept
+{
+    return _exponent + static_cast<int64_t>(_mantissa.bit_length());
+}
+
+big_integer big_float::to_fixed(
+    size_t bits) const
+{
+    return shifted(_mantissa, _exponent + static_cast<int64_t>(bits));
+}
+
+bool big_float::assign_rounded_within(
+    big_integer const &value,
+    big_integer const &error,
+    int64_t exponent)
+{
+    // the rounding is monotonic, so everything between the ends rounds as they do
+    big_float lower(_precision, _rounding);
+    lower.assign_rounded(value - error, exponent, false);
+    big_float upper(_precision, _rounding);
+    upper.assign_rounded(value + error, exponent, false);
+    if (lower._mantissa != upper._mantissa || lower._exponent != upper._exponent)
+    {
+        return false;
+    }
+
+    _mantissa = std::move(upper._mantissa);
+    _exponent = upper._exponent;
+    return true;
+}
+
+bool big_float::assign_rounded_within(
+    big_float const &approximation,
+    size_t precision)
+{
+    if (approximation.is_zero())
+    {
+        return false;
+    }
+
+    int64_t const exponent = approximation.get_top() - static_cast<int64_t>(precision);
+    return assign_rounded_within(shifted(approximation._mantissa, approximation._exponent - exponent), fixed_error(), exponent);
+}
+
+bool big_float::assign_quotient_within(
+    big_integer const &dividend,
+    big_integer const &divisor,
+    big_integer const &error,
+    int64_t exponent)
+{
+    big_integer const dividend_magnitude = absolute(dividend);
+    big_integer const divisor_magnitude = absolute(divisor);
+    if (dividend_magnitude <= error || divisor_magnitude <= error)
+    {
+        return false;
+    }
+
+    // the magnitude lies within (|dividend| - error) / (|divisor| + error) and (|dividend| + error) / (|divisor| - error)
+    bool const is_negative_value = is_negative_integer(dividend) != is_negative_integer(divisor);
+    big_integer const low = dividend_magnitude - error;
+    big_integer const high = dividend_magnitude + error;
+    big_float lower(_precision, _rounding);
+    lower.assign_quotient(is_negative_value
+        ? -low
+        : low, divisor_magnitude + error, exponent);
+    big_float upper(_precision, _rounding);
+    upper.assign_quotient(is_negative_value
+        ? -high
+        : high, divisor_magnitude - error, exponent);
+    if (lower._mantissa != upper._mantissa || lower._exponent != upper._exponent)
+    {
+        return false;
+    }
+
+    _mantissa = std::move(upper._mantissa);
+    _exponent = upper._exponent;
+    return true;
+}
+
+big_float big_float::round_correctly(
+    std::function<bool(big_float &, size_t)> const &attempt) const
+{
+    big_float result(_precision, _rounding);
+    for (size_t precision = get_working_precision(); ; precision += precision / 2)
+    {
+        if (attempt(result, precision))
+        {
+            return result;
+        }
+    }
+}
+
+big_float big_float::nudged(
+    bool is_magnitude_up) const
+{
+    // the mantissa goes over the precision by more than the two bits rounding looks at, and the missing part is
+    // below a unit of its last bit
+    size_t const shift = _precision + 3;
+    big_integer magnitude = absolute(_mantissa) << shift;
+    if (!is_magnitude_up)
+    {
+        magnitude -= big_integer(1);
+    }
+
+    big_float result(_precision, _rounding);
+    result.assign_rounded(is_negative()
+        ? -magnitude
+        : std::move(magnitude), _exponent - static_cast<int64_t>(shift), true);
+    return result;
+}
+
+big_float big_float::get_square_less_one(
+    size_t precision) const
+{
+    big_integer const square = big_integer::square(_mantissa, nullptr);
+    int64_t const exponent = 2 * _exponent;
+    big_float result(precision);
+    if (exponent <= 0)
+    {
+        result.assign_rounded(square - big_integer::power_of_two(static_cast<size_t>(-exponent)), exponent, false);
+        return result;
+    }
+
+    // the large squares are taken as far as the rounding looks, with the one off them below a unit of the last bit
+    size_t const shift = static_cast<size_t>(std::min<int64_t>(exponent, static_cast<int64_t>(precision) + 3));
+    result.assign_rounded((square << shift) - big_integer(1), exponent - static_cast<int64_t>(shift), exponent > static_cast<int64_t>(shift));
+    return result;
+}
+
+bool big_float::is_tiny() const noexcept
+{
+    // x^3 is then below a unit of the last bit nudged keeps for x, of 2 precision + 3 bits at most
+    return !is_zero() && get_top() < -static_cast<int64_t>(_precision) - 1;
+}
+
+size_t big_float::get_working_precision() const noexcept
+{
+    return _precision + constants::guard_bits(_precision);
+}
+
+void big_float::fixed_sin_cos(
+    big_integer &sine,
+    big_integer &cosine,
+    size_t &bits) const
+{
+    size_t const precision = bits;
+    if (is_zero())
+    {
+        sine = big_integer(0);
+        cosine = big_integer::power_of_two(bits);
+        return;
+    }
+
+    // sin x is about x for the small arguments, so they take the bits below one too
+    bits = precision + static_cast<size_t>(std::max<int64_t>(-get_top(), 0));
+    while (true)
+    {
+        // pi / 2 takes the bits of the quotient too, so the reduced argument is good to 2^-bits
+        size_t const reduction_bits = bits + static_cast<size_t>(std::max<int64_t>(get_top(), 0)) + 2;
+        big_integer const x = absolute(to_fixed(reduction_bits));
+        big_integer const half_pi = constants::pi(reduction_bits - 1);
+        big_integer const quadrant = (x + (half_pi >> 1)) / half_pi;
+        big_integer const reduced = x - quadrant * half_pi;
+
+        // near the multiples of pi / 2 the reduction cancels the leading bits
+        size_t const required_bits = precision + (reduction_bits - bits);
+        size_t const reduced_bits = reduced.bit_length();
+        if (reduced_bits < required_bits)
+        {
+            bits += required_bits - reduced_bits;
+            continue;
+        }
+
+        big_integer reduced_sine(0);
+        big_integer reduced_cosine(0);
+        fixed_sin_cos_reduced(reduced, reduction_bits, reduced_sine, reduced_cosine);
+        reduced_sine >>= reduction_bits - bits;
+        reduced_cosine >>= reduction_bits - bits;
+
+        switch (low_bits(quadrant, 2))
+        {
+            case 0:
+                sine = std::move(reduced_sine);
+                cosine = std::move(reduced_cosine);
+                break;
+            case 1:
+                sine = std::move(reduced_cosine);
+                cosine = -reduced_sine;
+                break;
+            case 2:
+                sine = -reduced_sine;
+                cosine = -reduced_cosine;
+                break;
+            default:
+                sine = -reduced_cosine;
+                cosine = std::move(reduced_sine);
+                break;
+        }
+
+        if (is_negative())
+        {
+            sine = -sine;
+        }
+        return;
+    }
+}
+
+big_integer big_float::fixed_ln(
+    size_t &bits) const
+{
+    if (is_zero() || is_negative())
+    {
+        throw std::invalid_argument("logarithm of a non-positive value");
+    }
+
+    size_t const precision = bits;
+    while (true)
+    {
+        // x = y * 2^power with y between 1 / sqrt 2 and sqrt 2
+        int64_t power = get_top();
+        big_integer y = shifted(_mantissa, _exponent - power + static_cast<int64_t>(bits));
+        if ((y * y) << 1 < big_integer::power_of_two(2 * bits))
+        {
+            y <<= 1;
+            --power;
+        }
+
+        if (power == 0)
+        {
+            // ln y is about y - 1, which keeps fewer significant bits the closer y is to one
+            size_t const significant_bits = absolute(y - big_integer::power_of_two(bits)).bit_length();
+            if (significant_bits != 0 && significant_bits < precision)
+            {
+                bits += precision - significant_bits;
+                continue;
+            }
+            return fixed_ln_reduced(y, bits);
+        }
+
+        // power * ln 2 takes the bits of power too
+        uint64_t const power_magnitude = power < 0
+            ? static_cast<uint64_t>(-power)
+            : static_cast<uint64_t>(power);
+        size_t const power_bits = big_integer(power_magnitude).bit_length();
+        big_integer result = constants::ln2(bits + power_bits) * big_integer(power_magnitude);
+        result >>= power_bits;
+        if (power < 0)
+        {
+            result = -result;
+        }
+        result += fixed_ln_reduced(y, bits);
+        return result;
+    }
+}
+
+int big_float::compare(
+    big_float const &first,
+    big_float const &second)
+{
+    int const first_sign = first.is_zero()
+        ? 0
+        : (first.is_negative()
+            ? -1
+            : 1);
+    int const second_sign = second.is_zero()
+        ? 0
+        : (second.is_negative()
+            ? -1
+            : 1);
+    if (first_sign != second_sign)
+    {
+        return first_sign < second_sign
+            ? -1
+            : 1;
+    }
+    if (first_sign == 0)
+    {
+        return 0;
+    }
+
+    int64_t const first_top = first.get_top();
+    int64_t const second_top = second.get_top();
+    if (first_top != second_top)
+    {
+        return (first_top < second_top) == (first_sign > 0)
+            ? -1
+            : 1;
+    }
+
+    // equal tops keep the alignment shift within the precisions
+    int64_t const exponent = std::min(first._exponent, second._exponent);
+    big_integer const first_aligned = first._mantissa << static_cast<size_t>(first._exponent - exponent);
+    big_integer const second_aligned = second._mantissa << static_cast<size_t>(second._exponent - exponent);
+    return first_aligned < second_aligned
+        ? -1
+        : (first_aligned > second_aligned
+            ? 1
+            : 0);
+}
\ No newline at end of file
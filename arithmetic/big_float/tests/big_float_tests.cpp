@@ -0,0 +1,308 @@
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+#include <big_float.h>
+#include <client_logger.h>
+
+logger *create_logger(
+    std::vector<std::pair<std::string, logger::severity>> const &output_file_streams_setup,
+    bool use_console_stream = true,
+    logger::severity console_stream_severity = logger::severity::debug)
+{
+    logger_builder *builder = new client_logger_builder();
+    
+    if (use_console_stream)
+    {
+        builder->add_console_stream(console_stream_severity);
+    }
+    
+    for (auto &output_file_stream_setup: output_file_streams_setup)
+    {
+        builder->add_file_stream(output_file_stream_setup.first, output_file_stream_setup.second);
+    }
+    
+    logger *built_logger = builder->build();
+    
+    delete builder;
+    
+    return built_logger;
+}
+
+TEST(positive_tests, test1)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "bigfloat_logs.txt",
+                logger::severity::information
+            },
+        });
+    
+    big_float const first("1.5", 64);
+    big_float const second("-0.25", 64);
+    
+    EXPECT_EQ((first + second).to_string(), "1.25");
+    EXPECT_EQ((first - second).to_string(), "1.75");
+    EXPECT_EQ((first * second).to_string(), "-3.75e-1");
+    EXPECT_EQ((first / second).to_string(), "-6");
+    EXPECT_EQ(big_float("-12.5e-3", 64).to_string(15), "-1.25e-2");
+    EXPECT_EQ(big_float(big_integer("1"), big_integer("3"), 64).to_string(10), "3.333333333e-1");
+    
+    EXPECT_TRUE(second < first);
+    EXPECT_TRUE(first == big_float("150e-2", 64));
+    EXPECT_TRUE(big_float("0.1", 53) + big_float("0.2", 53) != big_float("0.3", 53));
+    
+    delete logger;
+}
+
+TEST(positive_tests, test2)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "bigfloat_logs.txt",
+                logger::severity::information
+            },
+        });
+    
+    // 1 / 3 = 0.0101...b rounds up to the nearest value and towards plus infinity
+    big_integer const one("1");
+    big_integer const three("3");
+    big_float const nearest(one, three, 8, big_float::rounding_mode::to_nearest_even);
+    big_float const toward_zero(one, three, 8, big_float::rounding_mode::toward_zero);
+    big_float const up(one, three, 8, big_float::rounding_mode::toward_positive_infinity);
+    big_float const down(-one, three, 8, big_float::rounding_mode::toward_negative_infinity);
+    
+    EXPECT_TRUE(toward_zero < nearest);
+    EXPECT_TRUE(nearest == up);
+    EXPECT_EQ(up.get_mantissa(), big_integer("171"));
+    EXPECT_EQ(up.get_exponent(), -9);
+    EXPECT_TRUE(down == -up);
+    
+    // ties go to the even mantissa
+    EXPECT_TRUE(big_float(big_integer("9"), 3) == big_float(big_integer("8"), 3));
+    EXPECT_TRUE(big_float(big_integer("11"), 3) == big_float(big_integer("12"), 3));
+    
+    // a term far below the precision still rounds the sum the right way
+    big_float const huge(one << 1000, 16, big_float::rounding_mode::toward_positive_infinity);
+    big_float const tiny(one, one << 1000, 16);
+    EXPECT_TRUE(huge + tiny > huge);
+    EXPECT_TRUE(huge - tiny == huge);
+    
+    delete logger;
+}
+
+TEST(positive_tests, test3)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "bigfloat_logs.txt",
+                logger::severity::information
+            },
+        });
+    
+    EXPECT_EQ(big_float::pi(200).to_string(50), "3.1415926535897932384626433832795028841971693993751");
+    
+    big_float const half("0.5", 200);
+    EXPECT_EQ(half.sin().to_string(40), "4.794255386042030002732879352155713880818e-1");
+    EXPECT_EQ(half.cos().to_string(40), "8.775825618903727161162815826038296519916e-1");
+    EXPECT_EQ(half.tg().to_string(40), "5.463024898437905132551794657802853832976e-1");
+    EXPECT_EQ(half.arcsin().to_string(40), "5.235987755982988730771072305465838140329e-1");
+    EXPECT_EQ(half.arccos().to_string(40), "1.047197551196597746154214461093167628066");
+    EXPECT_EQ(half.arctg().to_string(40), "4.636476090008061162142562314612144020285e-1");
+    EXPECT_EQ(half.ln().to_string(40), "-6.931471805599453094172321214581765680755e-1");
+    EXPECT_EQ(half.log2().to_string(), "-1");
+    
+    // the argument reduction keeps the digits of large arguments
+    EXPECT_EQ(big_float("-1.2345678e13", 100).sin().to_string(25), "7.533219691822680899444476e-1");
+    EXPECT_EQ(big_float("1e-30", 64).sin().to_string(15), "1e-30");
+    
+    delete logger;
+}
+
+TEST(positive_tests, test4)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "bigfloat_logs.txt",
+                logger::severity::information
+            },
+        });
+    
+    big_float const one(big_integer("1"), 300);
+    big_float const x("1.234567890123456789", 300);
+    
+    big_float const sine = x.sin();
+    big_float const cosine = x.cos();
+    big_float const identity = sine * sine + cosine * cosine - one;
+    EXPECT_TRUE(identity.get_exponent() + static_cast<int64_t>(identity.get_mantissa().bit_length()) < -290);
+    
+    EXPECT_EQ(x.arcctg().to_string(30), (one / x).arctg().to_string(30));
+    EXPECT_EQ((-x).arcctg().to_string(30), ((one / -x).arctg() + big_float::pi(300)).to_string(30));
+    EXPECT_EQ(x.sec().to_string(30), (one / cosine).to_string(30));
+    EXPECT_EQ(x.cosec().to_string(30), (one / sine).to_string(30));
+    EXPECT_EQ(x.ctg().to_string(30), (cosine / sine).to_string(30));
+    EXPECT_EQ(x.arcsec().to_string(30), (one / x).arccos().to_string(30));
+    EXPECT_EQ(x.arccosec().to_string(30), (one / x).arcsin().to_string(30));
+    EXPECT_EQ(x.lg().to_string(30), (x.ln() / big_float(big_integer("10"), 300).ln()).to_string(30));
+    
+    delete logger;
+}
+
+TEST(positive_tests, test5)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "bigfloat_logs.txt",
+                logger::severity::information
+            },
+        });
+    
+    big_float const two(big_integer("2"), 128);
+    EXPECT_EQ(two.root(2).to_string(30), "1.41421356237309504880168872421");
+    EXPECT_TRUE(big_float(big_integer("-27"), 128).root(3) == big_float(big_integer("-3"), 128));
+    EXPECT_TRUE(two.pow(100) == big_float(big_integer("1") << 100, 128));
+    EXPECT_TRUE(big_float(128).pow(0) == big_float(big_integer("1"), 128));
+    EXPECT_EQ(big_float("1.1", 64).pow(10).to_string(15), "2.5937424601");
+    
+    // precision bounds the size of a value through a long computation
+    big_float sum(64);
+    big_float term(big_integer("1"), 64);
+    big_float const third(big_integer("1"), big_integer("3"), 64);
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        sum += term;
+        term *= third;
+    }
+    EXPECT_LE(sum.get_mantissa().bit_length(), 64U);
+    EXPECT_EQ(sum.to_string(15), "1.5");
+    
+    std::stringstream stream("-2.5e3");
+    big_float read(32);
+    stream >> read;
+    EXPECT_EQ(read.get_precision(), 32U);
+    std::stringstream written;
+    written << read;
+    EXPECT_EQ(written.str(), "-2.5e3");
+    
+    delete logger;
+}
+
+TEST(positive_tests, test6)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "bigfloat_logs.txt",
+                logger::severity::information
+            },
+        });
+    
+    using rounding = big_float::rounding_mode;
+    big_integer const one("1");
+    
+    // results within an ulp of an exact value still round to the requested side of the true one
+    EXPECT_TRUE(big_float(-one, one << 179, 2, rounding::toward_negative_infinity).cos()
+        == big_float(big_integer("3"), big_integer("4"), 2));
+    big_float const tiny(one, one << 179, 8, rounding::toward_zero);
+    EXPECT_TRUE(tiny.sin() == big_float(big_integer("255"), one << 187, 8));
+    EXPECT_TRUE(tiny.tg() == tiny);
+    EXPECT_TRUE(tiny.arctg() == big_float(big_integer("255"), one << 187, 8));
+    EXPECT_TRUE(big_float(one, one << 179, 8, rounding::toward_positive_infinity).tg()
+        == big_float(big_integer("129"), one << 186, 8));
+    
+    // exact results stay exact in every mode
+    EXPECT_TRUE(big_float(big_integer("10"), 64, rounding::toward_zero).lg() == big_float(one, 64));
+    EXPECT_TRUE(big_float(big_integer("10"), 64, rounding::toward_negative_infinity).lg() == big_float(one, 64));
+    EXPECT_TRUE(big_float(big_integer("100"), 64, rounding::toward_positive_infinity).lg()
+        == big_float(big_integer("2"), 64));
+    EXPECT_TRUE(big_float(big_integer("8"), 64, rounding::toward_negative_infinity).log2()
+        == big_float(big_integer("3"), 64));
+    
+    // directed results of an irrational value are adjacent and enclose the nearest one
+    std::vector<std::pair<std::string, big_float (big_float::*)() const>> const cases
+        {
+            { "0.75", &big_float::sin },
+            { "0.75", &big_float::cos },
+            { "0.75", &big_float::tg },
+            { "0.75", &big_float::arcsin },
+            { "0.75", &big_float::arccos },
+            { "0.75", &big_float::arctg },
+            { "1.5", &big_float::ctg },
+            { "1.5", &big_float::arcsec },
+            { "1.5", &big_float::ln },
+            { "1.5", &big_float::lg }
+        };
+    for (auto const &test_case: cases)
+    {
+        big_float const down = (big_float(test_case.first, 53, rounding::toward_negative_infinity).*test_case.second)();
+        big_float const up = (big_float(test_case.first, 53, rounding::toward_positive_infinity).*test_case.second)();
+        big_float const nearest = (big_float(test_case.first, 53, rounding::to_nearest_even).*test_case.second)();
+        big_float const toward_zero = (big_float(test_case.first, 53, rounding::toward_zero).*test_case.second)();
+        int64_t const top = static_cast<int64_t>(up.get_mantissa().bit_length()) + up.get_exponent();
+        
+        EXPECT_TRUE(up - down == big_float(one, one << (53 - top), 53));
+        EXPECT_TRUE(nearest == down || nearest == up);
+        EXPECT_TRUE(toward_zero == down);
+    }
+    
+    delete logger;
+}
+
+TEST(negative_tests, test1)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "bigfloat_logs.txt",
+                logger::severity::information
+            },
+        });
+    
+    big_float const zero(64);
+    big_float const two(big_integer("2"), 64);
+    
+    EXPECT_THROW(two / zero, std::logic_error);
+    EXPECT_THROW(zero.ctg(), std::logic_error);
+    EXPECT_THROW(zero.ln(), std::invalid_argument);
+    EXPECT_THROW((-two).log2(), std::invalid_argument);
+    EXPECT_THROW(two.arcsin(), std::invalid_argument);
+    EXPECT_THROW(two.arccos(), std::invalid_argument);
+    EXPECT_THROW(big_float("0.5", 64).arcsec(), std::invalid_argument);
+    EXPECT_THROW((-two).root(2), std::invalid_argument);
+    EXPECT_THROW(two.root(0), std::invalid_argument);
+    
+    delete logger;
+}
+
+TEST(negative_tests, test2)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "bigfloat_logs.txt",
+                logger::severity::information
+            },
+        });
+    
+    EXPECT_THROW(big_float("", 64), std::invalid_argument);
+    EXPECT_THROW(big_float("1.5e", 64), std::invalid_argument);
+    EXPECT_THROW(big_float("1,5", 64), std::invalid_argument);
+    EXPECT_THROW(big_float("-.", 64), std::invalid_argument);
+    EXPECT_THROW(big_float(64, big_float::rounding_mode::to_nearest_even).set_precision(0), std::invalid_argument);
+    
+    delete logger;
+}
+
+int main(
+    int argc,
+    char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    
+    return RUN_ALL_TESTS();
+}
\ No newline at end of file
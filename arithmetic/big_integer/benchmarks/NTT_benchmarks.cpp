@@ -0,0 +1,102 @@
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include <big_integer.h>
+
+namespace
+{
+
+    double milliseconds_per_operation(
+        std::function<void()> const &operation)
+    {
+        size_t iterations = 1;
+        while (true)
+        {
+            auto const started_at = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < iterations; ++i)
+            {
+                operation();
+            }
+            auto const elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started_at).count();
+
+            if (elapsed > 200)
+            {
+                return elapsed / static_cast<double>(iterations);
+            }
+            iterations *= 2;
+        }
+    }
+
+    big_integer random_big_integer(
+        std::mt19937 &generator,
+        size_t digits_count)
+    {
+        static char const hex_digits[] = "0123456789abcdef";
+
+        std::string value(digits_count * 16, '0');
+        for (auto &value_digit: value)
+        {
+            value_digit = hex_digits[generator() % 16];
+        }
+        value.front() = hex_digits[1 + generator() % 15];
+        return big_integer(value, 16);
+    }
+
+    void print_result(
+        std::string const &operation_name,
+        size_t digits_count,
+        double Schonhage_Strassen_time,
+        double NTT_time)
+    {
+        std::cout
+            << std::left << std::setw(16) << operation_name
+            << std::right << std::setw(10) << digits_count
+            << std::fixed << std::setprecision(2)
+            << std::setw(24) << Schonhage_Strassen_time
+            << std::setw(16) << NTT_time
+            << std::setw(9) << Schonhage_Strassen_time / NTT_time << 'x'
+            << std::endl;
+    }
+
+}
+
+int main(
+    int argc,
+    char *argv[])
+{
+    size_t const max_digits = argc > 1
+        ? std::stoul(argv[1])
+        : 262144;
+
+    std::mt19937 generator(20240601);
+    volatile size_t sink = 0;
+
+    std::cout
+        << std::left << std::setw(16) << "operation"
+        << std::right << std::setw(10) << "digits"
+        << std::setw(24) << "Schonhage-Strassen, ms"
+        << std::setw(16) << "NTT, ms"
+        << std::setw(10) << "speedup"
+        << std::endl;
+
+    for (size_t digits_count = 1024; digits_count <= max_digits; digits_count *= 4)
+    {
+        big_integer const first = random_big_integer(generator, digits_count);
+        big_integer const second = random_big_integer(generator, digits_count);
+
+        print_result("multiplication", digits_count,
+            milliseconds_per_operation([&]() { sink = sink + (big_integer::multiply(first, second, nullptr, big_integer::multiplication_rule::SchonhageStrassen) == first); }),
+            milliseconds_per_operation([&]() { sink = sink + (big_integer::multiply(first, second, nullptr, big_integer::multiplication_rule::NTT) == first); }));
+
+        print_result("squaring", digits_count,
+            milliseconds_per_operation([&]() { sink = sink + (big_integer::square(first, nullptr, big_integer::multiplication_rule::SchonhageStrassen) == first); }),
+            milliseconds_per_operation([&]() { sink = sink + (big_integer::square(first, nullptr, big_integer::multiplication_rule::NTT) == first); }));
+    }
+
+    return 0;
+}
\ No newline at end of file
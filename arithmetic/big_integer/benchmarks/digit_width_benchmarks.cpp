@@ -0,0 +1,300 @@
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <big_integer.h>
+
+namespace
+{
+
+    // the former 32-bit digit layout, kept as the reference for the 64-bit digits
+    namespace reference
+    {
+
+        using digits = std::vector<uint32_t>;
+
+        void normalize(
+            digits &value)
+        {
+            while (!value.empty() && value.back() == 0)
+            {
+                value.pop_back();
+            }
+        }
+
+        digits add(
+            digits const &first,
+            digits const &second)
+        {
+            digits const &longer = first.size() >= second.size()
+                ? first
+                : second;
+            digits const &shorter = first.size() >= second.size()
+                ? second
+                : first;
+
+            digits result(longer.size() + 1);
+            uint64_t carry = 0;
+            for (size_t i = 0; i < longer.size(); ++i)
+            {
+                carry += static_cast<uint64_t>(longer[i]) + (i < shorter.size()
+                    ? shorter[i]
+                    : 0);
+                result[i] = static_cast<uint32_t>(carry);
+                carry >>= 32;
+            }
+            result[longer.size()] = static_cast<uint32_t>(carry);
+            normalize(result);
+            return result;
+        }
+
+        // first >= second
+        digits subtract(
+            digits const &first,
+            digits const &second)
+        {
+            digits result(first.size());
+            int64_t borrow = 0;
+            for (size_t i = 0; i < first.size(); ++i)
+            {
+                int64_t difference = static_cast<int64_t>(first[i]) - borrow - (i < second.size()
+                    ? second[i]
+                    : 0);
+                borrow = difference < 0
+                    ? 1
+                    : 0;
+                result[i] = static_cast<uint32_t>(difference + (borrow << 32));
+            }
+            normalize(result);
+            return result;
+        }
+
+        digits multiply(
+            digits const &first,
+            digits const &second)
+        {
+            digits result(first.size() + second.size());
+            for (size_t i = 0; i < first.size(); ++i)
+            {
+                uint64_t carry = 0;
+                for (size_t j = 0; j < second.size(); ++j)
+                {
+                    carry += static_cast<uint64_t>(first[i]) * second[j] + result[i + j];
+                    result[i + j] = static_cast<uint32_t>(carry);
+                    carry >>= 32;
+                }
+                result[i + second.size()] = static_cast<uint32_t>(carry);
+            }
+            normalize(result);
+            return result;
+        }
+
+        // Knuth's algorithm D, the divisor has at least two digits
+        digits divide(
+            digits const &dividend,
+            digits const &divisor)
+        {
+            size_t const dividend_size = dividend.size();
+            size_t const divisor_size = divisor.size();
+            if (dividend_size < divisor_size)
+            {
+                return digits();
+            }
+
+            int shift = 0;
+            while ((divisor.back() << shift & 0x80000000U) == 0)
+            {
+                ++shift;
+            }
+
+            digits normalized_divisor(divisor_size);
+            digits remainder(dividend_size + 1);
+            for (size_t i = divisor_size; i-- > 1;)
+            {
+                normalized_divisor[i] = shift == 0
+                    ? divisor[i]
+                    : (divisor[i] << shift) | (divisor[i - 1] >> (32 - shift));
+            }
+            normalized_divisor[0] = divisor[0] << shift;
+            remainder[dividend_size] = shift == 0
+                ? 0
+                : dividend[dividend_size - 1] >> (32 - shift);
+            for (size_t i = dividend_size; i-- > 1;)
+            {
+                remainder[i] = shift == 0
+                    ? dividend[i]
+                    : (dividend[i] << shift) | (dividend[i - 1] >> (32 - shift));
+            }
+            remainder[0] = dividend[0] << shift;
+
+            digits quotient(dividend_size - divisor_size + 1);
+            for (size_t j = dividend_size - divisor_size + 1; j-- > 0;)
+            {
+                uint64_t const top = (static_cast<uint64_t>(remainder[j + divisor_size]) << 32) | remainder[j + divisor_size - 1];
+                uint64_t quotient_digit = top / normalized_divisor[divisor_size - 1];
+                uint64_t quotient_remainder = top % normalized_divisor[divisor_size - 1];
+                while (quotient_digit > 0xFFFFFFFFULL
+                    || quotient_digit * normalized_divisor[divisor_size - 2] > ((quotient_remainder << 32) | remainder[j + divisor_size - 2]))
+                {
+                    --quotient_digit;
+                    quotient_remainder += normalized_divisor[divisor_size - 1];
+                    if (quotient_remainder > 0xFFFFFFFFULL)
+                    {
+                        break;
+                    }
+                }
+
+                int64_t borrow = 0;
+                uint64_t carry = 0;
+                for (size_t i = 0; i < divisor_size; ++i)
+                {
+                    uint64_t const product = quotient_digit * normalized_divisor[i] + carry;
+                    carry = product >> 32;
+                    int64_t const difference = static_cast<int64_t>(remainder[i + j]) - borrow - static_cast<int64_t>(product & 0xFFFFFFFFULL);
+                    remainder[i + j] = static_cast<uint32_t>(difference);
+                    borrow = difference < 0
+                        ? 1
+                        : 0;
+                }
+                int64_t const difference = static_cast<int64_t>(remainder[j + divisor_size]) - borrow - static_cast<int64_t>(carry);
+                remainder[j + divisor_size] = static_cast<uint32_t>(difference);
+
+                if (difference < 0)
+                {
+                    --quotient_digit;
+                    uint64_t add_carry = 0;
+                    for (size_t i = 0; i < divisor_size; ++i)
+                    {
+                        add_carry += static_cast<uint64_t>(remainder[i + j]) + normalized_divisor[i];
+                        remainder[i + j] = static_cast<uint32_t>(add_carry);
+                        add_carry >>= 32;
+                    }
+                    remainder[j + divisor_size] += static_cast<uint32_t>(add_carry);
+                }
+
+                quotient[j] = static_cast<uint32_t>(quotient_digit);
+            }
+
+            normalize(quotient);
+            return quotient;
+        }
+
+    }
+
+    double nanoseconds_per_operation(
+        std::function<void()> const &operation)
+    {
+        size_t iterations = 1;
+        while (true)
+        {
+            auto const started_at = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < iterations; ++i)
+            {
+                operation();
+            }
+            auto const elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - started_at).count();
+
+            if (elapsed > 2e8)
+            {
+                return elapsed / static_cast<double>(iterations);
+            }
+            iterations *= 2;
+        }
+    }
+
+    void print_header()
+    {
+        std::cout
+            << std::left << std::setw(16) << "operation"
+            << std::right << std::setw(10) << "bits"
+            << std::setw(18) << "32-bit, ns/op"
+            << std::setw(18) << "64-bit, ns/op"
+            << std::setw(10) << "speedup"
+            << std::endl;
+    }
+
+    void print_result(
+        std::string const &operation_name,
+        size_t bits,
+        double reference_time,
+        double time)
+    {
+        std::cout
+            << std::left << std::setw(16) << operation_name
+            << std::right << std::setw(10) << bits
+            << std::fixed << std::setprecision(0)
+            << std::setw(18) << reference_time
+            << std::setw(18) << time
+            << std::setprecision(2)
+            << std::setw(9) << reference_time / time << 'x'
+            << std::endl;
+    }
+
+    reference::digits random_digits(
+        std::mt19937 &generator,
+        size_t digits_count)
+    {
+        reference::digits result(digits_count);
+        for (auto &result_digit: result)
+        {
+            result_digit = generator();
+        }
+        // keeps the value positive for big_integer's two's complement int constructor
+        result.back() = (result.back() & 0x7FFFFFFFU) | 0x40000000U;
+        return result;
+    }
+
+    big_integer to_big_integer(
+        reference::digits const &value)
+    {
+        return big_integer(reinterpret_cast<int const *>(value.data()), value.size());
+    }
+
+}
+
+int main(
+    int argc,
+    char *argv[])
+{
+    size_t const max_bits = argc > 1
+        ? std::stoul(argv[1])
+        : 16384;
+
+    std::mt19937 generator(20240601);
+    volatile size_t sink = 0;
+
+    print_header();
+
+    for (size_t bits = 256; bits <= max_bits; bits *= 4)
+    {
+        auto const first_digits = random_digits(generator, bits / 32);
+        auto const second_digits = random_digits(generator, bits / 32);
+        auto const dividend_digits = random_digits(generator, bits / 16);
+
+        big_integer const first = to_big_integer(first_digits);
+        big_integer const second = to_big_integer(second_digits);
+        big_integer const dividend = to_big_integer(dividend_digits);
+
+        print_result("addition", bits,
+            nanoseconds_per_operation([&]() { sink = sink + reference::add(first_digits, second_digits).size(); }),
+            nanoseconds_per_operation([&]() { sink = sink + (first + second == second); }));
+
+        print_result("subtraction", bits,
+            nanoseconds_per_operation([&]() { sink = sink + reference::subtract(dividend_digits, first_digits).size(); }),
+            nanoseconds_per_operation([&]() { sink = sink + (dividend - first == second); }));
+
+        print_result("multiplication", bits,
+            nanoseconds_per_operation([&]() { sink = sink + reference::multiply(first_digits, second_digits).size(); }),
+            nanoseconds_per_operation([&]() { sink = sink + (big_integer::multiply(first, second) == second); }));
+
+        print_result("division", bits,
+            nanoseconds_per_operation([&]() { sink = sink + reference::divide(dividend_digits, second_digits).size(); }),
+            nanoseconds_per_operation([&]() { sink = sink + (big_integer::divide(dividend, second) == second); }));
+    }
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,128 @@
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <big_integer.h>
+
+namespace
+{
+
+    double nanoseconds_per_operation(
+        std::function<void()> const &operation)
+    {
+        size_t iterations = 1;
+        while (true)
+        {
+            auto const started_at = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < iterations; ++i)
+            {
+                operation();
+            }
+            auto const elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - started_at).count();
+
+            if (elapsed > 2e8)
+            {
+                return elapsed / static_cast<double>(iterations);
+            }
+            iterations *= 2;
+        }
+    }
+
+    big_integer random_big_integer(
+        std::mt19937 &generator,
+        size_t digits_count)
+    {
+        static char const hex_digits[] = "0123456789abcdef";
+
+        std::string value(digits_count * 16, '0');
+        for (auto &value_digit: value)
+        {
+            value_digit = hex_digits[generator() % 16];
+        }
+        value.front() = hex_digits[1 + generator() % 15];
+        return big_integer(value, 16);
+    }
+
+}
+
+int main(
+    int argc,
+    char *argv[])
+{
+    size_t const max_digits = argc > 1
+        ? std::stoul(argv[1])
+        : 16384;
+
+    // Euclid's algorithm is quadratic with a large constant, so it stops being measured early
+    size_t const max_Euclid_digits = 4096;
+
+    std::vector<std::pair<std::string, big_integer::gcd_rule>> const gcd_rules =
+    {
+        { "Euclid", big_integer::gcd_rule::Euclid },
+        { "Lehmer", big_integer::gcd_rule::Lehmer },
+        { "half-GCD", big_integer::gcd_rule::HalfGCD }
+    };
+
+    std::mt19937 generator(20240601);
+
+    std::cout
+        << std::left << std::setw(14) << "operation"
+        << std::right << std::setw(10) << "digits"
+        << std::setw(12) << "rule"
+        << std::setw(16) << "ns/op"
+        << std::setw(14) << "vs Euclid"
+        << std::endl;
+
+    for (size_t digits_count = 16; digits_count <= max_digits; digits_count *= 4)
+    {
+        big_integer const first = random_big_integer(generator, digits_count);
+        big_integer const second = random_big_integer(generator, digits_count);
+        big_integer first_coefficient("0");
+        big_integer second_coefficient("0");
+
+        std::vector<std::pair<std::string, std::function<void(big_integer::gcd_rule)>>> const operations =
+        {
+            { "gcd", [&](big_integer::gcd_rule gcd_rule) { big_integer::gcd(first, second, nullptr, gcd_rule); } },
+            { "extended gcd", [&](big_integer::gcd_rule gcd_rule) { big_integer::extended_gcd(first, second, first_coefficient, second_coefficient, nullptr, gcd_rule); } }
+        };
+
+        for (auto const &operation: operations)
+        {
+            double Euclid_time = 0;
+            for (auto const &gcd_rule: gcd_rules)
+            {
+                if (gcd_rule.second == big_integer::gcd_rule::Euclid && digits_count > max_Euclid_digits)
+                {
+                    continue;
+                }
+
+                double const time = nanoseconds_per_operation([&]() { operation.second(gcd_rule.second); });
+                if (gcd_rule.second == big_integer::gcd_rule::Euclid)
+                {
+                    Euclid_time = time;
+                }
+
+                std::cout
+                    << std::left << std::setw(14) << operation.first
+                    << std::right << std::setw(10) << digits_count
+                    << std::setw(12) << gcd_rule.first
+                    << std::fixed << std::setprecision(0)
+                    << std::setw(16) << time;
+                if (Euclid_time != 0)
+                {
+                    std::cout
+                        << std::setprecision(2)
+                        << std::setw(13) << Euclid_time / time << 'x';
+                }
+                std::cout << std::endl;
+            }
+        }
+    }
+
+    return 0;
+}
\ No newline at end of file
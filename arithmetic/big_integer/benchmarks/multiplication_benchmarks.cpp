@@ -0,0 +1,129 @@
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <big_integer.h>
+
+namespace
+{
+
+    // the schoolbook method is only measured up to this size
+    size_t const max_trivial_digits_count = 2048;
+
+    double nanoseconds_per_operation(
+        std::function<void()> const &operation)
+    {
+        size_t iterations = 1;
+        while (true)
+        {
+            auto const started_at = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < iterations; ++i)
+            {
+                operation();
+            }
+            auto const elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - started_at).count();
+
+            if (elapsed > 1e8)
+            {
+                return elapsed / static_cast<double>(iterations);
+            }
+            iterations *= 2;
+        }
+    }
+
+    big_integer random_big_integer(
+        std::mt19937 &generator,
+        size_t digits_count)
+    {
+        static char const hex_digits[] = "0123456789abcdef";
+
+        std::string value(digits_count * 16, '0');
+        for (auto &value_digit: value)
+        {
+            value_digit = hex_digits[generator() % 16];
+        }
+        value.front() = hex_digits[1 + generator() % 15];
+        return big_integer(value, 16);
+    }
+
+    using rules_list = std::vector<std::pair<std::string, big_integer::multiplication_rule>>;
+
+    // operation multiplies the operands of a size with a rule
+    void print_table(
+        std::string const &title,
+        rules_list const &rules,
+        size_t max_digits,
+        std::function<bool(big_integer const &, big_integer const &, big_integer::multiplication_rule)> const &operation)
+    {
+        std::mt19937 generator(20240601);
+        volatile size_t sink = 0;
+
+        std::cout << title << ", us/op" << std::endl << std::setw(10) << "digits";
+        for (auto const &rule: rules)
+        {
+            std::cout << std::setw(20) << rule.first;
+        }
+        std::cout << std::endl;
+
+        for (size_t digits_count = 64; digits_count <= max_digits; digits_count *= 2)
+        {
+            big_integer const first = random_big_integer(generator, digits_count);
+            big_integer const second = random_big_integer(generator, digits_count);
+
+            std::cout << std::setw(10) << digits_count << std::fixed << std::setprecision(1);
+            for (auto const &rule: rules)
+            {
+                if (rule.second == big_integer::multiplication_rule::trivial && digits_count > max_trivial_digits_count)
+                {
+                    std::cout << std::setw(20) << "-";
+                    continue;
+                }
+
+                std::cout << std::setw(20) << nanoseconds_per_operation([&]()
+                {
+                    sink = sink + operation(first, second, rule.second);
+                }) / 1000;
+            }
+            std::cout << std::endl;
+        }
+        std::cout << std::endl;
+    }
+
+}
+
+int main(
+    int argc,
+    char *argv[])
+{
+    size_t const max_digits = argc > 1
+        ? std::stoul(argv[1])
+        : 16384;
+
+    rules_list const rules
+    {
+        { "trivial", big_integer::multiplication_rule::trivial },
+        { "Karatsuba", big_integer::multiplication_rule::Karatsuba },
+        { "Toom-Cook 3", big_integer::multiplication_rule::ToomCook3 },
+        { "Toom-Cook 4", big_integer::multiplication_rule::ToomCook4 },
+        { "Schonhage-Strassen", big_integer::multiplication_rule::SchonhageStrassen },
+        { "automatic", big_integer::multiplication_rule::automatic }
+    };
+
+    print_table("products", rules, max_digits, [](big_integer const &first, big_integer const &second, big_integer::multiplication_rule rule)
+    {
+        return big_integer::multiply(first, second, nullptr, rule) == first;
+    });
+
+    print_table("squares", rules, max_digits, [](big_integer const &first, big_integer const &second, big_integer::multiplication_rule rule)
+    {
+        return big_integer::square(first, nullptr, rule) == second;
+    });
+
+    return 0;
+}
\ No newline at end of file
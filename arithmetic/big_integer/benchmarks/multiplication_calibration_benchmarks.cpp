@@ -0,0 +1,174 @@
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+
+#include <big_integer.h>
+
+namespace
+{
+
+    size_t const unlimited = std::numeric_limits<size_t>::max();
+
+    double nanoseconds_per_operation(
+        std::function<void()> const &operation)
+    {
+        size_t iterations = 1;
+        while (true)
+        {
+            auto const started_at = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < iterations; ++i)
+            {
+                operation();
+            }
+            auto const elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - started_at).count();
+
+            if (elapsed > 5e7)
+            {
+                return elapsed / static_cast<double>(iterations);
+            }
+            iterations *= 2;
+        }
+    }
+
+    big_integer random_big_integer(
+        std::mt19937 &generator,
+        size_t digits_count)
+    {
+        static char const hex_digits[] = "0123456789abcdef";
+
+        std::string value(digits_count * 16, '0');
+        for (auto &value_digit: value)
+        {
+            value_digit = hex_digits[generator() % 16];
+        }
+        value.front() = hex_digits[1 + generator() % 15];
+        return big_integer(value, 16);
+    }
+
+    // time of a product of two digits_count digits operands with the given automatic rule thresholds
+    double time_multiplication(
+        std::mt19937 &generator,
+        size_t digits_count,
+        big_integer::multiplication_thresholds const &thresholds)
+    {
+        big_integer const first = random_big_integer(generator, digits_count);
+        big_integer const second = random_big_integer(generator, digits_count);
+        volatile size_t sink = 0;
+
+        big_integer::set_multiplication_thresholds(thresholds);
+        return nanoseconds_per_operation([&]()
+        {
+            sink = sink + (big_integer::multiply(first, second, nullptr, big_integer::multiplication_rule::automatic) == first);
+        });
+    }
+
+    // the smallest size from which the top level of a product is faster with the next algorithm
+    // (threshold == size) than with the previous one (threshold == size + 1) twice in a row
+    size_t find_threshold(
+        std::mt19937 &generator,
+        std::string const &algorithm_name,
+        size_t from,
+        size_t to,
+        std::function<big_integer::multiplication_thresholds(size_t)> const &thresholds)
+    {
+        size_t candidate = unlimited;
+        for (size_t digits_count = from; digits_count <= to; digits_count += std::max<size_t>(1, digits_count / 8))
+        {
+            double const previous_time = time_multiplication(generator, digits_count, thresholds(digits_count + 1));
+            double const next_time = time_multiplication(generator, digits_count, thresholds(digits_count));
+
+            std::cout
+                << std::left << std::setw(22) << algorithm_name
+                << std::right << std::setw(10) << digits_count
+                << std::fixed << std::setprecision(0)
+                << std::setw(18) << previous_time
+                << std::setw(18) << next_time
+                << std::setprecision(3)
+                << std::setw(10) << next_time / previous_time
+                << std::endl;
+
+            if (next_time < previous_time)
+            {
+                if (candidate != unlimited)
+                {
+                    return candidate;
+                }
+                candidate = digits_count;
+            }
+            else
+            {
+                candidate = unlimited;
+            }
+        }
+
+        return to;
+    }
+
+}
+
+int main(
+    int argc,
+    char *argv[])
+{
+    size_t const max_digits = argc > 1
+        ? std::stoul(argv[1])
+        : 16384;
+
+    std::mt19937 generator(20240601);
+
+    std::cout
+        << std::left << std::setw(22) << "algorithm"
+        << std::right << std::setw(10) << "digits"
+        << std::setw(18) << "before, ns/op"
+        << std::setw(18) << "with, ns/op"
+        << std::setw(10) << "ratio"
+        << std::endl;
+
+    big_integer::multiplication_thresholds thresholds{};
+
+    thresholds.Karatsuba = find_threshold(generator, "Karatsuba", 4, std::min<size_t>(max_digits, 256), [](size_t digits_count)
+    {
+        return big_integer::multiplication_thresholds{ digits_count, unlimited, unlimited, unlimited, unlimited };
+    });
+
+    thresholds.Toom_Cook_3 = find_threshold(generator, "Toom-Cook 3", thresholds.Karatsuba, std::min<size_t>(max_digits, 2048), [&thresholds](size_t digits_count)
+    {
+        return big_integer::multiplication_thresholds{ thresholds.Karatsuba, digits_count, unlimited, unlimited, unlimited };
+    });
+
+    thresholds.Toom_Cook_4 = find_threshold(generator, "Toom-Cook 4", thresholds.Toom_Cook_3, max_digits, [&thresholds](size_t digits_count)
+    {
+        return big_integer::multiplication_thresholds{ thresholds.Karatsuba, thresholds.Toom_Cook_3, digits_count, unlimited, unlimited };
+    });
+
+    thresholds.Schonhage_Strassen = find_threshold(generator, "Schonhage-Strassen", thresholds.Toom_Cook_3, max_digits, [&thresholds](size_t digits_count)
+    {
+        return big_integer::multiplication_thresholds{ thresholds.Karatsuba, thresholds.Toom_Cook_3, std::min(thresholds.Toom_Cook_4, digits_count), digits_count, unlimited };
+    });
+
+    // both transforms are measured against the Toom-Cook recursion
+    thresholds.NTT = find_threshold(generator, "NTT", thresholds.Toom_Cook_3, max_digits, [&thresholds](size_t digits_count)
+    {
+        return big_integer::multiplication_thresholds{ thresholds.Karatsuba, thresholds.Toom_Cook_3, std::min(thresholds.Toom_Cook_4, digits_count), digits_count, digits_count };
+    });
+
+    // an algorithm never runs above the threshold of the next one
+    thresholds.Schonhage_Strassen = std::min(thresholds.Schonhage_Strassen, thresholds.NTT);
+    thresholds.Toom_Cook_4 = std::min(thresholds.Toom_Cook_4, thresholds.Schonhage_Strassen);
+
+    std::cout
+        << std::endl
+        << "recommended thresholds, digits of the shorter operand:" << std::endl
+        << "    Karatsuba: " << thresholds.Karatsuba << std::endl
+        << "    Toom-Cook 3: " << thresholds.Toom_Cook_3 << std::endl
+        << "    Toom-Cook 4: " << thresholds.Toom_Cook_4 << std::endl
+        << "    Schonhage-Strassen: " << thresholds.Schonhage_Strassen << std::endl
+        << "    NTT: " << thresholds.NTT << std::endl;
+
+    return 0;
+}
\ No newline at end of file
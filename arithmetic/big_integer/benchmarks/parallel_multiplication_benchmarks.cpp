@@ -0,0 +1,120 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <big_integer.h>
+
+namespace
+{
+
+    double milliseconds_per_operation(
+        std::function<void()> const &operation)
+    {
+        size_t iterations = 1;
+        while (true)
+        {
+            auto const started_at = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < iterations; ++i)
+            {
+                operation();
+            }
+            auto const elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started_at).count();
+
+            if (elapsed > 200)
+            {
+                return elapsed / static_cast<double>(iterations);
+            }
+            iterations *= 2;
+        }
+    }
+
+    big_integer random_big_integer(
+        std::mt19937 &generator,
+        size_t digits_count)
+    {
+        static char const hex_digits[] = "0123456789abcdef";
+
+        std::string value(digits_count * 16, '0');
+        for (auto &value_digit: value)
+        {
+            value_digit = hex_digits[generator() % 16];
+        }
+        value.front() = hex_digits[1 + generator() % 15];
+        return big_integer(value, 16);
+    }
+
+}
+
+int main(
+    int argc,
+    char *argv[])
+{
+    size_t const max_digits = argc > 1
+        ? std::stoul(argv[1])
+        : 65536;
+    size_t const max_threads_count = argc > 2
+        ? std::stoul(argv[2])
+        : std::max<size_t>(1, std::thread::hardware_concurrency());
+
+    std::vector<std::pair<std::string, big_integer::multiplication_rule>> const rules =
+    {
+        { "Karatsuba", big_integer::multiplication_rule::Karatsuba },
+        { "Toom-Cook 3", big_integer::multiplication_rule::ToomCook3 },
+        { "Toom-Cook 4", big_integer::multiplication_rule::ToomCook4 },
+        { "NTT", big_integer::multiplication_rule::NTT },
+        { "automatic", big_integer::multiplication_rule::automatic }
+    };
+
+    std::mt19937 generator(20240601);
+    volatile size_t sink = 0;
+    auto const default_parallelism = big_integer::get_multiplication_parallelism();
+
+    std::cout
+        << std::left << std::setw(14) << "rule"
+        << std::right << std::setw(10) << "digits"
+        << std::setw(10) << "threads"
+        << std::setw(14) << "ms/op"
+        << std::setw(10) << "speedup"
+        << std::endl;
+
+    for (size_t digits_count = 4096; digits_count <= max_digits; digits_count *= 4)
+    {
+        big_integer const first = random_big_integer(generator, digits_count);
+        big_integer const second = random_big_integer(generator, digits_count);
+
+        for (auto const &rule: rules)
+        {
+            double serial_time = 0;
+            for (size_t threads_count = 1; threads_count <= max_threads_count; threads_count *= 2)
+            {
+                big_integer::set_multiplication_parallelism(big_integer::multiplication_parallelism{ threads_count, default_parallelism.threshold });
+                double const time = milliseconds_per_operation([&]() { sink = sink + (big_integer::multiply(first, second, nullptr, rule.second) == first); });
+                if (threads_count == 1)
+                {
+                    serial_time = time;
+                }
+
+                std::cout
+                    << std::left << std::setw(14) << rule.first
+                    << std::right << std::setw(10) << digits_count
+                    << std::setw(10) << threads_count
+                    << std::fixed << std::setprecision(2)
+                    << std::setw(14) << time
+                    << std::setw(9) << serial_time / time << 'x'
+                    << std::endl;
+            }
+        }
+    }
+
+    big_integer::set_multiplication_parallelism(default_parallelism);
+
+    return 0;
+}
\ No newline at end of file
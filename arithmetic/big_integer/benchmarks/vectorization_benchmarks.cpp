@@ -0,0 +1,128 @@
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <big_integer.h>
+
+namespace
+{
+
+    double nanoseconds_per_operation(
+        std::function<void()> const &operation)
+    {
+        size_t iterations = 1;
+        while (true)
+        {
+            auto const started_at = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < iterations; ++i)
+            {
+                operation();
+            }
+            auto const elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - started_at).count();
+
+            if (elapsed > 2e8)
+            {
+                return elapsed / static_cast<double>(iterations);
+            }
+            iterations *= 2;
+        }
+    }
+
+    big_integer random_big_integer(
+        std::mt19937 &generator,
+        size_t digits_count)
+    {
+        static char const hex_digits[] = "0123456789abcdef";
+
+        std::string value(digits_count * 16, '0');
+        for (auto &value_digit: value)
+        {
+            value_digit = hex_digits[generator() % 16];
+        }
+        value.front() = hex_digits[1 + generator() % 15];
+        return big_integer(value, 16);
+    }
+
+}
+
+int main(
+    int argc,
+    char *argv[])
+{
+    size_t const max_digits = argc > 1
+        ? std::stoul(argv[1])
+        : 65536;
+
+    std::vector<std::pair<std::string, big_integer::vectorization>> vectorizations =
+    {
+        { "scalar", big_integer::vectorization::scalar },
+        { "AVX2", big_integer::vectorization::AVX2 },
+        { "AVX-512", big_integer::vectorization::AVX512 }
+    };
+    auto const supported_vectorization = big_integer::get_supported_vectorization();
+    while (static_cast<int>(vectorizations.back().second) > static_cast<int>(supported_vectorization))
+    {
+        vectorizations.pop_back();
+    }
+
+    std::mt19937 generator(20240601);
+
+    std::cout
+        << std::left << std::setw(20) << "operation"
+        << std::right << std::setw(10) << "digits"
+        << std::setw(10) << "kernels"
+        << std::setw(14) << "ns/op"
+        << std::setw(10) << "speedup"
+        << std::endl;
+
+    for (size_t digits_count = 64; digits_count <= max_digits; digits_count *= 8)
+    {
+        big_integer value = random_big_integer(generator, digits_count);
+        big_integer const other = random_big_integer(generator, digits_count);
+        big_integer const negative_other = -random_big_integer(generator, digits_count);
+
+        // every pair of operations leaves the value as it was, so the sizes stay put
+        std::vector<std::pair<std::string, std::function<void()>>> const operations =
+        {
+            { "and", [&]() { value &= other; value |= other; } },
+            { "or", [&]() { value |= other; value &= other; } },
+            { "xor", [&]() { value ^= other; value ^= other; } },
+            { "xor, negative", [&]() { value ^= negative_other; value ^= negative_other; } },
+            { "shifts", [&]() { value <<= 13; value >>= 13; } },
+            { "addition", [&]() { value += other; value -= other; } }
+        };
+
+        for (auto const &operation: operations)
+        {
+            double scalar_time = 0;
+            for (auto const &vectorization: vectorizations)
+            {
+                big_integer::set_vectorization(vectorization.second);
+                double const time = nanoseconds_per_operation(operation.second);
+                if (vectorization.second == big_integer::vectorization::scalar)
+                {
+                    scalar_time = time;
+                }
+
+                std::cout
+                    << std::left << std::setw(20) << operation.first
+                    << std::right << std::setw(10) << digits_count
+                    << std::setw(10) << vectorization.first
+                    << std::fixed << std::setprecision(0)
+                    << std::setw(14) << time
+                    << std::setprecision(2)
+                    << std::setw(9) << scalar_time / time << 'x'
+                    << std::endl;
+            }
+        }
+    }
+
+    big_integer::set_vectorization(supported_vectorization);
+
+    return 0;
+}
\ No newline at end of file
@@ -1,14 +1,21 @@
 #ifndef MATH_PRACTICE_AND_OPERATING_SYSTEMS_BIGINT_H
 #define MATH_PRACTICE_AND_OPERATING_SYSTEMS_BIGINT_H
 
+#include <cstdint>
 #include <iostream>
 #include <map>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include <allocator.h>
 #include <allocator_guardant.h>
 #include <not_implemented.h>
 
+#ifndef MP_OS_ARTHMTC_BG_INTGR_INLINE_DIGITS_COUNT
+#define MP_OS_ARTHMTC_BG_INTGR_INLINE_DIGITS_COUNT 2
+#endif
+
 class big_integer final:
     allocator_guardant
 {
@@ -19,7 +26,47 @@ public:
     {
         trivial,
         Karatsuba,
-        SchonhageStrassen
+        ToomCook3,
+        ToomCook4,
+        SchonhageStrassen,
+        NTT,
+        automatic
+    };
+
+    // sizes of the shorter operand, in 64-bit digits, from which multiplication_rule::automatic
+    // switches to each algorithm; smaller products are done by the schoolbook method
+    struct multiplication_thresholds final
+    {
+
+        size_t Karatsuba;
+
+        size_t Toom_Cook_3;
+
+        size_t Toom_Cook_4;
+
+        size_t Schonhage_Strassen;
+
+        size_t NTT;
+
+    };
+
+    // products whose shorter operand has at least threshold digits split their Karatsuba and Toom-Cook
+    // branches, unbalanced slices and NTT stages between threads_count threads of a work-stealing pool
+    struct multiplication_parallelism final
+    {
+
+        size_t threads_count;
+
+        size_t threshold;
+
+    };
+
+    // instruction set extensions the bitwise operations and shifts run their digit loops on
+    enum class vectorization
+    {
+        scalar,
+        AVX2,
+        AVX512
     };
 
 private:
@@ -63,6 +110,30 @@ private:
         
     };
     
+    class Toom_Cook_3_multiplication final:
+        public multiplication
+    {
+
+    public:
+        
+        big_integer &multiply(
+            big_integer &first_multiplier,
+            big_integer const &second_multiplier) const override;
+        
+    };
+    
+    class Toom_Cook_4_multiplication final:
+        public multiplication
+    {
+
+    public:
+        
+        big_integer &multiply(
+            big_integer &first_multiplier,
+            big_integer const &second_multiplier) const override;
+        
+    };
+    
     class Schonhage_Strassen_multiplication final:
         public multiplication
     {
@@ -74,6 +145,31 @@ private:
             big_integer const &second_multiplier) const override;
         
     };
+    
+    // number theoretic transforms modulo three primes below 2^62, combined by the chinese remainder theorem
+    class NTT_multiplication final:
+        public multiplication
+    {
+
+    public:
+        
+        big_integer &multiply(
+            big_integer &first_multiplier,
+            big_integer const &second_multiplier) const override;
+        
+    };
+    
+    class automatic_multiplication final:
+        public multiplication
+    {
+
+    public:
+        
+        big_integer &multiply(
+            big_integer &first_multiplier,
+            big_integer const &second_multiplier) const override;
+        
+    };
 
 public:
     
@@ -105,6 +201,13 @@ private:
             big_integer const &divisor,
             big_integer::multiplication_rule multiplication_rule) const = 0;
         
+        // the quotient replaces the dividend, the remainder may be the divisor but not the dividend
+        virtual void divmod(
+            big_integer &dividend,
+            big_integer const &divisor,
+            big_integer &remainder,
+            big_integer::multiplication_rule multiplication_rule) const = 0;
+        
     };
     
     class trivial_division final:
@@ -123,6 +226,12 @@ private:
             big_integer const &divisor,
             big_integer::multiplication_rule multiplication_rule) const override;
         
+        void divmod(
+            big_integer &dividend,
+            big_integer const &divisor,
+            big_integer &remainder,
+            big_integer::multiplication_rule multiplication_rule) const override;
+        
     };
     
     class Newton_division final:
@@ -141,6 +250,12 @@ private:
             big_integer const &divisor,
             big_integer::multiplication_rule multiplication_rule) const override;
         
+        void divmod(
+            big_integer &dividend,
+            big_integer const &divisor,
+            big_integer &remainder,
+            big_integer::multiplication_rule multiplication_rule) const override;
+        
     };
     
     class Burnikel_Ziegler_division final:
@@ -159,12 +274,33 @@ private:
             big_integer const &divisor,
             big_integer::multiplication_rule multiplication_rule) const override;
         
+        void divmod(
+            big_integer &dividend,
+            big_integer const &divisor,
+            big_integer &remainder,
+            big_integer::multiplication_rule multiplication_rule) const override;
+        
     };
 
 private:
 
-    int _oldest_digit;
-    unsigned int *_other_digits;
+    // 64-bit digits, products and quotients go through 128-bit intermediates
+    using digit_t = uint64_t;
+
+    // values of up to this many digits live inside the object and never touch the allocator
+    static constexpr size_t inline_digits_count = MP_OS_ARTHMTC_BG_INTGR_INLINE_DIGITS_COUNT;
+
+    static_assert(inline_digits_count > 0, "at least one digit must be stored inline");
+
+private:
+
+    bool _is_negative;
+    size_t _digits_count;
+    size_t _digits_capacity;
+    // magnitude, least significant digit first, without leading zero digits;
+    // points to _inline_digits until the value outgrows them
+    digit_t *_digits;
+    digit_t _inline_digits[inline_digits_count];
     allocator *_allocator;
 
 public:
@@ -178,6 +314,21 @@ public:
         std::vector<int> const &digits,
         allocator *allocator = nullptr);
 
+    // a value of any built-in integer type with its sign; it takes integer literals too, so big_integer(0) is zero
+    // instead of the string constructed from a null pointer
+    template<
+        typename integer_t,
+        typename std::enable_if<std::is_integral<integer_t>::value, int>::type = 0>
+    explicit big_integer(
+        integer_t value,
+        allocator *allocator = nullptr):
+            big_integer(std::is_signed<integer_t>::value && value < 0
+                ? uint64_t(0) - static_cast<uint64_t>(value)
+                : static_cast<uint64_t>(value), std::is_signed<integer_t>::value && value < 0, allocator)
+    {
+
+    }
+
     explicit big_integer(
         std::string const &value_as_string,
         size_t base = 10,
@@ -325,41 +476,300 @@ public:
         big_integer &first_multiplier,
         big_integer const &second_multiplier,
         allocator *allocator = nullptr,
-        big_integer::multiplication_rule multiplication_rule = big_integer::multiplication_rule::trivial);
+        big_integer::multiplication_rule multiplication_rule = big_integer::multiplication_rule::automatic);
 
     static big_integer multiply(
         big_integer const &first_multiplier,
         big_integer const &second_multiplier,
         allocator *allocator = nullptr,
-        big_integer::multiplication_rule multiplication_rule = big_integer::multiplication_rule::trivial);
+        big_integer::multiplication_rule multiplication_rule = big_integer::multiplication_rule::automatic);
+
+    // multiplies value by itself, computing every cross product only once
+    static big_integer &square(
+        big_integer &value,
+        allocator *allocator = nullptr,
+        big_integer::multiplication_rule multiplication_rule = big_integer::multiplication_rule::automatic);
+
+    static big_integer square(
+        big_integer const &value,
+        allocator *allocator = nullptr,
+        big_integer::multiplication_rule multiplication_rule = big_integer::multiplication_rule::automatic);
+
+public:
+
+    // value^degree by squaring, left to right over the bits of degree, in the own digits of the result;
+    // trailing zero bits of value come back as a single shift at the end; 0^0 = 1
+    static big_integer &pow(
+        big_integer &value,
+        size_t degree,
+        allocator *allocator = nullptr,
+        big_integer::multiplication_rule multiplication_rule = big_integer::multiplication_rule::automatic);
+
+    static big_integer pow(
+        big_integer const &value,
+        size_t degree,
+        allocator *allocator = nullptr,
+        big_integer::multiplication_rule multiplication_rule = big_integer::multiplication_rule::automatic);
+
+    // floor(sqrt(value)); throws std::invalid_argument for a negative value
+    static big_integer &isqrt(
+        big_integer &value,
+        allocator *allocator = nullptr,
+        big_integer::multiplication_rule multiplication_rule = big_integer::multiplication_rule::automatic);
+
+    static big_integer isqrt(
+        big_integer const &value,
+        allocator *allocator = nullptr,
+        big_integer::multiplication_rule multiplication_rule = big_integer::multiplication_rule::automatic);
+
+    // the degree-th root rounded towards zero, so negative values take odd degrees only;
+    // throws std::invalid_argument for a zero degree or a negative value with an even one
+    static big_integer &iroot(
+        big_integer &value,
+        size_t degree,
+        allocator *allocator = nullptr,
+        big_integer::multiplication_rule multiplication_rule = big_integer::multiplication_rule::automatic);
+
+    static big_integer iroot(
+        big_integer const &value,
+        size_t degree,
+        allocator *allocator = nullptr,
+        big_integer::multiplication_rule multiplication_rule = big_integer::multiplication_rule::automatic);
+
+public:
+
+    // capacities are counted in bits and rounded up to whole digits; growing values take half of the capacity again,
+    // and compound assignments reuse the digits they already have whenever the result fits
+    void reserve(
+        size_t bits_count);
+
+    [[nodiscard]] size_t capacity() const noexcept;
+
+    // returns the unused digits, values short enough move back into the object
+    void shrink_to_fit();
+
+public:
+
+    // bits of the magnitude, zero has none
+    [[nodiscard]] size_t bit_length() const noexcept;
+
+    // zero bits of the magnitude below its lowest one, zero has none
+    [[nodiscard]] size_t trailing_zero_bits_count() const noexcept;
+
+    static big_integer power_of_two(
+        size_t exponent,
+        allocator *allocator = nullptr);
+
+public:
+
+    // fused multiply-add chains without temporaries, e.g. result.assign_product(a, b).add_product(c, d) -= e;
+    // products go into the own digits or into a per-thread scratch kept between calls, and the own digits
+    // never shrink, so a destination reused across iterations of a loop stops allocating
+    big_integer &assign_product(
+        big_integer const &first_multiplier,
+        big_integer const &second_multiplier,
+        big_integer::multiplication_rule multiplication_rule = big_integer::multiplication_rule::automatic);
+
+    big_integer &add_product(
+        big_integer const &first_multiplier,
+        big_integer const &second_multiplier,
+        big_integer::multiplication_rule multiplication_rule = big_integer::multiplication_rule::automatic);
+
+    big_integer &subtract_product(
+        big_integer const &first_multiplier,
+        big_integer const &second_multiplier,
+        big_integer::multiplication_rule multiplication_rule = big_integer::multiplication_rule::automatic);
+
+public:
 
     static big_integer &divide(
         big_integer &dividend,
         big_integer const &divisor,
         allocator *allocator = nullptr,
         big_integer::division_rule division_rule = big_integer::division_rule::trivial,
-        big_integer::multiplication_rule multiplication_rule = big_integer::multiplication_rule::trivial);
+        big_integer::multiplication_rule multiplication_rule = big_integer::multiplication_rule::automatic);
 
     static big_integer divide(
         big_integer const &dividend,
         big_integer const &divisor,
         allocator *allocator = nullptr,
         big_integer::division_rule division_rule = big_integer::division_rule::trivial,
-        big_integer::multiplication_rule multiplication_rule = big_integer::multiplication_rule::trivial);
+        big_integer::multiplication_rule multiplication_rule = big_integer::multiplication_rule::automatic);
 
     static big_integer &modulo(
         big_integer &dividend,
         big_integer const &divisor,
         allocator *allocator = nullptr,
         big_integer::division_rule division_rule = big_integer::division_rule::trivial,
-        big_integer::multiplication_rule multiplication_rule = big_integer::multiplication_rule::trivial);
+        big_integer::multiplication_rule multiplication_rule = big_integer::multiplication_rule::automatic);
 
     static big_integer modulo(
         big_integer const &dividend,
         big_integer const &divisor,
         allocator *allocator = nullptr,
         big_integer::division_rule division_rule = big_integer::division_rule::trivial,
-        big_integer::multiplication_rule multiplication_rule = big_integer::multiplication_rule::trivial);
+        big_integer::multiplication_rule multiplication_rule = big_integer::multiplication_rule::automatic);
+
+    // quotient and remainder from a single division, rounded as by divide and modulo: the quotient replaces
+    // the dividend and the remainder goes to remainder, which may be the divisor but not the dividend
+    static big_integer &divmod(
+        big_integer &dividend,
+        big_integer const &divisor,
+        big_integer &remainder,
+        big_integer::division_rule division_rule = big_integer::division_rule::trivial,
+        big_integer::multiplication_rule multiplication_rule = big_integer::multiplication_rule::automatic);
+
+    // the quotient first, the remainder second
+    static std::pair<big_integer, big_integer> divmod(
+        big_integer const &dividend,
+        big_integer const &divisor,
+        allocator *allocator = nullptr,
+        big_integer::division_rule division_rule = big_integer::division_rule::trivial,
+        big_integer::multiplication_rule multiplication_rule = big_integer::multiplication_rule::automatic);
+
+    class Newton_divisor;
+
+public:
+
+    // Euclid: a division per quotient;
+    // Lehmer: quotients taken from the leading two digits of the operands, many of them per pass over the digits;
+    // HalfGCD: a recursion halving the operands with products of quotient matrices, Lehmer's steps below a threshold
+    enum class gcd_rule
+    {
+        Euclid,
+        Lehmer,
+        HalfGCD
+    };
+
+    // greatest common divisor of the absolute values, gcd(0, 0) = 0
+    static big_integer gcd(
+        big_integer const &first,
+        big_integer const &second,
+        allocator *allocator = nullptr,
+        big_integer::gcd_rule gcd_rule = big_integer::gcd_rule::HalfGCD,
+        big_integer::multiplication_rule multiplication_rule = big_integer::multiplication_rule::automatic);
+
+    // also finds the coefficients of first * first_coefficient + second * second_coefficient = gcd,
+    // with 0 <= first_coefficient < |second| / gcd for a nonzero second; the coefficients may be the operands themselves
+    static big_integer extended_gcd(
+        big_integer const &first,
+        big_integer const &second,
+        big_integer &first_coefficient,
+        big_integer &second_coefficient,
+        allocator *allocator = nullptr,
+        big_integer::gcd_rule gcd_rule = big_integer::gcd_rule::HalfGCD,
+        big_integer::multiplication_rule multiplication_rule = big_integer::multiplication_rule::automatic);
+
+public:
+
+    // Montgomery reduction needs an odd modulus, Barrett reduction works for any;
+    // automatic picks Montgomery for odd moduli and Barrett for even ones
+    enum class reduction_rule
+    {
+        Montgomery,
+        Barrett,
+        automatic
+    };
+
+    class modular_context;
+
+public:
+
+    static multiplication_thresholds get_multiplication_thresholds() noexcept;
+
+    // applies to multiplications started afterwards; the thresholds must not decrease
+    // from Karatsuba to NTT and Karatsuba must be at least 2
+    static void set_multiplication_thresholds(
+        multiplication_thresholds const &thresholds);
+
+    static multiplication_parallelism get_multiplication_parallelism() noexcept;
+
+    // applies to multiplications started afterwards; a single thread keeps every multiplication serial
+    static void set_multiplication_parallelism(
+        multiplication_parallelism const &parallelism);
+
+    // the widest extension both the build and the CPU support, and the one in use, which starts as the supported one
+    static vectorization get_supported_vectorization() noexcept;
+
+    static vectorization get_vectorization() noexcept;
+
+    // applies to operations started afterwards; throws std::invalid_argument for extensions beyond the supported one
+    static void set_vectorization(
+        vectorization vectorization);
+
+public:
+
+    // digits in base 2..36 with lowercase letters above 9, most significant first, '-' ahead of negative values
+    std::string to_string(
+        size_t base = 10) const;
+
+public:
+
+    // binary form: the sign and the count of digits, then the 64-bit digits as little-endian bytes,
+    // least significant first; fixed spends a byte on the sign and 8 little-endian bytes on the count,
+    // varint writes count * 2 + sign as an unsigned LEB128 number
+    enum class serialization_format
+    {
+        fixed,
+        varint
+    };
+
+    size_t serialized_size(
+        big_integer::serialization_format format = big_integer::serialization_format::fixed) const noexcept;
+
+    // returns the count of bytes written; throws std::length_error if they don't fit into buffer_size bytes
+    size_t serialize(
+        void *buffer,
+        size_t buffer_size,
+        big_integer::serialization_format format = big_integer::serialization_format::fixed) const;
+
+    void serialize(
+        std::ostream &stream,
+        big_integer::serialization_format format = big_integer::serialization_format::fixed) const;
+
+    // reads a value from the beginning of buffer, bytes_read gets the size of its binary form;
+    // throws std::invalid_argument if buffer_size bytes don't hold a whole value
+    static big_integer deserialize(
+        void const *buffer,
+        size_t buffer_size,
+        size_t &bytes_read,
+        big_integer::serialization_format format = big_integer::serialization_format::fixed,
+        allocator *allocator = nullptr);
+
+    // throws std::invalid_argument if the stream ends before the value does
+    static big_integer deserialize(
+        std::istream &stream,
+        big_integer::serialization_format format = big_integer::serialization_format::fixed,
+        allocator *allocator = nullptr);
+
+    // bulk forms: the count of values in the format of a digits count, then every value
+
+    static size_t serialized_size(
+        std::vector<big_integer> const &values,
+        big_integer::serialization_format format = big_integer::serialization_format::fixed) noexcept;
+
+    static size_t serialize(
+        std::vector<big_integer> const &values,
+        void *buffer,
+        size_t buffer_size,
+        big_integer::serialization_format format = big_integer::serialization_format::fixed);
+
+    static void serialize(
+        std::vector<big_integer> const &values,
+        std::ostream &stream,
+        big_integer::serialization_format format = big_integer::serialization_format::fixed);
+
+    static std::vector<big_integer> deserialize_all(
+        void const *buffer,
+        size_t buffer_size,
+        size_t &bytes_read,
+        big_integer::serialization_format format = big_integer::serialization_format::fixed,
+        allocator *allocator = nullptr);
+
+    static std::vector<big_integer> deserialize_all(
+        std::istream &stream,
+        big_integer::serialization_format format = big_integer::serialization_format::fixed,
+        allocator *allocator = nullptr);
 
 public:
     
@@ -374,7 +784,256 @@ public:
 private:
 
     [[nodiscard]] allocator *get_allocator() const noexcept override;
+
+private:
+
+    big_integer(
+        uint64_t magnitude,
+        bool is_negative,
+        allocator *allocator);
+
+    big_integer(
+        digit_t const *digits,
+        size_t digits_count,
+        bool is_negative,
+        allocator *allocator);
+
+    void assign(
+        digit_t const *digits,
+        size_t digits_count,
+        bool is_negative);
+
+    void clear() noexcept;
+
+    // keeps the current digits
+    void ensure_capacity(
+        size_t digits_count);
+
+    // moves the digits into a buffer of exactly capacity digits, or into the inline ones when they are enough;
+    // capacity can't be less than the digits count
+    void reallocate_digits(
+        size_t capacity);
+
+    // returns the digits taken from the allocator and switches back to the inline ones
+    void release_digits() noexcept;
+
+    // drops leading zero digits among the first digits_count ones
+    void set_digits_count(
+        size_t digits_count) noexcept;
+
+    bool is_zero() const noexcept;
+
+    static int compare_magnitudes(
+        big_integer const &first,
+        big_integer const &second) noexcept;
+
+    // *this = first + second, taking second_is_negative as the sign of second; the operands may alias *this
+    big_integer &assign_sum(
+        big_integer const &first,
+        big_integer const &second,
+        bool second_is_negative);
+
+    // *this += digits, taking is_negative as their sign; the digits must not be the own ones
+    big_integer &add_magnitude(
+        digit_t const *digits,
+        size_t digits_count,
+        bool is_negative);
+
+    big_integer &accumulate_product(
+        big_integer const &first_multiplier,
+        big_integer const &second_multiplier,
+        bool subtract,
+        big_integer::multiplication_rule multiplication_rule);
+
+    big_integer &apply_bitwise(
+        big_integer const &other,
+        char operation);
+
+    static big_integer &multiply_with_rule(
+        big_integer &first_multiplier,
+        big_integer const &second_multiplier,
+        big_integer::multiplication_rule multiplication_rule);
+
+    // floor(value^(1 / degree)) into result for a value that isn't negative, result must not be value;
+    // Newton's iteration from above, started from the root of the leading half of the bits
+    static void assign_root(
+        big_integer &result,
+        big_integer const &value,
+        size_t degree,
+        big_integer::multiplication_rule multiplication_rule);
+
+    static big_integer::multiplication const &get_multiplication(
+        big_integer::multiplication_rule multiplication_rule);
+
+    static big_integer::division const &get_division(
+        big_integer::division_rule division_rule);
+
+    static void throw_if_invalid_root(
+        big_integer const &value,
+        size_t degree);
+
+    static void throw_if_division_by_zero(
+        big_integer const &divisor);
     
 };
 
+// arithmetic modulo a modulus fixed at construction: everything a reduction needs is computed once,
+// so modular products take a couple of multiplications and no division;
+// scratch digits are kept between calls, so a context is used by one thread at a time
+class big_integer::modular_context final
+{
+
+private:
+
+    big_integer _modulus;
+
+    // never automatic
+    big_integer::reduction_rule _reduction_rule;
+
+    // Montgomery: -modulus^-1 modulo 2^64 and modulo R = 2^(64 * digits count of the modulus),
+    // and R^2 modulo the modulus to bring values into the Montgomery form
+    big_integer::digit_t _Montgomery_digit_inverse;
+
+    std::vector<big_integer::digit_t> _Montgomery_inverse;
+
+    std::vector<big_integer::digit_t> _Montgomery_square;
+
+    // Barrett: floor(2^(128 * digits count of the modulus) / modulus)
+    std::vector<big_integer::digit_t> _Barrett_reciprocal;
+
+    // a double width product and the intermediate products of its reduction
+    std::vector<big_integer::digit_t> _scratch;
+
+    // residues of the sliding window table and the accumulator of power
+    std::vector<big_integer::digit_t> _residues;
+
+    allocator *_allocator;
+
+public:
+
+    // throws std::invalid_argument unless the modulus is greater than one,
+    // or if Montgomery reduction is asked for an even modulus
+    explicit modular_context(
+        big_integer const &modulus,
+        big_integer::reduction_rule reduction_rule = big_integer::reduction_rule::automatic,
+        allocator *allocator = nullptr);
+
+public:
+
+    big_integer const &get_modulus() const noexcept;
+
+    big_integer::reduction_rule get_reduction_rule() const noexcept;
+
+public:
+
+    // results are in [0, modulus), operands may be any values including negative ones
+
+    big_integer reduce(
+        big_integer const &value);
+
+    big_integer multiply(
+        big_integer const &first_multiplier,
+        big_integer const &second_multiplier);
+
+    // sliding window exponentiation; a negative exponent raises the modular inverse of base
+    big_integer power(
+        big_integer const &base,
+        big_integer const &exponent);
+
+    // throws std::invalid_argument if value and the modulus aren't coprime
+    big_integer inverse(
+        big_integer const &value);
+
+private:
+
+    size_t get_digits_count() const noexcept;
+
+    // residue gets the digits count of the modulus, zero padded
+    void load_reduced(
+        big_integer const &value,
+        big_integer::digit_t *residue);
+
+    // as load_reduced, then into the Montgomery form when that is the reduction
+    void load(
+        big_integer const &value,
+        big_integer::digit_t *residue);
+
+    big_integer store(
+        big_integer::digit_t const *residue);
+
+    // result may alias the operands
+    void multiply_residues(
+        big_integer::digit_t *result,
+        big_integer::digit_t const *first,
+        big_integer::digit_t const *second);
+
+    // reduces the double width product at the beginning of the scratch into result
+    void reduce_product(
+        big_integer::digit_t *result);
+
+};
+
+// a divisor with its Newton reciprocal computed once, so every division by it takes multiplications only:
+// dividends go through in blocks of the divisor's length, each one costing two products and a correction or two;
+// quotients round towards zero and remainders take the sign of the dividend, as with big_integer::divide and modulo;
+// nothing changes after construction, so the object may serve several threads at once
+class big_integer::Newton_divisor final
+{
+
+private:
+
+    big_integer _divisor;
+
+    // floor(2^(128 * digits count of the divisor) / divisor), rounded down by one at most;
+    // empty for divisors below the Newton threshold, which schoolbook division handles faster
+    std::vector<big_integer::digit_t> _reciprocal;
+
+    big_integer::multiplication_rule _multiplication_rule;
+
+public:
+
+    // throws std::logic_error for a zero divisor
+    explicit Newton_divisor(
+        big_integer const &divisor,
+        big_integer::multiplication_rule multiplication_rule = big_integer::multiplication_rule::automatic);
+
+public:
+
+    big_integer const &get_divisor() const noexcept;
+
+public:
+
+    big_integer divide(
+        big_integer const &dividend,
+        allocator *allocator = nullptr) const;
+
+    big_integer modulo(
+        big_integer const &dividend,
+        allocator *allocator = nullptr) const;
+
+    // batches split their dividends between the threads of the multiplication pool
+    // once they have as many digits in total as the parallel multiplication threshold
+
+    std::vector<big_integer> divide(
+        std::vector<big_integer> const &dividends,
+        allocator *allocator = nullptr) const;
+
+    std::vector<big_integer> modulo(
+        std::vector<big_integer> const &dividends,
+        allocator *allocator = nullptr) const;
+
+private:
+
+    void divide_digits(
+        big_integer const &dividend,
+        std::vector<big_integer::digit_t> *quotient,
+        std::vector<big_integer::digit_t> *remainder) const;
+
+    void divide_all(
+        std::vector<big_integer> const &dividends,
+        std::vector<std::vector<big_integer::digit_t>> *quotients,
+        std::vector<std::vector<big_integer::digit_t>> *remainders) const;
+
+};
+
 #endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_BIGINT_H
\ No newline at end of file
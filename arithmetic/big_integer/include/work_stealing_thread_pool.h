@@ -0,0 +1,100 @@
+#ifndef MATH_PRACTICE_AND_OPERATING_SYSTEMS_WORK_STEALING_THREAD_POOL_H
+#define MATH_PRACTICE_AND_OPERATING_SYSTEMS_WORK_STEALING_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class work_stealing_thread_pool final
+{
+
+public:
+
+    using task = std::function<void()>;
+
+private:
+
+    // tasks are pushed to and popped from the back by the owning thread and stolen from the front
+    struct task_queue final
+    {
+
+    public:
+
+        std::mutex mutex;
+
+        std::deque<task> tasks;
+
+    };
+
+private:
+
+    // one queue per worker, the last one takes tasks forked by threads outside the pool
+    std::vector<std::unique_ptr<task_queue>> _queues;
+
+    std::atomic<size_t> _queued_count;
+
+    std::mutex _wakeup_mutex;
+
+    std::condition_variable _wakeup;
+
+    bool _stopped;
+
+    std::vector<std::thread> _workers;
+
+public:
+
+    // threads_count counts the thread waiting for the tasks too, so the pool starts threads_count - 1 workers
+    explicit work_stealing_thread_pool(
+        size_t threads_count);
+
+    ~work_stealing_thread_pool() noexcept;
+
+    work_stealing_thread_pool(
+        work_stealing_thread_pool const &other) = delete;
+
+    work_stealing_thread_pool &operator=(
+        work_stealing_thread_pool const &other) = delete;
+
+    work_stealing_thread_pool(
+        work_stealing_thread_pool &&other) = delete;
+
+    work_stealing_thread_pool &operator=(
+        work_stealing_thread_pool &&other) = delete;
+
+public:
+
+    size_t get_threads_count() const noexcept;
+
+    // runs the tasks, the first one on the calling thread, and returns once all of them have finished;
+    // a waiting thread runs queued tasks meanwhile, so tasks may fork further tasks themselves;
+    // rethrows the first exception thrown by a task
+    void run_all(
+        std::vector<task> &tasks);
+
+    // the pool whose worker calls it, nullptr on threads outside any pool
+    static work_stealing_thread_pool *get_current() noexcept;
+
+private:
+
+    size_t get_own_queue_index() const noexcept;
+
+    void push(
+        task &&forked_task);
+
+    bool try_run_queued_task();
+
+    void notify_all();
+
+    void stop() noexcept;
+
+    void run_worker(
+        size_t index);
+
+};
+
+#endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_WORK_STEALING_THREAD_POOL_H
\ No newline at end of file
@@ -1,425 +1,6450 @@
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+
 #include "../include/big_integer.h"
+#include "../include/work_stealing_thread_pool.h"
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define MP_OS_ARTHMTC_BG_INTGR_X86_64
+#include <immintrin.h>
+#endif
+
+namespace
+{
+
+    using digit = uint64_t;
+
+    using magnitude = std::vector<digit>;
+
+    size_t const digit_bits = 64;
+
+    // below these sizes (in digits) recursive algorithms fall back to the basecase
+    size_t const Karatsuba_threshold = 32;
+    size_t const Toom_Cook_3_threshold = 256;
+    size_t const Toom_Cook_4_threshold = 512;
+    size_t const Schonhage_Strassen_recursion_threshold = 1024;
+    size_t const Burnikel_Ziegler_threshold = 48;
+    size_t const Newton_threshold = 48;
+    size_t const radix_conversion_threshold = 32;
+    size_t const half_gcd_threshold = 96;
+    size_t const half_gcd_without_cofactors_threshold = 1024;
+
+    // crossover points of multiplication_rule::automatic in digits of the shorter operand,
+    // measured with the multiplication calibration benchmark;
+    // the NTT outruns Schonhage-Strassen at every size it is picked for, so the latter is never chosen by default
+    size_t const default_automatic_Karatsuba_threshold = 32;
+    size_t const default_automatic_Toom_Cook_3_threshold = 512;
+    size_t const default_automatic_Toom_Cook_4_threshold = 2400;
+    size_t const default_automatic_Schonhage_Strassen_threshold = 4096;
+    size_t const default_automatic_NTT_threshold = 4096;
+
+    // products at least this large (in digits of the shorter operand) split their sub-products between threads
+    size_t const default_parallel_multiplication_threshold = 1024;
+
+    // transforms of at least this many values split their butterflies between threads
+    size_t const NTT_parallel_size = size_t(1) << 14;
+
+    // region digit primitives
+
+    inline digit multiply_digits(
+        digit first,
+        digit second,
+        digit &high) noexcept
+    {
+#ifdef __SIZEOF_INT128__
+        unsigned __int128 const product = static_cast<unsigned __int128>(first) * second;
+        high = static_cast<digit>(product >> digit_bits);
+        return static_cast<digit>(product);
+#else
+        digit const first_low = first & 0xFFFFFFFFULL, first_high = first >> 32;
+        digit const second_low = second & 0xFFFFFFFFULL, second_high = second >> 32;
+
+        digit const low_low = first_low * second_low;
+        digit const low_high = first_low * second_high;
+        digit const high_low = first_high * second_low;
+        digit const high_high = first_high * second_high;
+
+        digit const middle = (low_low >> 32) + (low_high & 0xFFFFFFFFULL) + (high_low & 0xFFFFFFFFULL);
+        high = high_high + (low_high >> 32) + (high_low >> 32) + (middle >> 32);
+        return (middle << 32) | (low_low & 0xFFFFFFFFULL);
+#endif
+    }
+
+    // (high * 2^64 + low) / divisor, requires high < divisor
+    inline digit divide_double_digit(
+        digit high,
+        digit low,
+        digit divisor,
+        digit &remainder) noexcept
+    {
+#if defined(__x86_64__) && defined(__GNUC__)
+        digit quotient;
+        __asm__("divq %4" : "=a"(quotient), "=d"(remainder) : "a"(low), "d"(high), "rm"(divisor));
+        return quotient;
+#elif defined(__SIZEOF_INT128__)
+        unsigned __int128 const dividend = (static_cast<unsigned __int128>(high) << digit_bits) | low;
+        remainder = static_cast<digit>(dividend % divisor);
+        return static_cast<digit>(dividend / divisor);
+#else
+        digit quotient = 0;
+        for (size_t bit = 0; bit < digit_bits; ++bit)
+        {
+            digit const overflow = high >> (digit_bits - 1);
+            high = (high << 1) | (low >> (digit_bits - 1));
+            low <<= 1;
+            quotient <<= 1;
+            if (overflow != 0 || high >= divisor)
+            {
+                high -= divisor;
+                quotient |= 1;
+            }
+        }
+        remainder = high;
+        return quotient;
+#endif
+    }
+
+    inline size_t leading_zero_bits(
+        digit value) noexcept
+    {
+#ifdef __GNUC__
+        return value == 0
+            ? digit_bits
+            : static_cast<size_t>(__builtin_clzll(value));
+#else
+        size_t result = 0;
+        for (digit mask = digit(1) << (digit_bits - 1); mask != 0 && (value & mask) == 0; mask >>= 1)
+        {
+            ++result;
+        }
+        return result;
+#endif
+    }
+
+    inline size_t trailing_zero_bits(
+        digit value) noexcept
+    {
+#ifdef __GNUC__
+        return value == 0
+            ? digit_bits
+            : static_cast<size_t>(__builtin_ctzll(value));
+#else
+        size_t result = 0;
+        for (digit mask = 1; mask != 0 && (value & mask) == 0; mask <<= 1)
+        {
+            ++result;
+        }
+        return result;
+#endif
+    }
+
+    // endregion digit primitives
+
+    // region vectorized digit kernels
+
+    big_integer::vectorization detect_supported_vectorization() noexcept
+    {
+#if defined(MP_OS_ARTHMTC_BG_INTGR_X86_64) && defined(MP_OS_ARTHMTC_BG_INTGR_VECTORIZATION)
+        // also checks that the operating system saves the wide registers
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f"))
+        {
+            return big_integer::vectorization::AVX512;
+        }
+        if (__builtin_cpu_supports("avx2"))
+        {
+            return big_integer::vectorization::AVX2;
+        }
+#endif
+        return big_integer::vectorization::scalar;
+    }
+
+    big_integer::vectorization get_supported_vectorization() noexcept
+    {
+        static big_integer::vectorization const supported = detect_supported_vectorization();
+        return supported;
+    }
+
+    std::atomic<big_integer::vectorization> &get_vectorization_state() noexcept
+    {
+        static std::atomic<big_integer::vectorization> state(get_supported_vectorization());
+        return state;
+    }
+
+    // & keeps only the conjunction, ^ only the exclusive disjunction and | both of them
+    inline digit conjunction_mask(
+        char operation) noexcept
+    {
+        return operation == '^'
+            ? 0
+            : ~digit(0);
+    }
+
+    inline digit exclusive_disjunction_mask(
+        char operation) noexcept
+    {
+        return operation == '&'
+            ? 0
+            : ~digit(0);
+    }
+
+    // result = (first ^ first_mask) operation (second ^ second_mask) digit by digit; result may alias the operands
+    void bitwise_digits_scalar(
+        digit *result,
+        digit const *first,
+        digit first_mask,
+        digit const *second,
+        digit second_mask,
+        size_t size,
+        char operation) noexcept
+    {
+        digit const conjunction = conjunction_mask(operation);
+        digit const exclusive_disjunction = exclusive_disjunction_mask(operation);
+        for (size_t i = 0; i < size; ++i)
+        {
+            digit const first_digit = first[i] ^ first_mask;
+            digit const second_digit = second[i] ^ second_mask;
+            result[i] = (first_digit & second_digit & conjunction) | ((first_digit ^ second_digit) & exclusive_disjunction);
+        }
+    }
+
+    void shift_left_digits_scalar(
+        digit *result,
+        digit const *first,
+        size_t size,
+        size_t shift) noexcept
+    {
+        for (size_t i = size; i-- > 1;)
+        {
+            result[i] = (first[i] << shift) | (first[i - 1] >> (digit_bits - shift));
+        }
+    }
+
+    void shift_right_digits_scalar(
+        digit *result,
+        digit const *first,
+        size_t size,
+        size_t shift) noexcept
+    {
+        for (size_t i = 0; i + 1 < size; ++i)
+        {
+            result[i] = (first[i] >> shift) | (first[i + 1] << (digit_bits - shift));
+        }
+    }
+
+#if defined(MP_OS_ARTHMTC_BG_INTGR_X86_64) && defined(MP_OS_ARTHMTC_BG_INTGR_VECTORIZATION)
+
+    __attribute__((target("avx2")))
+    void bitwise_digits_AVX2(
+        digit *result,
+        digit const *first,
+        digit first_mask,
+        digit const *second,
+        digit second_mask,
+        size_t size,
+        char operation) noexcept
+    {
+        __m256i const first_masks = _mm256_set1_epi64x(static_cast<long long>(first_mask));
+        __m256i const second_masks = _mm256_set1_epi64x(static_cast<long long>(second_mask));
+        __m256i const conjunction = _mm256_set1_epi64x(static_cast<long long>(conjunction_mask(operation)));
+        __m256i const exclusive_disjunction = _mm256_set1_epi64x(static_cast<long long>(exclusive_disjunction_mask(operation)));
+
+        size_t i = 0;
+        for (; i + 4 <= size; i += 4)
+        {
+            __m256i const first_digits = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<__m256i const *>(first + i)), first_masks);
+            __m256i const second_digits = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<__m256i const *>(second + i)), second_masks);
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(result + i), _mm256_or_si256(
+                _mm256_and_si256(_mm256_and_si256(first_digits, second_digits), conjunction),
+                _mm256_and_si256(_mm256_xor_si256(first_digits, second_digits), exclusive_disjunction)));
+        }
+        bitwise_digits_scalar(result + i, first + i, first_mask, second + i, second_mask, size - i, operation);
+    }
+
+    __attribute__((target("avx512f")))
+    void bitwise_digits_AVX512(
+        digit *result,
+        digit const *first,
+        digit first_mask,
+        digit const *second,
+        digit second_mask,
+        size_t size,
+        char operation) noexcept
+    {
+        __m512i const first_masks = _mm512_set1_epi64(static_cast<long long>(first_mask));
+        __m512i const second_masks = _mm512_set1_epi64(static_cast<long long>(second_mask));
+        __m512i const conjunction = _mm512_set1_epi64(static_cast<long long>(conjunction_mask(operation)));
+        __m512i const exclusive_disjunction = _mm512_set1_epi64(static_cast<long long>(exclusive_disjunction_mask(operation)));
+
+        size_t i = 0;
+        for (; i + 8 <= size; i += 8)
+        {
+            __m512i const first_digits = _mm512_xor_si512(_mm512_loadu_si512(first + i), first_masks);
+            __m512i const second_digits = _mm512_xor_si512(_mm512_loadu_si512(second + i), second_masks);
+            _mm512_storeu_si512(result + i, _mm512_or_si512(
+                _mm512_and_si512(_mm512_and_si512(first_digits, second_digits), conjunction),
+                _mm512_and_si512(_mm512_xor_si512(first_digits, second_digits), exclusive_disjunction)));
+        }
+        bitwise_digits_scalar(result + i, first + i, first_mask, second + i, second_mask, size - i, operation);
+    }
+
+    // blocks go from the top down, each one loaded before it is stored, so result may alias first when result >= first
+    __attribute__((target("avx2")))
+    void shift_left_digits_AVX2(
+        digit *result,
+        digit const *first,
+        size_t size,
+        size_t shift) noexcept
+    {
+        __m128i const shift_count = _mm_cvtsi64_si128(static_cast<long long>(shift));
+        __m128i const carry_shift_count = _mm_cvtsi64_si128(static_cast<long long>(digit_bits - shift));
+
+        size_t i = size;
+        for (; i >= 5; i -= 4)
+        {
+            __m256i const digits = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(first + i - 4));
+            __m256i const lower_digits = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(first + i - 5));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(result + i - 4),
+                _mm256_or_si256(_mm256_sll_epi64(digits, shift_count), _mm256_srl_epi64(lower_digits, carry_shift_count)));
+        }
+        shift_left_digits_scalar(result, first, i, shift);
+    }
+
+    __attribute__((target("avx512f")))
+    void shift_left_digits_AVX512(
+        digit *result,
+        digit const *first,
+        size_t size,
+        size_t shift) noexcept
+    {
+        __m128i const shift_count = _mm_cvtsi64_si128(static_cast<long long>(shift));
+        __m128i const carry_shift_count = _mm_cvtsi64_si128(static_cast<long long>(digit_bits - shift));
+        // the zero masking forms, as the unmasked ones merge into undefined registers GCC warns about
+        __mmask8 const all_lanes = 0xFF;
+
+        size_t i = size;
+        for (; i >= 9; i -= 8)
+        {
+            __m512i const digits = _mm512_loadu_si512(first + i - 8);
+            __m512i const lower_digits = _mm512_loadu_si512(first + i - 9);
+            _mm512_storeu_si512(result + i - 8,
+                _mm512_or_si512(_mm512_maskz_sll_epi64(all_lanes, digits, shift_count), _mm512_maskz_srl_epi64(all_lanes, lower_digits, carry_shift_count)));
+        }
+        shift_left_digits_scalar(result, first, i, shift);
+    }
+
+    // blocks go from the bottom up, each one loaded before it is stored, so result may alias first when result <= first
+    __attribute__((target("avx2")))
+    void shift_right_digits_AVX2(
+        digit *result,
+        digit const *first,
+        size_t size,
+        size_t shift) noexcept
+    {
+        __m128i const shift_count = _mm_cvtsi64_si128(static_cast<long long>(shift));
+        __m128i const carry_shift_count = _mm_cvtsi64_si128(static_cast<long long>(digit_bits - shift));
+
+        size_t i = 0;
+        for (; i + 5 <= size; i += 4)
+        {
+            __m256i const digits = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(first + i));
+            __m256i const higher_digits = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(first + i + 1));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(result + i),
+                _mm256_or_si256(_mm256_srl_epi64(digits, shift_count), _mm256_sll_epi64(higher_digits, carry_shift_count)));
+        }
+        shift_right_digits_scalar(result + i, first + i, size - i, shift);
+    }
+
+    __attribute__((target("avx512f")))
+    void shift_right_digits_AVX512(
+        digit *result,
+        digit const *first,
+        size_t size,
+        size_t shift) noexcept
+    {
+        __m128i const shift_count = _mm_cvtsi64_si128(static_cast<long long>(shift));
+        __m128i const carry_shift_count = _mm_cvtsi64_si128(static_cast<long long>(digit_bits - shift));
+        __mmask8 const all_lanes = 0xFF;
+
+        size_t i = 0;
+        for (; i + 9 <= size; i += 8)
+        {
+            __m512i const digits = _mm512_loadu_si512(first + i);
+            __m512i const higher_digits = _mm512_loadu_si512(first + i + 1);
+            _mm512_storeu_si512(result + i,
+                _mm512_or_si512(_mm512_maskz_srl_epi64(all_lanes, digits, shift_count), _mm512_maskz_sll_epi64(all_lanes, higher_digits, carry_shift_count)));
+        }
+        shift_right_digits_scalar(result + i, first + i, size - i, shift);
+    }
+
+#endif
+
+    void bitwise_digits(
+        digit *result,
+        digit const *first,
+        digit first_mask,
+        digit const *second,
+        digit second_mask,
+        size_t size,
+        char operation) noexcept
+    {
+        switch (get_vectorization_state().load(std::memory_order_relaxed))
+        {
+#if defined(MP_OS_ARTHMTC_BG_INTGR_X86_64) && defined(MP_OS_ARTHMTC_BG_INTGR_VECTORIZATION)
+            case big_integer::vectorization::AVX512:
+                bitwise_digits_AVX512(result, first, first_mask, second, second_mask, size, operation);
+                return;
+            case big_integer::vectorization::AVX2:
+                bitwise_digits_AVX2(result, first, first_mask, second, second_mask, size, operation);
+                return;
+#endif
+            default:
+                bitwise_digits_scalar(result, first, first_mask, second, second_mask, size, operation);
+                return;
+        }
+    }
+
+    // result = first ^ mask digit by digit, result may alias first
+    void mask_digits(
+        digit *result,
+        digit const *first,
+        digit mask,
+        size_t size) noexcept
+    {
+        bitwise_digits(result, first, mask, first, mask, size, '|');
+    }
+
+    // endregion vectorized digit kernels
+
+    // region digit array kernels
+
+    inline size_t normalized_size(
+        digit const *digits,
+        size_t size) noexcept
+    {
+        while (size != 0 && digits[size - 1] == 0)
+        {
+            --size;
+        }
+        return size;
+    }
+
+    // size if all the digits are zeros
+    inline size_t lowest_nonzero_digit(
+        digit const *digits,
+        size_t size) noexcept
+    {
+        size_t i = 0;
+        while (i < size && digits[i] == 0)
+        {
+            ++i;
+        }
+        return i;
+    }
+
+    int compare_digits(
+        digit const *first,
+        digit const *second,
+        size_t size) noexcept
+    {
+        for (size_t i = size; i-- > 0;)
+        {
+            if (first[i] != second[i])
+            {
+                return first[i] < second[i]
+                    ? -1
+                    : 1;
+            }
+        }
+        return 0;
+    }
+
+    // sizes must be normalized
+    int compare_digits(
+        digit const *first,
+        size_t first_size,
+        digit const *second,
+        size_t second_size) noexcept
+    {
+        if (first_size != second_size)
+        {
+            return first_size < second_size
+                ? -1
+                : 1;
+        }
+        return compare_digits(first, second, first_size);
+    }
+
+    digit add_digits(
+        digit *result,
+        digit const *first,
+        digit const *second,
+        size_t size) noexcept
+    {
+#ifdef MP_OS_ARTHMTC_BG_INTGR_X86_64
+        // a single add with carry chain, unrolled so the loop bookkeeping doesn't touch the carry flag too often
+        unsigned char carry = 0;
+        unsigned long long sum;
+        size_t i = 0;
+        for (; i + 4 <= size; i += 4)
+        {
+            carry = _addcarry_u64(carry, first[i], second[i], &sum);
+            result[i] = sum;
+            carry = _addcarry_u64(carry, first[i + 1], second[i + 1], &sum);
+            result[i + 1] = sum;
+            carry = _addcarry_u64(carry, first[i + 2], second[i + 2], &sum);
+            result[i + 2] = sum;
+            carry = _addcarry_u64(carry, first[i + 3], second[i + 3], &sum);
+            result[i + 3] = sum;
+        }
+        for (; i < size; ++i)
+        {
+            carry = _addcarry_u64(carry, first[i], second[i], &sum);
+            result[i] = sum;
+        }
+        return carry;
+#else
+        digit carry = 0;
+        for (size_t i = 0; i < size; ++i)
+        {
+            digit sum = first[i] + carry;
+            carry = sum < carry;
+            sum += second[i];
+            carry += sum < second[i];
+            result[i] = sum;
+        }
+        return carry;
+#endif
+    }
+
+    digit add_digit(
+        digit *result,
+        digit const *first,
+        size_t size,
+        digit second) noexcept
+    {
+        for (size_t i = 0; i < size; ++i)
+        {
+            digit const sum = first[i] + second;
+            second = sum < second;
+            result[i] = sum;
+        }
+        return second;
+    }
+
+    // first_size >= second_size, result has first_size digits and may alias first
+    digit add_digits(
+        digit *result,
+        digit const *first,
+        size_t first_size,
+        digit const *second,
+        size_t second_size) noexcept
+    {
+        digit const carry = add_digits(result, first, second, second_size);
+        return add_digit(result + second_size, first + second_size, first_size - second_size, carry);
+    }
+
+    digit subtract_digits(
+        digit *result,
+        digit const *first,
+        digit const *second,
+        size_t size) noexcept
+    {
+#ifdef MP_OS_ARTHMTC_BG_INTGR_X86_64
+        unsigned char borrow = 0;
+        unsigned long long difference;
+        size_t i = 0;
+        for (; i + 4 <= size; i += 4)
+        {
+            borrow = _subborrow_u64(borrow, first[i], second[i], &difference);
+            result[i] = difference;
+            borrow = _subborrow_u64(borrow, first[i + 1], second[i + 1], &difference);
+            result[i + 1] = difference;
+            borrow = _subborrow_u64(borrow, first[i + 2], second[i + 2], &difference);
+            result[i + 2] = difference;
+            borrow = _subborrow_u64(borrow, first[i + 3], second[i + 3], &difference);
+            result[i + 3] = difference;
+        }
+        for (; i < size; ++i)
+        {
+            borrow = _subborrow_u64(borrow, first[i], second[i], &difference);
+            result[i] = difference;
+        }
+        return borrow;
+#else
+        digit borrow = 0;
+        for (size_t i = 0; i < size; ++i)
+        {
+            digit const difference = first[i] - second[i];
+            digit const next_borrow = first[i] < second[i];
+            result[i] = difference - borrow;
+            borrow = next_borrow | (difference < borrow);
+        }
+        return borrow;
+#endif
+    }
+
+    digit subtract_digit(
+        digit *result,
+        digit const *first,
+        size_t size,
+        digit second) noexcept
+    {
+        for (size_t i = 0; i < size; ++i)
+        {
+            digit const value = first[i];
+            result[i] = value - second;
+            second = value < second;
+        }
+        return second;
+    }
+
+    // first_size >= second_size, result has first_size digits and may alias first
+    digit subtract_digits(
+        digit *result,
+        digit const *first,
+        size_t first_size,
+        digit const *second,
+        size_t second_size) noexcept
+    {
+        digit const borrow = subtract_digits(result, first, second, second_size);
+        return subtract_digit(result + second_size, first + second_size, first_size - second_size, borrow);
+    }
+
+    digit multiply_by_digit(
+        digit *result,
+        digit const *first,
+        size_t size,
+        digit second) noexcept
+    {
+        digit carry = 0;
+        for (size_t i = 0; i < size; ++i)
+        {
+            digit high;
+            digit low = multiply_digits(first[i], second, high);
+            low += carry;
+            high += low < carry;
+            result[i] = low;
+            carry = high;
+        }
+        return carry;
+    }
+
+    // result += first * second
+    digit add_multiplied_by_digit(
+        digit *result,
+        digit const *first,
+        size_t size,
+        digit second) noexcept
+    {
+        digit carry = 0;
+        for (size_t i = 0; i < size; ++i)
+        {
+            digit high;
+            digit low = multiply_digits(first[i], second, high);
+            low += carry;
+            high += low < carry;
+            low += result[i];
+            high += low < result[i];
+            result[i] = low;
+            carry = high;
+        }
+        return carry;
+    }
+
+    // result -= first * second
+    digit subtract_multiplied_by_digit(
+        digit *result,
+        digit const *first,
+        size_t size,
+        digit second) noexcept
+    {
+        digit borrow = 0;
+        for (size_t i = 0; i < size; ++i)
+        {
+            digit high;
+            digit low = multiply_digits(first[i], second, high);
+            low += borrow;
+            high += low < borrow;
+            digit const value = result[i];
+            result[i] = value - low;
+            borrow = high + (value < low);
+        }
+        return borrow;
+    }
+
+    // result gets first_size + second_size digits and must not alias the operands
+    void multiply_digits_basecase(
+        digit *result,
+        digit const *first,
+        size_t first_size,
+        digit const *second,
+        size_t second_size) noexcept
+    {
+        result[first_size] = multiply_by_digit(result, first, first_size, second[0]);
+        for (size_t i = 1; i < second_size; ++i)
+        {
+            result[first_size + i] = add_multiplied_by_digit(result + i, first, first_size, second[i]);
+        }
+    }
+
+    // 0 < shift < digit_bits; result may alias first when result >= first
+    digit shift_left_digits(
+        digit *result,
+        digit const *first,
+        size_t size,
+        size_t shift) noexcept
+    {
+        digit const shifted_out = first[size - 1] >> (digit_bits - shift);
+        switch (get_vectorization_state().load(std::memory_order_relaxed))
+        {
+#if defined(MP_OS_ARTHMTC_BG_INTGR_X86_64) && defined(MP_OS_ARTHMTC_BG_INTGR_VECTORIZATION)
+            case big_integer::vectorization::AVX512:
+                shift_left_digits_AVX512(result, first, size, shift);
+                break;
+            case big_integer::vectorization::AVX2:
+                shift_left_digits_AVX2(result, first, size, shift);
+                break;
+#endif
+            default:
+                shift_left_digits_scalar(result, first, size, shift);
+                break;
+        }
+        result[0] = first[0] << shift;
+        return shifted_out;
+    }
+
+    // 0 < shift < digit_bits; result may alias first when result <= first
+    digit shift_right_digits(
+        digit *result,
+        digit const *first,
+        size_t size,
+        size_t shift) noexcept
+    {
+        digit const shifted_out = first[0] << (digit_bits - shift);
+        switch (get_vectorization_state().load(std::memory_order_relaxed))
+        {
+#if defined(MP_OS_ARTHMTC_BG_INTGR_X86_64) && defined(MP_OS_ARTHMTC_BG_INTGR_VECTORIZATION)
+            case big_integer::vectorization::AVX512:
+                shift_right_digits_AVX512(result, first, size, shift);
+                break;
+            case big_integer::vectorization::AVX2:
+                shift_right_digits_AVX2(result, first, size, shift);
+                break;
+#endif
+            default:
+                shift_right_digits_scalar(result, first, size, shift);
+                break;
+        }
+        result[size - 1] = first[size - 1] >> shift;
+        return shifted_out;
+    }
+
+    // result gets 2 * size digits and must not alias digits; every cross product is computed once and doubled
+    void square_digits_basecase(
+        digit *result,
+        digit const *digits,
+        size_t size) noexcept
+    {
+        std::fill(result, result + 2 * size, 0);
+        for (size_t i = 0; i + 1 < size; ++i)
+        {
+            result[i + size] = add_multiplied_by_digit(result + 2 * i + 1, digits + i + 1, size - i - 1, digits[i]);
+        }
+        result[2 * size - 1] = shift_left_digits(result, result, 2 * size - 1, 1);
+
+        digit carry = 0;
+        for (size_t i = 0; i < size; ++i)
+        {
+            digit high;
+            digit const low = multiply_digits(digits[i], digits[i], high);
+
+            digit sum = result[2 * i] + low;
+            digit next_carry = sum < low;
+            sum += carry;
+            next_carry += sum < carry;
+            result[2 * i] = sum;
+
+            sum = result[2 * i + 1] + high;
+            carry = next_carry;
+            next_carry = sum < high;
+            sum += carry;
+            next_carry += sum < carry;
+            result[2 * i + 1] = sum;
+            carry = next_carry;
+        }
+    }
+
+    // quotient gets size digits and may be nullptr, returns the remainder
+    digit divide_by_digit(
+        digit *quotient,
+        digit const *dividend,
+        size_t size,
+        digit divisor) noexcept
+    {
+        digit remainder = 0;
+        if (quotient == nullptr)
+        {
+            for (size_t i = size; i-- > 0;)
+            {
+                divide_double_digit(remainder, dividend[i], divisor, remainder);
+            }
+            return remainder;
+        }
+
+        for (size_t i = size; i-- > 0;)
+        {
+            quotient[i] = divide_double_digit(remainder, dividend[i], divisor, remainder);
+        }
+        return remainder;
+    }
+
+    // Knuth's algorithm D: divisor is normalized (highest bit set) and has at least two digits,
+    // remainder has dividend_size + 1 digits and initially holds the (shifted) dividend,
+    // quotient gets dividend_size - divisor_size + 1 digits and may be nullptr
+    void divide_digits_basecase(
+        digit *quotient,
+        digit *remainder,
+        size_t dividend_size,
+        digit const *divisor,
+        size_t divisor_size) noexcept
+    {
+        digit const divisor_high = divisor[divisor_size - 1];
+        digit const divisor_next = divisor[divisor_size - 2];
+
+        for (size_t j = dividend_size - divisor_size + 1; j-- > 0;)
+        {
+            digit const remainder_high = remainder[j + divisor_size];
+            digit const remainder_next = remainder[j + divisor_size - 1];
+
+            digit quotient_digit;
+            digit quotient_remainder;
+            bool quotient_remainder_overflow = false;
+
+            if (remainder_high >= divisor_high)
+            {
+                quotient_digit = ~digit(0);
+                quotient_remainder = remainder_next + divisor_high;
+                quotient_remainder_overflow = quotient_remainder < remainder_next;
+            }
+            else
+            {
+                quotient_digit = divide_double_digit(remainder_high, remainder_next, divisor_high, quotient_remainder);
+            }
+
+            while (!quotient_remainder_overflow)
+            {
+                digit product_high;
+                digit const product_low = multiply_digits(quotient_digit, divisor_next, product_high);
+                if (product_high < quotient_remainder
+                    || (product_high == quotient_remainder && product_low <= remainder[j + divisor_size - 2]))
+                {
+                    break;
+                }
+
+                --quotient_digit;
+                quotient_remainder += divisor_high;
+                quotient_remainder_overflow = quotient_remainder < divisor_high;
+            }
+
+            digit const borrow = subtract_multiplied_by_digit(remainder + j, divisor, divisor_size, quotient_digit);
+            digit const top = remainder[j + divisor_size];
+            remainder[j + divisor_size] = top - borrow;
+
+            if (top < borrow)
+            {
+                --quotient_digit;
+                remainder[j + divisor_size] += add_digits(remainder + j, remainder + j, divisor, divisor_size);
+            }
+
+            if (quotient != nullptr)
+            {
+                quotient[j] = quotient_digit;
+            }
+        }
+    }
+
+    // endregion digit array kernels
+
+    // region magnitudes
+
+    // scratch digits that stay on the stack while they are few
+    class digits_buffer final
+    {
+
+    private:
+
+        static size_t const inline_size = 8;
+
+    private:
+
+        digit _inline_digits[inline_size];
+
+        magnitude _heap_digits;
+
+        digit *_digits;
+
+    public:
+
+        explicit digits_buffer(
+            size_t size):
+                _digits(_inline_digits)
+        {
+            if (size > inline_size)
+            {
+                _heap_digits.resize(size);
+                _digits = _heap_digits.data();
+            }
+        }
+
+        digits_buffer(
+            digits_buffer const &other) = delete;
+
+        digits_buffer &operator=(
+            digits_buffer const &other) = delete;
+
+    public:
+
+        digit *data() noexcept
+        {
+            return _digits;
+        }
+
+    };
+
+    void normalize(
+        magnitude &value) noexcept
+    {
+        value.resize(normalized_size(value.data(), value.size()));
+    }
+
+    magnitude make_magnitude(
+        digit const *digits,
+        size_t size)
+    {
+        size = normalized_size(digits, size);
+        return magnitude(digits, digits + size);
+    }
+
+    int compare(
+        magnitude const &first,
+        magnitude const &second) noexcept
+    {
+        return compare_digits(first.data(), first.size(), second.data(), second.size());
+    }
+
+    magnitude add(
+        magnitude const &first,
+        magnitude const &second)
+    {
+        if (first.size() < second.size())
+        {
+            return add(second, first);
+        }
+
+        magnitude result(first.size() + 1);
+        result[first.size()] = add_digits(result.data(), first.data(), first.size(), second.data(), second.size());
+        normalize(result);
+        return result;
+    }
+
+    // first >= second
+    magnitude subtract(
+        magnitude const &first,
+        magnitude const &second)
+    {
+        magnitude result(first.size());
+        subtract_digits(result.data(), first.data(), first.size(), second.data(), second.size());
+        normalize(result);
+        return result;
+    }
+
+    magnitude shift_left_by_digits(
+        magnitude const &value,
+        size_t digits_count)
+    {
+        if (value.empty())
+        {
+            return value;
+        }
+
+        magnitude result(digits_count, 0);
+        result.insert(result.end(), value.begin(), value.end());
+        return result;
+    }
+
+    magnitude shift_left(
+        magnitude const &value,
+        size_t shift)
+    {
+        if (value.empty())
+        {
+            return value;
+        }
+
+        size_t const digits_shift = shift / digit_bits;
+        size_t const bits_shift = shift % digit_bits;
+
+        if (bits_shift == 0)
+        {
+            return shift_left_by_digits(value, digits_shift);
+        }
+
+        magnitude result(value.size() + digits_shift + 1, 0);
+        result[value.size() + digits_shift] = shift_left_digits(result.data() + digits_shift, value.data(), value.size(), bits_shift);
+        normalize(result);
+        return result;
+    }
+
+    magnitude shift_right(
+        magnitude const &value,
+        size_t shift)
+    {
+        size_t const digits_shift = shift / digit_bits;
+        size_t const bits_shift = shift % digit_bits;
+        if (digits_shift >= value.size())
+        {
+            return magnitude();
+        }
+
+        magnitude result(value.begin() + static_cast<std::ptrdiff_t>(digits_shift), value.end());
+        if (bits_shift != 0)
+        {
+            shift_right_digits(result.data(), result.data(), result.size(), bits_shift);
+        }
+        normalize(result);
+        return result;
+    }
+
+    size_t bit_length(
+        magnitude const &value) noexcept
+    {
+        return value.empty()
+            ? 0
+            : value.size() * digit_bits - leading_zero_bits(value.back());
+    }
+
+    // digits [from, from + count) of value
+    magnitude digits_range(
+        magnitude const &value,
+        size_t from,
+        size_t count)
+    {
+        if (from >= value.size())
+        {
+            return magnitude();
+        }
+        return make_magnitude(value.data() + from, std::min(count, value.size() - from));
+    }
+
+    // endregion magnitudes
+
+    // region multiplication algorithms
+
+    // result gets exactly first_size + second_size digits and must not alias the operands
+    using digits_multiplication = void (*)(digit *, digit const *, size_t, digit const *, size_t);
+
+    void multiply_digits_Karatsuba(
+        digit *result,
+        digit const *first,
+        size_t first_size,
+        digit const *second,
+        size_t second_size);
+
+    void multiply_digits_Toom_Cook_3(
+        digit *result,
+        digit const *first,
+        size_t first_size,
+        digit const *second,
+        size_t second_size);
+
+    void multiply_digits_Schonhage_Strassen(
+        digit *result,
+        digit const *first,
+        size_t first_size,
+        digit const *second,
+        size_t second_size);
+
+    void multiply_digits_automatic_pointwise(
+        digit *result,
+        digit const *first,
+        size_t first_size,
+        digit const *second,
+        size_t second_size);
+
+    std::atomic<size_t> automatic_Karatsuba_threshold(default_automatic_Karatsuba_threshold);
+    std::atomic<size_t> automatic_Toom_Cook_3_threshold(default_automatic_Toom_Cook_3_threshold);
+    std::atomic<size_t> automatic_Toom_Cook_4_threshold(default_automatic_Toom_Cook_4_threshold);
+    std::atomic<size_t> automatic_Schonhage_Strassen_threshold(default_automatic_Schonhage_Strassen_threshold);
+    std::atomic<size_t> automatic_NTT_threshold(default_automatic_NTT_threshold);
+
+    std::atomic<size_t> multiplication_threads_count(std::max<size_t>(1, std::thread::hardware_concurrency()));
+    std::atomic<size_t> parallel_multiplication_threshold(default_parallel_multiplication_threshold);
+
+    std::mutex multiplication_pool_mutex;
+    // replaced when the threads count changes, multiplications running on the former pool keep it alive
+    std::shared_ptr<work_stealing_thread_pool> multiplication_pool;
+
+    // the pool to split a product whose shorter operand has size digits over, nullptr if it stays serial
+    std::shared_ptr<work_stealing_thread_pool> get_multiplication_pool(
+        size_t size)
+    {
+        size_t const threads_count = multiplication_threads_count.load(std::memory_order_relaxed);
+        if (threads_count < 2 || size < parallel_multiplication_threshold.load(std::memory_order_relaxed))
+        {
+            return nullptr;
+        }
+
+        // sub-products running on a worker split further on its own pool, which outlives them
+        work_stealing_thread_pool *current_pool = work_stealing_thread_pool::get_current();
+        if (current_pool != nullptr)
+        {
+            return std::shared_ptr<work_stealing_thread_pool>(std::shared_ptr<work_stealing_thread_pool>(), current_pool);
+        }
+
+        std::lock_guard<std::mutex> lock(multiplication_pool_mutex);
+        if (multiplication_pool == nullptr || multiplication_pool->get_threads_count() != threads_count)
+        {
+            multiplication_pool = std::make_shared<work_stealing_thread_pool>(threads_count);
+        }
+        return multiplication_pool;
+    }
+
+    // calls products(i) for every i < count, on the pool's threads unless it is nullptr
+    template<
+        typename products_t>
+    void run_products(
+        work_stealing_thread_pool *pool,
+        size_t count,
+        products_t const &products)
+    {
+        if (pool == nullptr || count < 2)
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                products(i);
+            }
+            return;
+        }
+
+        std::vector<work_stealing_thread_pool::task> tasks;
+        tasks.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            tasks.emplace_back([&products, i]() { products(i); });
+        }
+        pool->run_all(tasks);
+    }
+
+    magnitude multiply(
+        magnitude const &first,
+        magnitude const &second,
+        digits_multiplication multiplication)
+    {
+        if (first.empty() || second.empty())
+        {
+            return magnitude();
+        }
+
+        magnitude result(first.size() + second.size());
+        multiplication(result.data(), first.data(), first.size(), second.data(), second.size());
+        normalize(result);
+        return result;
+    }
+
+    // both operands are the same digits
+    inline bool is_square(
+        digit const *first,
+        size_t first_size,
+        digit const *second,
+        size_t second_size) noexcept
+    {
+        return first == second && first_size == second_size;
+    }
+
+    // result gets exactly first_size + second_size digits and must not alias the operands
+    void multiply_digits_trivial(
+        digit *result,
+        digit const *first,
+        size_t first_size,
+        digit const *second,
+        size_t second_size) noexcept
+    {
+        size_t const result_size = first_size + second_size;
+        first_size = normalized_size(first, first_size);
+        second_size = normalized_size(second, second_size);
+
+        if (first_size == 0 || second_size == 0)
+        {
+            std::fill(result, result + result_size, 0);
+            return;
+        }
+
+        if (first_size < second_size)
+        {
+            std::swap(first, second);
+            std::swap(first_size, second_size);
+        }
+
+        if (is_square(first, first_size, second, second_size))
+        {
+            square_digits_basecase(result, first, first_size);
+        }
+        else
+        {
+            multiply_digits_basecase(result, first, first_size, second, second_size);
+        }
+        std::fill(result + first_size + second_size, result + result_size, 0);
+    }
+
+    // the steps below take normalized operands with first_size >= second_size > 0, fill exactly
+    // first_size + second_size digits of result and do their sub-products with multiplication;
+    // when both operands are the same digits the sub-products are passed on as squares too
+
+    // multiplies second by first's slices of second_size digits
+    void multiply_digits_unbalanced(
+        digit *result,
+        digit const *first,
+        size_t first_size,
+        digit const *second,
+        size_t second_size,
+        digits_multiplication multiplication)
+    {
+        std::fill(result, result + first_size + second_size, 0);
+
+        // parallel slices are multiplied all at once, serial ones one by one into the same digits
+        auto const pool = get_multiplication_pool(second_size);
+        size_t const slices_count = (first_size + second_size - 1) / second_size;
+        size_t const batch_size = pool == nullptr
+            ? 1
+            : slices_count;
+
+        magnitude partial_products(batch_size * 2 * second_size);
+        for (size_t batch = 0; batch < slices_count; batch += batch_size)
+        {
+            size_t const count = std::min(batch_size, slices_count - batch);
+            run_products(pool.get(), count, [&](size_t i)
+            {
+                size_t const offset = (batch + i) * second_size;
+                multiplication(partial_products.data() + i * 2 * second_size, first + offset, std::min(second_size, first_size - offset), second, second_size);
+            });
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                size_t const offset = (batch + i) * second_size;
+                size_t const slice_size = std::min(second_size, first_size - offset);
+                add_digits(result + offset, result + offset, first_size + second_size - offset, partial_products.data() + i * 2 * second_size, slice_size + second_size);
+            }
+        }
+    }
+
+    // requires second_size > (first_size + 1) / 2
+    void Karatsuba_step(
+        digit *result,
+        digit const *first,
+        size_t first_size,
+        digit const *second,
+        size_t second_size,
+        digits_multiplication multiplication)
+    {
+        size_t const low_size = (first_size + 1) / 2;
+        size_t const first_high_size = first_size - low_size;
+        size_t const second_high_size = second_size - low_size;
+
+        // z1 = (first_low + first_high) * (second_low + second_high) - z0 - z2
+        magnitude first_sum(low_size + 1);
+        first_sum[low_size] = add_digits(first_sum.data(), first, low_size, first + low_size, first_high_size);
+
+        magnitude second_sum;
+        if (!is_square(first, first_size, second, second_size))
+        {
+            second_sum.resize(low_size + 1);
+            second_sum[low_size] = add_digits(second_sum.data(), second, low_size, second + low_size, second_high_size);
+        }
+        magnitude const &second_factor = second_sum.empty()
+            ? first_sum
+            : second_sum;
+
+        // z0 = first_low * second_low, z2 = first_high * second_high written in place
+        magnitude middle(2 * low_size + 2);
+        run_products(get_multiplication_pool(second_size).get(), 3, [&](size_t product)
+        {
+            if (product == 0)
+            {
+                multiplication(result, first, low_size, second, low_size);
+            }
+            else if (product == 1)
+            {
+                multiplication(result + 2 * low_size, first + low_size, first_high_size, second + low_size, second_high_size);
+            }
+            else
+            {
+                multiplication(middle.data(), first_sum.data(), first_sum.size(), second_factor.data(), second_factor.size());
+            }
+        });
+
+        subtract_digits(middle.data(), middle.data(), middle.size(), result, 2 * low_size);
+        subtract_digits(middle.data(), middle.data(), middle.size(), result + 2 * low_size, first_high_size + second_high_size);
+
+        size_t const middle_size = normalized_size(middle.data(), middle.size());
+        add_digits(result + low_size, result + low_size, first_size + second_size - low_size, middle.data(), middle_size);
+    }
+
+    struct signed_magnitude final
+    {
+
+        magnitude value;
+
+        bool is_negative;
+
+    };
+
+    // first + second, or first - second if negate_second is set
+    signed_magnitude add(
+        signed_magnitude const &first,
+        signed_magnitude const &second,
+        bool negate_second)
+    {
+        bool const second_is_negative = second.is_negative != negate_second;
+        if (first.is_negative == second_is_negative)
+        {
+            return signed_magnitude{ add(first.value, second.value), first.is_negative };
+        }
+
+        return compare(first.value, second.value) >= 0
+            ? signed_magnitude{ subtract(first.value, second.value), first.is_negative }
+            : signed_magnitude{ subtract(second.value, first.value), second_is_negative };
+    }
+
+    // value must be a multiple of divisor
+    signed_magnitude divide_exactly(
+        signed_magnitude value,
+        digit divisor)
+    {
+        divide_by_digit(value.value.data(), value.value.data(), value.value.size(), divisor);
+        normalize(value.value);
+        return value;
+    }
+
+    signed_magnitude shift_left(
+        signed_magnitude const &value,
+        size_t shift)
+    {
+        return signed_magnitude{ shift_left(value.value, shift), value.is_negative };
+    }
+
+    // size is the shorter operand's one of the product being split
+    void multiply_pointwise(
+        signed_magnitude *products,
+        signed_magnitude const *first_values,
+        signed_magnitude const *second_values,
+        size_t count,
+        size_t size,
+        digits_multiplication multiplication)
+    {
+        run_products(get_multiplication_pool(size).get(), count, [&](size_t i)
+        {
+            products[i] = signed_magnitude{
+                multiply(first_values[i].value, second_values[i].value, multiplication),
+                first_values[i].is_negative != second_values[i].is_negative };
+        });
+    }
+
+    // result = sum of coefficients[i] * 2^(64 * piece_size * i), the sum must fit into result_size digits
+    void overlap_add(
+        digit *result,
+        size_t result_size,
+        signed_magnitude const *const *coefficients,
+        size_t count,
+        size_t piece_size)
+    {
+        std::fill(result, result + result_size, 0);
+        for (size_t i = 0; i < count; ++i)
+        {
+            size_t const offset = i * piece_size;
+            magnitude const &coefficient = coefficients[i]->value;
+            if (!coefficient.empty())
+            {
+                add_digits(result + offset, result + offset, result_size - offset, coefficient.data(), coefficient.size());
+            }
+        }
+    }
+
+    // values of the polynomial with pieces of piece_size digits as coefficients at 0, 1, -1, -2 and infinity
+    void Toom_Cook_3_evaluate(
+        digit const *digits,
+        size_t size,
+        size_t piece_size,
+        signed_magnitude *values)
+    {
+        magnitude const low = make_magnitude(digits, piece_size);
+        signed_magnitude const middle{ make_magnitude(digits + piece_size, piece_size), false };
+        signed_magnitude const high{ make_magnitude(digits + 2 * piece_size, size - 2 * piece_size), false };
+
+        // low + high serves both 1 and -1, -2 comes out as 2 * (v(-1) + high) - low
+        signed_magnitude const outer_sum{ add(low, high.value), false };
+        values[0] = signed_magnitude{ low, false };
+        values[1] = add(outer_sum, middle, false);
+        values[2] = add(outer_sum, middle, true);
+        values[3] = add(values[2], high, false);
+        values[3] = add(shift_left(values[3], 1), values[0], true);
+        values[4] = high;
+    }
+
+    // requires second_size > 2 * ceil(first_size / 3); Bodrato's interpolation sequence
+    void Toom_Cook_3_step(
+        digit *result,
+        digit const *first,
+        size_t first_size,
+        digit const *second,
+        size_t second_size,
+        digits_multiplication multiplication)
+    {
+        size_t const piece_size = (first_size + 2) / 3;
+
+        bool const squaring = is_square(first, first_size, second, second_size);
+
+        signed_magnitude first_values[5];
+        signed_magnitude second_values[5];
+        Toom_Cook_3_evaluate(first, first_size, piece_size, first_values);
+        if (!squaring)
+        {
+            Toom_Cook_3_evaluate(second, second_size, piece_size, second_values);
+        }
+
+        signed_magnitude products[5];
+        multiply_pointwise(products, first_values, squaring
+            ? first_values
+            : second_values, 5, second_size, multiplication);
+
+        signed_magnitude const &at_zero = products[0];
+        signed_magnitude const &at_minus_one = products[2];
+        signed_magnitude const &at_infinity = products[4];
+        signed_magnitude third = divide_exactly(add(products[3], products[1], true), 3);
+        signed_magnitude first_coefficient = divide_exactly(add(products[1], at_minus_one, true), 2);
+        signed_magnitude second_coefficient = add(at_minus_one, at_zero, true);
+        third = add(
+            divide_exactly(add(second_coefficient, third, true), 2),
+            shift_left(at_infinity, 1),
+            false);
+        second_coefficient = add(add(second_coefficient, first_coefficient, false), at_infinity, true);
+        first_coefficient = add(first_coefficient, third, true);
+
+        // the coefficients are nonnegative now
+        signed_magnitude const *coefficients[] = { &at_zero, &first_coefficient, &second_coefficient, &third, &at_infinity };
+        overlap_add(result, first_size + second_size, coefficients, 5, piece_size);
+    }
+
+    // values of the polynomial with pieces of piece_size digits as coefficients at 0, 1, -1, 2, -2,
+    // 1/2 (scaled by 8) and infinity
+    void Toom_Cook_4_evaluate(
+        digit const *digits,
+        size_t size,
+        size_t piece_size,
+        signed_magnitude *values)
+    {
+        signed_magnitude pieces[4];
+        for (size_t i = 0; i < 4; ++i)
+        {
+            pieces[i] = signed_magnitude{ make_magnitude(digits + i * piece_size, i == 3
+                ? size - 3 * piece_size
+                : piece_size), false };
+        }
+
+        signed_magnitude const even_sum = add(pieces[0], pieces[2], false);
+        signed_magnitude const odd_sum = add(pieces[1], pieces[3], false);
+        values[0] = pieces[0];
+        values[1] = add(even_sum, odd_sum, false);
+        values[2] = add(even_sum, odd_sum, true);
+
+        signed_magnitude const even_sum_at_two = add(pieces[0], shift_left(pieces[2], 2), false);
+        signed_magnitude const odd_sum_at_two = shift_left(add(pieces[1], shift_left(pieces[3], 2), false), 1);
+        values[3] = add(even_sum_at_two, odd_sum_at_two, false);
+        values[4] = add(even_sum_at_two, odd_sum_at_two, true);
+
+        // 8 * v(1/2) = ((2 * p0 + p1) * 2 + p2) * 2 + p3
+        values[5] = pieces[0];
+        for (size_t i = 1; i < 4; ++i)
+        {
+            values[5] = add(shift_left(values[5], 1), pieces[i], false);
+        }
+
+        values[6] = pieces[3];
+    }
+
+    // requires second_size > 3 * ceil(first_size / 4)
+    void Toom_Cook_4_step(
+        digit *result,
+        digit const *first,
+        size_t first_size,
+        digit const *second,
+        size_t second_size,
+        digits_multiplication multiplication)
+    {
+        size_t const piece_size = (first_size + 3) / 4;
+
+        bool const squaring = is_square(first, first_size, second, second_size);
+
+        signed_magnitude first_values[7];
+        signed_magnitude second_values[7];
+        Toom_Cook_4_evaluate(first, first_size, piece_size, first_values);
+        if (!squaring)
+        {
+            Toom_Cook_4_evaluate(second, second_size, piece_size, second_values);
+        }
+
+        signed_magnitude products[7];
+        multiply_pointwise(products, first_values, squaring
+            ? first_values
+            : second_values, 7, second_size, multiplication);
+
+        signed_magnitude const &at_zero = products[0];
+        signed_magnitude const &at_infinity = products[6];
+
+        // even coefficients: c2 + c4 and c2 + 4 * c4 from the values at +-1 and +-2
+        signed_magnitude const even_at_one = add(
+            add(divide_exactly(add(products[1], products[2], false), 2), at_zero, true),
+            at_infinity,
+            true);
+        signed_magnitude const even_at_two = divide_exactly(add(
+            add(divide_exactly(add(products[3], products[4], false), 2), at_zero, true),
+            shift_left(at_infinity, 6),
+            true), 4);
+        signed_magnitude const fourth = divide_exactly(add(even_at_two, even_at_one, true), 3);
+        signed_magnitude const second_coefficient = add(even_at_one, fourth, true);
+
+        // odd coefficients: c1 + c3 + c5, c1 + 4 * c3 + 16 * c5 and 16 * c1 + 4 * c3 + c5
+        signed_magnitude const odd_at_one = divide_exactly(add(products[1], products[2], true), 2);
+        signed_magnitude const odd_at_two = divide_exactly(add(products[3], products[4], true), 4);
+        signed_magnitude odd_at_half = add(products[5], shift_left(at_zero, 6), true);
+        odd_at_half = add(odd_at_half, shift_left(second_coefficient, 4), true);
+        odd_at_half = add(odd_at_half, shift_left(fourth, 2), true);
+        odd_at_half = divide_exactly(add(odd_at_half, at_infinity, true), 2);
+
+        // u = 3 * c3 + 15 * c5, v = -12 * c3 - 15 * c5
+        signed_magnitude const u = add(odd_at_two, odd_at_one, true);
+        signed_magnitude const v = add(odd_at_half, shift_left(odd_at_one, 4), true);
+        signed_magnitude third = divide_exactly(add(u, v, false), 9);
+        third.is_negative = !third.is_negative;
+        signed_magnitude const fifth = divide_exactly(add(divide_exactly(u, 3), third, true), 5);
+        signed_magnitude const first_coefficient = add(add(odd_at_one, third, true), fifth, true);
+
+        // the coefficients are nonnegative now
+        signed_magnitude const *coefficients[] = { &at_zero, &first_coefficient, &second_coefficient, &third, &fourth, &fifth, &at_infinity };
+        overlap_add(result, first_size + second_size, coefficients, 7, piece_size);
+    }
+
+    // result gets exactly first_size + second_size digits and must not alias the operands
+    void multiply_digits_Karatsuba(
+        digit *result,
+        digit const *first,
+        size_t first_size,
+        digit const *second,
+        size_t second_size)
+    {
+        size_t const result_size = first_size + second_size;
+        first_size = normalized_size(first, first_size);
+        second_size = normalized_size(second, second_size);
+
+        if (first_size < second_size)
+        {
+            std::swap(first, second);
+            std::swap(first_size, second_size);
+        }
+
+        std::fill(result + first_size + second_size, result + result_size, 0);
+
+        if (second_size < Karatsuba_threshold)
+        {
+            multiply_digits_trivial(result, first, first_size, second, second_size);
+        }
+        else if (second_size <= (first_size + 1) / 2)
+        {
+            multiply_digits_unbalanced(result, first, first_size, second, second_size, multiply_digits_Karatsuba);
+        }
+        else
+        {
+            Karatsuba_step(result, first, first_size, second, second_size, multiply_digits_Karatsuba);
+        }
+    }
+
+    // result gets exactly first_size + second_size digits and must not alias the operands
+    void multiply_digits_Toom_Cook_3(
+        digit *result,
+        digit const *first,
+        size_t first_size,
+        digit const *second,
+        size_t second_size)
+    {
+        size_t const result_size = first_size + second_size;
+        first_size = normalized_size(first, first_size);
+        second_size = normalized_size(second, second_size);
+
+        if (first_size < second_size)
+        {
+            std::swap(first, second);
+            std::swap(first_size, second_size);
+        }
+
+        std::fill(result + first_size + second_size, result + result_size, 0);
+
+        if (second_size < Toom_Cook_3_threshold)
+        {
+            multiply_digits_Karatsuba(result, first, first_size, second, second_size);
+        }
+        else if (second_size <= (first_size + 1) / 2)
+        {
+            multiply_digits_unbalanced(result, first, first_size, second, second_size, multiply_digits_Toom_Cook_3);
+        }
+        else if (second_size > 2 * ((first_size + 2) / 3))
+        {
+            Toom_Cook_3_step(result, first, first_size, second, second_size, multiply_digits_Toom_Cook_3);
+        }
+        else
+        {
+            Karatsuba_step(result, first, first_size, second, second_size, multiply_digits_Toom_Cook_3);
+        }
+    }
+
+    // result gets exactly first_size + second_size digits and must not alias the operands
+    void multiply_digits_Toom_Cook_4(
+        digit *result,
+        digit const *first,
+        size_t first_size,
+        digit const *second,
+        size_t second_size)
+    {
+        size_t const result_size = first_size + second_size;
+        first_size = normalized_size(first, first_size);
+        second_size = normalized_size(second, second_size);
+
+        if (first_size < second_size)
+        {
+            std::swap(first, second);
+            std::swap(first_size, second_size);
+        }
+
+        std::fill(result + first_size + second_size, result + result_size, 0);
+
+        if (second_size < Toom_Cook_4_threshold)
+        {
+            multiply_digits_Toom_Cook_3(result, first, first_size, second, second_size);
+        }
+        else if (second_size <= (first_size + 1) / 2)
+        {
+            multiply_digits_unbalanced(result, first, first_size, second, second_size, multiply_digits_Toom_Cook_4);
+        }
+        else if (second_size > 3 * ((first_size + 3) / 4))
+        {
+            Toom_Cook_4_step(result, first, first_size, second, second_size, multiply_digits_Toom_Cook_4);
+        }
+        else if (second_size > 2 * ((first_size + 2) / 3))
+        {
+            Toom_Cook_3_step(result, first, first_size, second, second_size, multiply_digits_Toom_Cook_4);
+        }
+        else
+        {
+            Karatsuba_step(result, first, first_size, second, second_size, multiply_digits_Toom_Cook_4);
+        }
+    }
+
+    // arithmetic modulo 2^(64 * ring_size) + 1, elements take ring_size + 1 digits
+    class Schonhage_Strassen_ring final
+    {
+
+    private:
+
+        size_t const _size;
+
+        digits_multiplication const _multiplication;
+
+        magnitude _product;
+
+        magnitude _shifted;
+
+        magnitude _low;
+
+        magnitude _high;
+
+    public:
+
+        Schonhage_Strassen_ring(
+            size_t size,
+            digits_multiplication multiplication):
+                _size(size),
+                _multiplication(multiplication),
+                _product(2 * size + 2),
+                _shifted(2 * size + 2),
+                _low(size + 1),
+                _high(size + 1)
+        {
+
+        }
+
+    public:
+
+        // element[size] may hold a small value t, folds it as element - t
+        void fold_top(
+            digit *element) const noexcept
+        {
+            digit const top = element[_size];
+            element[_size] = 0;
+            if (subtract_digit(element, element, _size, top) != 0)
+            {
+                element[_size] = add_digit(element, element, _size, 1);
+            }
+        }
+
+        void add(
+            digit *result,
+            digit const *first,
+            digit const *second) const noexcept
+        {
+            add_digits(result, first, second, _size + 1);
+            fold_top(result);
+        }
+
+        void subtract(
+            digit *result,
+            digit const *first,
+            digit const *second) const noexcept
+        {
+            if (subtract_digits(result, first, second, _size + 1) != 0)
+            {
+                // wrapped around 2^(64 * (size + 1)): add the modulus back
+                add_digit(result, result, _size + 1, 1);
+                result[_size] += 1;
+            }
+        }
+
+        // result = element * 2^shift, 0 <= shift < 2 * 64 * size; result must not alias element
+        void multiply_by_power_of_two(
+            digit *result,
+            digit const *element,
+            size_t shift) noexcept
+        {
+            bool const negate = shift >= _size * digit_bits;
+            if (negate)
+            {
+                shift -= _size * digit_bits;
+            }
+
+            size_t const digits_shift = shift / digit_bits;
+            size_t const bits_shift = shift % digit_bits;
+
+            std::fill(_shifted.begin(), _shifted.end(), 0);
+            if (bits_shift == 0)
+            {
+                std::copy(element, element + _size + 1, _shifted.begin() + static_cast<std::ptrdiff_t>(digits_shift));
+            }
+            else
+            {
+                _shifted[digits_shift + _size + 1] = shift_left_digits(_shifted.data() + digits_shift, element, _size + 1, bits_shift);
+            }
+
+            reduce(result, _shifted.data());
+            if (negate)
+            {
+                negate_in_place(result);
+            }
+        }
+
+        void multiply(
+            digit *result,
+            digit const *first,
+            digit const *second)
+        {
+            _multiplication(_product.data(), first, _size + 1, second, _size + 1);
+            reduce(result, _product.data());
+        }
+
+    private:
+
+        void negate_in_place(
+            digit *element) noexcept
+        {
+            std::fill(_low.begin(), _low.end(), 0);
+            std::copy(element, element + _size + 1, _high.begin());
+            subtract(element, _low.data(), _high.data());
+        }
+
+        // result = value mod (2^(64 * size) + 1) for value of 2 * size + 2 digits below 2^(64 * (2 * size + 1))
+        void reduce(
+            digit *result,
+            digit const *value) noexcept
+        {
+            // value = low + high * 2^(64 * size) == low - high
+            std::copy(value, value + _size, _low.begin());
+            _low[_size] = 0;
+            std::copy(value + _size, value + 2 * _size + 1, _high.begin());
+            fold_top(_high.data());
+            subtract(result, _low.data(), _high.data());
+        }
+
+    };
+
+    struct Schonhage_Strassen_parameters final
+    {
+
+        size_t log_pieces_count;
+
+        size_t pieces_count;
+
+        size_t piece_size;
+
+        size_t ring_size;
+
+    };
+
+    Schonhage_Strassen_parameters choose_Schonhage_Strassen_parameters(
+        size_t first_size,
+        size_t second_size) noexcept
+    {
+        size_t const result_size = first_size + second_size;
+
+        size_t result_size_bits = 0;
+        while ((size_t(1) << result_size_bits) < result_size)
+        {
+            ++result_size_bits;
+        }
+
+        Schonhage_Strassen_parameters parameters{};
+        parameters.log_pieces_count = std::max<size_t>(2, result_size_bits / 2 + 1);
+        parameters.pieces_count = size_t(1) << parameters.log_pieces_count;
+        parameters.piece_size = (result_size + parameters.pieces_count - 1) / parameters.pieces_count;
+        while ((first_size + parameters.piece_size - 1) / parameters.piece_size
+            + (second_size + parameters.piece_size - 1) / parameters.piece_size - 1 > parameters.pieces_count)
+        {
+            ++parameters.piece_size;
+        }
+
+        // coefficients of the product need 2 * 64 * piece_size + log_pieces_count bits,
+        // and 2^(2 * 64 * ring_size / pieces_count) must be a root of unity of order pieces_count
+        size_t const ring_size_granularity = std::max<size_t>(1, parameters.pieces_count / (2 * digit_bits));
+        parameters.ring_size = 2 * parameters.piece_size + 1;
+        parameters.ring_size = (parameters.ring_size + ring_size_granularity - 1) / ring_size_granularity * ring_size_granularity;
+
+        return parameters;
+    }
+
+    void Schonhage_Strassen_transform(
+        Schonhage_Strassen_ring &ring,
+        magnitude &elements,
+        Schonhage_Strassen_parameters const &parameters,
+        bool inverse)
+    {
+        size_t const element_size = parameters.ring_size + 1;
+        size_t const pieces_count = parameters.pieces_count;
+        size_t const full_turn = 2 * digit_bits * parameters.ring_size;
+        size_t const root_shift = full_turn / pieces_count;
+
+        magnitude sum(element_size);
+        magnitude difference(element_size);
+
+        auto element = [&elements, element_size](size_t index) { return elements.data() + index * element_size; };
+
+        if (!inverse)
+        {
+            // decimation in frequency: natural order in, bit-reversed order out
+            for (size_t half = pieces_count / 2; half > 0; half /= 2)
+            {
+                size_t const twiddle_step = root_shift * (pieces_count / (2 * half));
+                for (size_t block = 0; block < pieces_count; block += 2 * half)
+                {
+                    for (size_t j = 0; j < half; ++j)
+                    {
+                        digit *first = element(block + j);
+                        digit *second = element(block + j + half);
+
+                        ring.add(sum.data(), first, second);
+                        ring.subtract(difference.data(), first, second);
+
+                        std::copy(sum.begin(), sum.end(), first);
+                        ring.multiply_by_power_of_two(second, difference.data(), j * twiddle_step);
+                    }
+                }
+            }
+            return;
+        }
+
+        // decimation in time with inverse roots: bit-reversed order in, natural order out
+        magnitude twiddled(element_size);
+        for (size_t half = 1; half < pieces_count; half *= 2)
+        {
+            size_t const twiddle_step = root_shift * (pieces_count / (2 * half));
+            for (size_t block = 0; block < pieces_count; block += 2 * half)
+            {
+                for (size_t j = 0; j < half; ++j)
+                {
+                    digit *first = element(block + j);
+                    digit *second = element(block + j + half);
+
+                    size_t const shift = j * twiddle_step;
+                    ring.multiply_by_power_of_two(twiddled.data(), second, shift == 0
+                        ? 0
+                        : full_turn - shift);
+
+                    ring.add(sum.data(), first, twiddled.data());
+                    ring.subtract(second, first, twiddled.data());
+                    std::copy(sum.begin(), sum.end(), first);
+                }
+            }
+        }
+
+        // divide by pieces_count
+        for (size_t i = 0; i < pieces_count; ++i)
+        {
+            std::copy(element(i), element(i) + element_size, twiddled.begin());
+            ring.multiply_by_power_of_two(element(i), twiddled.data(), full_turn - parameters.log_pieces_count);
+        }
+    }
+
+    // normalized operands of at least two digits each, pointwise products go through multiplication;
+    // result gets exactly first_size + second_size digits
+    void Schonhage_Strassen_step(
+        digit *result,
+        digit const *first,
+        size_t first_size,
+        digit const *second,
+        size_t second_size,
+        digits_multiplication multiplication)
+    {
+        auto const parameters = choose_Schonhage_Strassen_parameters(first_size, second_size);
+        size_t const element_size = parameters.ring_size + 1;
+        bool const squaring = is_square(first, first_size, second, second_size);
+
+        magnitude first_elements(parameters.pieces_count * element_size, 0);
+        magnitude second_elements(squaring
+            ? 0
+            : parameters.pieces_count * element_size, 0);
+        for (size_t offset = 0, index = 0; offset < first_size; offset += parameters.piece_size, ++index)
+        {
+            std::copy(first + offset, first + std::min(first_size, offset + parameters.piece_size), first_elements.begin() + static_cast<std::ptrdiff_t>(index * element_size));
+        }
+        for (size_t offset = 0, index = 0; !squaring && offset < second_size; offset += parameters.piece_size, ++index)
+        {
+            std::copy(second + offset, second + std::min(second_size, offset + parameters.piece_size), second_elements.begin() + static_cast<std::ptrdiff_t>(index * element_size));
+        }
+
+        Schonhage_Strassen_ring ring(parameters.ring_size, multiplication);
+        Schonhage_Strassen_transform(ring, first_elements, parameters, false);
+        if (!squaring)
+        {
+            Schonhage_Strassen_transform(ring, second_elements, parameters, false);
+        }
+
+        // squares multiply every transformed element by itself
+        magnitude const &second_transformed = squaring
+            ? first_elements
+            : second_elements;
+        magnitude pointwise_product(element_size);
+        for (size_t i = 0; i < parameters.pieces_count; ++i)
+        {
+            digit *first_element = first_elements.data() + i * element_size;
+            ring.multiply(pointwise_product.data(), first_element, second_transformed.data() + i * element_size);
+            std::copy(pointwise_product.begin(), pointwise_product.end(), first_element);
+        }
+
+        Schonhage_Strassen_transform(ring, first_elements, parameters, true);
+
+        // coefficients are exact, overlap-add them
+        size_t const product_size = first_size + second_size;
+        std::fill(result, result + product_size, 0);
+        for (size_t i = 0; i < parameters.pieces_count; ++i)
+        {
+            size_t const offset = i * parameters.piece_size;
+            if (offset >= product_size)
+            {
+                break;
+            }
+
+            digit const *coefficient = first_elements.data() + i * element_size;
+            size_t const coefficient_size = std::min(normalized_size(coefficient, element_size), product_size - offset);
+            if (coefficient_size != 0)
+            {
+                add_digits(result + offset, result + offset, product_size - offset, coefficient, coefficient_size);
+            }
+        }
+    }
+
+    // pointwise products recurse into Schonhage-Strassen once the ring is large enough
+    void multiply_digits_Schonhage_Strassen_pointwise(
+        digit *result,
+        digit const *first,
+        size_t first_size,
+        digit const *second,
+        size_t second_size)
+    {
+        if (first_size <= Schonhage_Strassen_recursion_threshold)
+        {
+            multiply_digits_Karatsuba(result, first, first_size, second, second_size);
+        }
+        else
+        {
+            multiply_digits_Schonhage_Strassen(result, first, first_size, second, second_size);
+        }
+    }
+
+    // result gets exactly first_size + second_size digits and must not alias the operands
+    void multiply_digits_Schonhage_Strassen(
+        digit *result,
+        digit const *first,
+        size_t first_size,
+        digit const *second,
+        size_t second_size)
+    {
+        size_t const result_size = first_size + second_size;
+        first_size = normalized_size(first, first_size);
+        second_size = normalized_size(second, second_size);
+
+        if (first_size < 2 || second_size < 2 || first_size + second_size <= 2 * Karatsuba_threshold)
+        {
+            multiply_digits_Karatsuba(result, first, first_size, second, second_size);
+            std::fill(result + first_size + second_size, result + result_size, 0);
+            return;
+        }
+
+        Schonhage_Strassen_step(result, first, first_size, second, second_size, multiply_digits_Schonhage_Strassen_pointwise);
+        std::fill(result + first_size + second_size, result + result_size, 0);
+    }
+
+    // arithmetic modulo a prime below 2^62; values to multiply by are kept in Montgomery form (times 2^64)
+    class NTT_prime final
+    {
+
+    public:
+
+        digit const modulus;
+
+        // modulus * negated_inverse == -1 mod 2^64
+        digit const negated_inverse;
+
+        // 2^64 mod modulus, the Montgomery form of one
+        digit const one;
+
+        // 2^128 mod modulus
+        digit const one_squared;
+
+        // generates the multiplicative group
+        digit const primitive_root;
+
+    public:
+
+        NTT_prime(
+            digit modulus,
+            digit primitive_root) noexcept:
+                modulus(modulus),
+                negated_inverse(compute_negated_inverse(modulus)),
+                one((0 - modulus) % modulus),
+                one_squared(multiply_slowly(one, one, modulus)),
+                primitive_root(primitive_root)
+        {
+
+        }
+
+    public:
+
+        digit add(
+            digit first,
+            digit second) const noexcept
+        {
+            digit const sum = first + second;
+            return sum >= modulus
+                ? sum - modulus
+                : sum;
+        }
+
+        digit subtract(
+            digit first,
+            digit second) const noexcept
+        {
+            return first >= second
+                ? first - second
+                : first + modulus - second;
+        }
+
+        // first * second / 2^64; a Montgomery form operand makes it an ordinary product
+        digit multiply(
+            digit first,
+            digit second) const noexcept
+        {
+            digit high;
+            digit const low = multiply_digits(first, second, high);
+
+            digit reduction_high;
+            multiply_digits(low * negated_inverse, modulus, reduction_high);
+            // the low halves sum up to 0 mod 2^64 and carry out unless both are zero
+            digit const result = high + reduction_high + (low != 0);
+            return result >= modulus
+                ? result - modulus
+                : result;
+        }
+
+        digit to_Montgomery_form(
+            digit value) const noexcept
+        {
+            return multiply(value % modulus, one_squared);
+        }
+
+        // value^exponent for value and result in Montgomery form
+        digit power(
+            digit value,
+            digit exponent) const noexcept
+        {
+            digit result = one;
+            for (; exponent != 0; exponent >>= 1)
+            {
+                if (exponent & 1)
+                {
+                    result = multiply(result, value);
+                }
+                value = multiply(value, value);
+            }
+            return result;
+        }
+
+    private:
+
+        static digit compute_negated_inverse(
+            digit modulus) noexcept
+        {
+            // Newton's iteration doubles the count of correct low bits, starting from 3
+            digit inverse = modulus;
+            for (size_t i = 0; i < 5; ++i)
+            {
+                inverse *= 2 - modulus * inverse;
+            }
+            return 0 - inverse;
+        }
+
+        static digit multiply_slowly(
+            digit first,
+            digit second,
+            digit modulus) noexcept
+        {
+            digit high;
+            digit const low = multiply_digits(first, second, high);
+            digit remainder;
+            divide_double_digit(high, low, modulus, remainder);
+            return remainder;
+        }
+
+    };
+
+    size_t const NTT_primes_count = 3;
+
+    // transforms of up to 2^54 values; the product of the primes exceeds 2^184, enough for
+    // convolutions of 64-bit digits
+    size_t const NTT_max_log_size = 54;
+
+    NTT_prime const &get_NTT_prime(
+        size_t index) noexcept
+    {
+        static NTT_prime const primes[NTT_primes_count] =
+        {
+            NTT_prime(29ULL * (1ULL << 57) + 1, 3),
+            NTT_prime(69ULL * (1ULL << 55) + 1, 5),
+            NTT_prime(163ULL * (1ULL << 54) + 1, 3)
+        };
+
+        return primes[index];
+    }
+
+    // powers of a root of unity of order 2^log_size modulo every prime, in Montgomery form
+    struct NTT_twiddles final
+    {
+
+        // roots[prime][j] = w^j for j < 2^(log_size - 1); w^-j == -w^(2^(log_size - 1) - j)
+        magnitude roots[NTT_primes_count];
+
+        // 2^-log_size * 2^128, undoes both the transform scaling and the pointwise Montgomery factor
+        digit scale[NTT_primes_count];
+
+    };
+
+    std::shared_ptr<NTT_twiddles const> get_NTT_twiddles(
+        size_t log_size)
+    {
+        static std::mutex cache_mutex;
+        static std::shared_ptr<NTT_twiddles const> cache[NTT_max_log_size + 1];
+
+        std::lock_guard<std::mutex> lock(cache_mutex);
+        if (cache[log_size] != nullptr)
+        {
+            return cache[log_size];
+        }
+
+        auto twiddles = std::make_shared<NTT_twiddles>();
+        size_t const half_size = (size_t(1) << log_size) / 2;
+        for (size_t i = 0; i < NTT_primes_count; ++i)
+        {
+            NTT_prime const &prime = get_NTT_prime(i);
+            digit const root = prime.power(prime.to_Montgomery_form(prime.primitive_root), (prime.modulus - 1) >> log_size);
+
+            magnitude &roots = twiddles->roots[i];
+            roots.resize(std::max<size_t>(1, half_size));
+            roots[0] = prime.one;
+            for (size_t j = 1; j < half_size; ++j)
+            {
+                roots[j] = prime.multiply(roots[j - 1], root);
+            }
+
+            // Montgomery form of 2^-log_size * 2^64, multiplied by 2^64 once more
+            digit const size_inverse = prime.power(prime.to_Montgomery_form(digit(1) << log_size), prime.modulus - 2);
+            twiddles->scale[i] = prime.multiply(size_inverse, prime.one_squared);
+        }
+
+        cache[log_size] = twiddles;
+        return cache[log_size];
+    }
+
+    // butterflies begin..end - 1 of the decimation in frequency stage combining values[j] and values[j + half]
+    void NTT_forward_butterflies(
+        digit *values,
+        size_t half,
+        size_t root_stride,
+        NTT_prime const &prime,
+        magnitude const &roots,
+        size_t begin,
+        size_t end) noexcept
+    {
+        digit *second = values + half;
+        for (size_t j = begin; j < end; ++j)
+        {
+            digit const sum = prime.add(values[j], second[j]);
+            second[j] = prime.multiply(prime.subtract(values[j], second[j]), roots[j * root_stride]);
+            values[j] = sum;
+        }
+    }
+
+    // butterflies begin..end - 1 of the decimation in time stage combining values[j] and values[j + half]
+    void NTT_inverse_butterflies(
+        digit *values,
+        size_t half,
+        size_t root_stride,
+        NTT_prime const &prime,
+        magnitude const &roots,
+        size_t begin,
+        size_t end) noexcept
+    {
+        digit *second = values + half;
+        for (size_t j = begin; j < end; ++j)
+        {
+            size_t const power = j * root_stride;
+            digit const twiddled = power == 0
+                ? second[j]
+                : prime.subtract(0, prime.multiply(second[j], roots[roots.size() - power]));
+            second[j] = prime.subtract(values[j], twiddled);
+            values[j] = prime.add(values[j], twiddled);
+        }
+    }
+
+    // decimation in frequency: natural order in, bit-reversed order out; a transform of size values
+    // uses every root_stride-th root, large ones split their stages between the pool's threads
+    void NTT_forward(
+        digit *values,
+        size_t size,
+        size_t root_stride,
+        NTT_prime const &prime,
+        magnitude const &roots,
+        work_stealing_thread_pool *pool)
+    {
+        size_t const half = size / 2;
+        if (pool != nullptr && size >= NTT_parallel_size)
+        {
+            size_t const chunk_size = NTT_parallel_size / 2;
+            run_products(pool, half / chunk_size, [&](size_t chunk)
+            {
+                NTT_forward_butterflies(values, half, root_stride, prime, roots, chunk * chunk_size, (chunk + 1) * chunk_size);
+            });
+            run_products(pool, 2, [&](size_t part)
+            {
+                NTT_forward(values + part * half, half, 2 * root_stride, prime, roots, pool);
+            });
+            return;
+        }
+
+        for (size_t stage_half = half; stage_half > 0; stage_half /= 2)
+        {
+            size_t const stride = half / stage_half * root_stride;
+            for (size_t block = 0; block < size; block += 2 * stage_half)
+            {
+                NTT_forward_butterflies(values + block, stage_half, stride, prime, roots, 0, stage_half);
+            }
+        }
+    }
+
+    // decimation in time with inverse roots: bit-reversed order in, natural order out, not scaled
+    void NTT_inverse(
+        digit *values,
+        size_t size,
+        size_t root_stride,
+        NTT_prime const &prime,
+        magnitude const &roots,
+        work_stealing_thread_pool *pool)
+    {
+        size_t const half = size / 2;
+        if (pool != nullptr && size >= NTT_parallel_size)
+        {
+            size_t const chunk_size = NTT_parallel_size / 2;
+            run_products(pool, 2, [&](size_t part)
+            {
+                NTT_inverse(values + part * half, half, 2 * root_stride, prime, roots, pool);
+            });
+            run_products(pool, half / chunk_size, [&](size_t chunk)
+            {
+                NTT_inverse_butterflies(values, half, root_stride, prime, roots, chunk * chunk_size, (chunk + 1) * chunk_size);
+            });
+            return;
+        }
+
+        for (size_t stage_half = 1; stage_half <= half; stage_half *= 2)
+        {
+            size_t const stride = half / stage_half * root_stride;
+            for (size_t block = 0; block < size; block += 2 * stage_half)
+            {
+                NTT_inverse_butterflies(values + block, stage_half, stride, prime, roots, 0, stage_half);
+            }
+        }
+    }
+
+    // writes output_size digits of the sum of the coefficients begin..end - 1, recombined from their
+    // residues, each shifted by its index less begin; the sum must fit
+    void NTT_recombine(
+        digit *output,
+        size_t output_size,
+        magnitude const *residues,
+        size_t begin,
+        size_t end) noexcept
+    {
+        // Garner's reconstruction: c = r0 + p0 * (v1 + p1 * v2) with v1 < p1, v2 < p2
+        NTT_prime const &first_prime = get_NTT_prime(0);
+        NTT_prime const &second_prime = get_NTT_prime(1);
+        NTT_prime const &third_prime = get_NTT_prime(2);
+        digit const first_inverse_modulo_second = second_prime.power(second_prime.to_Montgomery_form(first_prime.modulus), second_prime.modulus - 2);
+        digit const first_modulo_third = third_prime.to_Montgomery_form(first_prime.modulus);
+        digit const first_two_inverse_modulo_third = third_prime.power(
+            third_prime.multiply(first_modulo_third, third_prime.to_Montgomery_form(second_prime.modulus)),
+            third_prime.modulus - 2);
+        digit first_two_product[2];
+        first_two_product[0] = multiply_digits(first_prime.modulus, second_prime.modulus, first_two_product[1]);
+
+        digit carry[3] = { 0, 0, 0 };
+        for (size_t j = begin; j < begin + output_size; ++j)
+        {
+            digit coefficient[3] = { 0, 0, 0 };
+            if (j < end)
+            {
+                digit const first_residue = residues[0][j];
+                digit const second_residue = residues[1][j];
+                digit const third_residue = residues[2][j];
+
+                digit const first_residue_modulo_second = first_residue >= second_prime.modulus
+                    ? first_residue - second_prime.modulus
+                    : first_residue;
+                digit const second_digit = second_prime.multiply(
+                    second_prime.subtract(second_residue, first_residue_modulo_second),
+                    first_inverse_modulo_second);
+
+                digit const first_residue_modulo_third = first_residue >= third_prime.modulus
+                    ? first_residue - third_prime.modulus
+                    : first_residue;
+                digit const third_digit = third_prime.multiply(
+                    third_prime.subtract(
+                        third_prime.subtract(third_residue, first_residue_modulo_third),
+                        third_prime.multiply(second_digit, first_modulo_third)),
+                    first_two_inverse_modulo_third);
+
+                // coefficient = first_residue + second_digit * p0 + third_digit * p0 * p1
+                digit term[3];
+                coefficient[0] = first_residue;
+                term[0] = multiply_digits(second_digit, first_prime.modulus, term[1]);
+                term[2] = 0;
+                add_digits(coefficient, coefficient, term, 3);
+                term[2] = multiply_by_digit(term, first_two_product, 2, third_digit);
+                add_digits(coefficient, coefficient, term, 3);
+            }
+
+            add_digits(carry, carry, coefficient, 3);
+            output[j - begin] = carry[0];
+            carry[0] = carry[1];
+            carry[1] = carry[2];
+            carry[2] = 0;
+        }
+    }
+
+    // normalized operands of at least one digit each;
+    // result gets exactly first_size + second_size digits and must not alias the operands
+    void NTT_multiply(
+        digit *result,
+        digit const *first,
+        size_t first_size,
+        digit const *second,
+        size_t second_size)
+    {
+        size_t const coefficients_count = first_size + second_size - 1;
+        size_t log_size = 1;
+        while ((size_t(1) << log_size) < coefficients_count)
+        {
+            ++log_size;
+        }
+        if (log_size > NTT_max_log_size)
+        {
+            throw std::length_error("operands are too large for the number theoretic transform");
+        }
+
+        size_t const size = size_t(1) << log_size;
+        auto const twiddles = get_NTT_twiddles(log_size);
+        bool const squaring = is_square(first, first_size, second, second_size);
+        auto const pool = get_multiplication_pool(std::min(first_size, second_size));
+
+        // the primes are independent, so are the transforms of both operands
+        magnitude residues[NTT_primes_count];
+        run_products(pool.get(), NTT_primes_count, [&](size_t i)
+        {
+            NTT_prime const &prime = get_NTT_prime(i);
+            magnitude &first_values = residues[i];
+            magnitude second_values;
+
+            run_products(pool.get(), squaring
+                ? 1
+                : 2, [&](size_t operand)
+            {
+                magnitude &values = operand == 0
+                    ? first_values
+                    : second_values;
+                digit const *digits = operand == 0
+                    ? first
+                    : second;
+                size_t const digits_count = operand == 0
+                    ? first_size
+                    : second_size;
+
+                values.assign(size, 0);
+                for (size_t j = 0; j < digits_count; ++j)
+                {
+                    values[j] = digits[j] % prime.modulus;
+                }
+                NTT_forward(values.data(), size, 1, prime, twiddles->roots[i], pool.get());
+            });
+
+            magnitude const &second_transformed = squaring
+                ? first_values
+                : second_values;
+            for (size_t j = 0; j < size; ++j)
+            {
+                first_values[j] = prime.multiply(first_values[j], second_transformed[j]);
+            }
+
+            NTT_inverse(first_values.data(), size, 1, prime, twiddles->roots[i], pool.get());
+            for (size_t j = 0; j < coefficients_count; ++j)
+            {
+                first_values[j] = prime.multiply(first_values[j], twiddles->scale[i]);
+            }
+        });
+
+        size_t const product_size = first_size + second_size;
+        if (pool == nullptr || coefficients_count < NTT_parallel_size)
+        {
+            NTT_recombine(result, product_size, residues, 0, coefficients_count);
+            return;
+        }
+
+        // chunks overlap by the three digits of their last carry, so they are summed up afterwards
+        size_t const chunk_size = NTT_parallel_size;
+        size_t const chunks_count = (coefficients_count + chunk_size - 1) / chunk_size;
+        magnitude chunks(chunks_count * (chunk_size + 3));
+        run_products(pool.get(), chunks_count, [&](size_t chunk)
+        {
+            size_t const begin = chunk * chunk_size;
+            NTT_recombine(chunks.data() + chunk * (chunk_size + 3), chunk_size + 3, residues, begin, std::min(begin + chunk_size, coefficients_count));
+        });
+
+        std::fill(result, result + product_size, 0);
+        for (size_t chunk = 0; chunk < chunks_count; ++chunk)
+        {
+            size_t const offset = chunk * chunk_size;
+            add_digits(result + offset, result + offset, product_size - offset, chunks.data() + chunk * (chunk_size + 3), std::min(chunk_size + 3, product_size - offset));
+        }
+    }
+
+    // result gets exactly first_size + second_size digits and must not alias the operands
+    void multiply_digits_NTT(
+        digit *result,
+        digit const *first,
+        size_t first_size,
+        digit const *second,
+        size_t second_size)
+    {
+        size_t const result_size = first_size + second_size;
+        first_size = normalized_size(first, first_size);
+        second_size = normalized_size(second, second_size);
+
+        if (first_size < Karatsuba_threshold || second_size < Karatsuba_threshold)
+        {
+            multiply_digits_Karatsuba(result, first, first_size, second, second_size);
+            std::fill(result + first_size + second_size, result + result_size, 0);
+            return;
+        }
+
+        NTT_multiply(result, first, first_size, second, second_size);
+        std::fill(result + first_size + second_size, result + result_size, 0);
+    }
+
+    // picks an algorithm by the size of the shorter operand, Schonhage-Strassen only when is_Schonhage_Strassen_allowed;
+    // sub-products go through multiplication; result gets exactly first_size + second_size digits and must not alias the operands
+    void multiply_digits_by_size(
+        digit *result,
+        digit const *first,
+        size_t first_size,
+        digit const *second,
+        size_t second_size,
+        digits_multiplication multiplication,
+        bool is_Schonhage_Strassen_allowed)
+    {
+        size_t const result_size = first_size + second_size;
+        first_size = normalized_size(first, first_size);
+        second_size = normalized_size(second, second_size);
+
+        if (first_size < second_size)
+        {
+            std::swap(first, second);
+            std::swap(first_size, second_size);
+        }
+
+        std::fill(result + first_size + second_size, result + result_size, 0);
+
+        if (second_size < automatic_Karatsuba_threshold.load(std::memory_order_relaxed))
+        {
+            multiply_digits_trivial(result, first, first_size, second, second_size);
+        }
+        else if (second_size <= (first_size + 1) / 2)
+        {
+            multiply_digits_unbalanced(result, first, first_size, second, second_size, multiplication);
+        }
+        else if (second_size >= automatic_NTT_threshold.load(std::memory_order_relaxed))
+        {
+            NTT_multiply(result, first, first_size, second, second_size);
+        }
+        else if (is_Schonhage_Strassen_allowed
+            && second_size >= automatic_Schonhage_Strassen_threshold.load(std::memory_order_relaxed))
+        {
+            Schonhage_Strassen_step(result, first, first_size, second, second_size, multiply_digits_automatic_pointwise);
+        }
+        else if (second_size >= automatic_Toom_Cook_4_threshold.load(std::memory_order_relaxed)
+            && second_size > 3 * ((first_size + 3) / 4))
+        {
+            Toom_Cook_4_step(result, first, first_size, second, second_size, multiplication);
+        }
+        else if (second_size >= automatic_Toom_Cook_3_threshold.load(std::memory_order_relaxed)
+            && second_size > 2 * ((first_size + 2) / 3))
+        {
+            Toom_Cook_3_step(result, first, first_size, second, second_size, multiplication);
+        }
+        else
+        {
+            Karatsuba_step(result, first, first_size, second, second_size, multiplication);
+        }
+    }
+
+    // picks an algorithm for every (sub-)product by the size of its shorter operand;
+    // result gets exactly first_size + second_size digits and must not alias the operands
+    void multiply_digits_automatic(
+        digit *result,
+        digit const *first,
+        size_t first_size,
+        digit const *second,
+        size_t second_size)
+    {
+        multiply_digits_by_size(result, first, first_size, second, second_size, multiply_digits_automatic, true);
+    }
+
+    // the pointwise products of Schonhage-Strassen are one digit longer than its ring, which small operands don't
+    // outgrow, so below the recursion threshold they and their sub-products keep away from it, as the ones
+    // of multiplication_rule::SchonhageStrassen do; the thresholds can't make it recurse forever then
+    void multiply_digits_automatic_pointwise(
+        digit *result,
+        digit const *first,
+        size_t first_size,
+        digit const *second,
+        size_t second_size)
+    {
+        if (std::max(first_size, second_size) <= Schonhage_Strassen_recursion_threshold)
+        {
+            multiply_digits_by_size(result, first, first_size, second, second_size, multiply_digits_automatic_pointwise, false);
+        }
+        else
+        {
+            multiply_digits_automatic(result, first, first_size, second, second_size);
+        }
+    }
+
+    // endregion multiplication algorithms
+
+    // region division algorithms
+
+    // quotient gets dividend_size - divisor_size + 1 digits and remainder gets divisor_size digits, either may be nullptr;
+    // dividend_size >= divisor_size, the top divisor digit is not zero, outputs may alias the inputs
+    void divide_digits_trivial(
+        digit *quotient,
+        digit *remainder,
+        digit const *dividend,
+        size_t dividend_size,
+        digit const *divisor,
+        size_t divisor_size)
+    {
+        if (divisor_size == 1)
+        {
+            digit const remainder_digit = divide_by_digit(quotient, dividend, dividend_size, divisor[0]);
+            if (remainder != nullptr)
+            {
+                remainder[0] = remainder_digit;
+            }
+            return;
+        }
+
+        size_t const shift = leading_zero_bits(divisor[divisor_size - 1]);
+
+        digits_buffer normalized_divisor(divisor_size);
+        digits_buffer normalized_dividend(dividend_size + 1);
+        if (shift == 0)
+        {
+            std::copy(divisor, divisor + divisor_size, normalized_divisor.data());
+            std::copy(dividend, dividend + dividend_size, normalized_dividend.data());
+            normalized_dividend.data()[dividend_size] = 0;
+        }
+        else
+        {
+            shift_left_digits(normalized_divisor.data(), divisor, divisor_size, shift);
+            normalized_dividend.data()[dividend_size] = shift_left_digits(normalized_dividend.data(), dividend, dividend_size, shift);
+        }
+
+        divide_digits_basecase(quotient, normalized_dividend.data(), dividend_size, normalized_divisor.data(), divisor_size);
+
+        if (remainder != nullptr)
+        {
+            if (shift == 0)
+            {
+                std::copy(normalized_dividend.data(), normalized_dividend.data() + divisor_size, remainder);
+            }
+            else
+            {
+                shift_right_digits(remainder, normalized_dividend.data(), divisor_size, shift);
+            }
+        }
+    }
+
+    // quotient and remainder of first / second, second is not zero
+    void divide_trivial(
+        magnitude const &dividend,
+        magnitude const &divisor,
+        magnitude *quotient,
+        magnitude *remainder)
+    {
+        if (compare(dividend, divisor) < 0)
+        {
+            if (quotient != nullptr)
+            {
+                quotient->clear();
+            }
+            if (remainder != nullptr)
+            {
+                *remainder = dividend;
+            }
+            return;
+        }
+
+        if (quotient != nullptr)
+        {
+            quotient->resize(dividend.size() - divisor.size() + 1);
+        }
+        if (remainder != nullptr)
+        {
+            remainder->resize(divisor.size());
+        }
+
+        divide_digits_trivial(
+            quotient == nullptr
+                ? nullptr
+                : quotient->data(),
+            remainder == nullptr
+                ? nullptr
+                : remainder->data(),
+            dividend.data(),
+            dividend.size(),
+            divisor.data(),
+            divisor.size());
+
+        if (quotient != nullptr)
+        {
+            normalize(*quotient);
+        }
+        if (remainder != nullptr)
+        {
+            normalize(*remainder);
+        }
+    }
+
+    // floor(B^precision / divisor) rounded down by at most one, where B = 2^64
+    magnitude Newton_reciprocal(
+        magnitude const &divisor,
+        size_t precision,
+        digits_multiplication multiplication)
+    {
+        // initial approximation from the two leading digits, never above the exact value
+        digit const divisor_high = divisor.back();
+        digit const divisor_next = divisor.size() > 1
+            ? divisor[divisor.size() - 2]
+            : 0;
+        size_t const top_shift = leading_zero_bits(divisor_high);
+        digit const top = top_shift == 0
+            ? divisor_high
+            : (divisor_high << top_shift) | (divisor_next >> (digit_bits - top_shift));
+
+        // divisor < (top + 1) * 2^(divisor_bits - 64), so 2^127 / (top + 1) * 2^(64 * precision - divisor_bits - 63)
+        // stays below B^precision / divisor
+        digit remainder;
+        digit const estimate_digit = top == ~digit(0)
+            ? digit(1) << (digit_bits - 1)
+            : divide_double_digit(digit(1) << (digit_bits - 1), 0, top + 1, remainder);
+
+        size_t const approximation_exponent = digit_bits * precision;
+        size_t const scale = bit_length(divisor) + digit_bits - 1;
+        magnitude approximation(1, estimate_digit);
+        approximation = approximation_exponent >= scale
+            ? shift_left(approximation, approximation_exponent - scale)
+            : shift_right(approximation, scale - approximation_exponent);
+
+        magnitude power(precision + 1, 0);
+        power[precision] = 1;
+
+        while (true)
+        {
+            // error = B^precision - divisor * approximation >= 0
+            magnitude const product = multiply(divisor, approximation, multiplication);
+            magnitude const error = subtract(power, product);
+            magnitude const correction = shift_right(multiply(approximation, error, multiplication), digit_bits * precision);
+            if (correction.empty())
+            {
+                break;
+            }
+
+            approximation = add(approximation, correction);
+        }
+
+        return approximation;
+    }
+
+    // reciprocal = Newton_reciprocal(divisor, 2 * divisor.size()); the dividend goes through from the top in blocks
+    // of the divisor's length, each one below divisor * B^size <= B^(2 * size); as in Barrett reduction, the top
+    // size + 1 digits of a block times the reciprocal estimate its quotient short by a few units at most
+    void divide_by_reciprocal(
+        magnitude const &dividend,
+        magnitude const &divisor,
+        magnitude const &reciprocal,
+        magnitude *quotient,
+        magnitude *remainder,
+        digits_multiplication multiplication)
+    {
+        size_t const size = divisor.size();
+        size_t const blocks_count = (dividend.size() + size - 1) / size;
+
+        // the quotient digits are only gathered when asked for
+        magnitude result(quotient == nullptr
+            ? 0
+            : blocks_count * size, 0);
+        magnitude rest;
+        for (size_t i = blocks_count; i-- > 0;)
+        {
+            magnitude const block = add(shift_left_by_digits(rest, size), digits_range(dividend, i * size, size));
+            magnitude block_quotient = digits_range(multiply(digits_range(block, size - 1, size + 1), reciprocal, multiplication), size + 1, size + 1);
+            rest = subtract(block, multiply(block_quotient, divisor, multiplication));
+            while (compare(rest, divisor) >= 0)
+            {
+                rest = subtract(rest, divisor);
+                block_quotient = add(block_quotient, magnitude(1, 1));
+            }
+            if (quotient != nullptr)
+            {
+                std::copy(block_quotient.begin(), block_quotient.end(), result.begin() + static_cast<std::ptrdiff_t>(i * size));
+            }
+        }
+
+        if (quotient != nullptr)
+        {
+            normalize(result);
+            *quotient = std::move(result);
+        }
+        if (remainder != nullptr)
+        {
+            *remainder = std::move(rest);
+        }
+    }
+
+    void divide_Newton(
+        magnitude const &dividend,
+        magnitude const &divisor,
+        magnitude *quotient,
+        magnitude *remainder,
+        digits_multiplication multiplication)
+    {
+        if (compare(dividend, divisor) < 0 || divisor.size() == 1)
+        {
+            divide_trivial(dividend, divisor, quotient, remainder);
+            return;
+        }
+
+        magnitude const reciprocal = Newton_reciprocal(divisor, 2 * divisor.size(), multiplication);
+        divide_by_reciprocal(dividend, divisor, reciprocal, quotient, remainder, multiplication);
+    }
+
+    void divide_Burnikel_Ziegler_2n1n(
+        magnitude const &dividend,
+        magnitude const &divisor,
+        size_t size,
+        magnitude &quotient,
+        magnitude &remainder,
+        digits_multiplication multiplication);
+
+    // dividend has at most 3 * size digits, divisor has exactly 2 * size digits
+    void divide_Burnikel_Ziegler_3n2n(
+        magnitude const &dividend,
+        magnitude const &divisor,
+        size_t size,
+        magnitude &quotient,
+        magnitude &remainder,
+        digits_multiplication multiplication)
+    {
+        magnitude const dividend_high = digits_range(dividend, size, 2 * size);
+        magnitude const dividend_low = digits_range(dividend, 0, size);
+        magnitude const divisor_high = digits_range(divisor, size, size);
+        magnitude const divisor_low = digits_range(divisor, 0, size);
+
+        magnitude partial_remainder;
+        if (compare(digits_range(dividend, 2 * size, size), divisor_high) < 0)
+        {
+            divide_Burnikel_Ziegler_2n1n(dividend_high, divisor_high, size, quotient, partial_remainder, multiplication);
+        }
+        else
+        {
+            // quotient = B^size - 1, partial_remainder = dividend_high - quotient * divisor_high
+            quotient.assign(size, ~digit(0));
+            partial_remainder = subtract(add(dividend_high, divisor_high), shift_left_by_digits(divisor_high, size));
+        }
+
+        magnitude const subtrahend = multiply(quotient, divisor_low, multiplication);
+        magnitude estimate = add(shift_left_by_digits(partial_remainder, size), dividend_low);
+        while (compare(estimate, subtrahend) < 0)
+        {
+            estimate = add(estimate, divisor);
+            quotient = subtract(quotient, magnitude(1, 1));
+        }
+
+        remainder = subtract(estimate, subtrahend);
+    }
+
+    // dividend has at most 2 * size digits and is below divisor * B^size, divisor has exactly size digits
+    void divide_Burnikel_Ziegler_2n1n(
+        magnitude const &dividend,
+        magnitude const &divisor,
+        size_t size,
+        magnitude &quotient,
+        magnitude &remainder,
+        digits_multiplication multiplication)
+    {
+        if (size % 2 != 0 || size < Burnikel_Ziegler_threshold)
+        {
+            divide_trivial(dividend, divisor, &quotient, &remainder);
+            return;
+        }
+
+        size_t const half = size / 2;
+
+        magnitude high_quotient, high_remainder;
+        divide_Burnikel_Ziegler_3n2n(digits_range(dividend, half, 3 * half), divisor, half, high_quotient, high_remainder, multiplication);
+
+        magnitude low_quotient;
+        divide_Burnikel_Ziegler_3n2n(add(shift_left_by_digits(high_remainder, half), digits_range(dividend, 0, half)), divisor, half, low_quotient, remainder, multiplication);
+
+        quotient = add(shift_left_by_digits(high_quotient, half), low_quotient);
+    }
+
+    void divide_Burnikel_Ziegler(
+        magnitude const &dividend,
+        magnitude const &divisor,
+        magnitude *quotient,
+        magnitude *remainder,
+        digits_multiplication multiplication)
+    {
+        if (compare(dividend, divisor) < 0
+            || divisor.size() < Burnikel_Ziegler_threshold
+            || dividend.size() - divisor.size() < Burnikel_Ziegler_threshold)
+        {
+            divide_trivial(dividend, divisor, quotient, remainder);
+            return;
+        }
+
+        // block size: a multiple of a power of two so that halving reaches the threshold
+        size_t blocks = 1;
+        while (blocks * Burnikel_Ziegler_threshold <= divisor.size())
+        {
+            blocks *= 2;
+        }
+        size_t const size = (divisor.size() + blocks - 1) / blocks * blocks;
+
+        size_t const shift = size * digit_bits - bit_length(divisor);
+        magnitude const normalized_divisor = shift_left(divisor, shift);
+        magnitude const normalized_dividend = shift_left(dividend, shift);
+
+        size_t const blocks_count = std::max<size_t>(2, (bit_length(normalized_dividend) + 1 + size * digit_bits - 1) / (size * digit_bits));
+
+        // the quotient digits are only gathered when asked for
+        magnitude result(quotient == nullptr
+            ? 0
+            : blocks_count * size, 0);
+        magnitude partial_dividend = digits_range(normalized_dividend, (blocks_count - 2) * size, 2 * size);
+        magnitude partial_remainder;
+        for (size_t i = blocks_count - 1; i-- > 0;)
+        {
+            magnitude partial_quotient;
+            divide_Burnikel_Ziegler_2n1n(partial_dividend, normalized_divisor, size, partial_quotient, partial_remainder, multiplication);
+            if (quotient != nullptr)
+            {
+                std::copy(partial_quotient.begin(), partial_quotient.end(), result.begin() + static_cast<std::ptrdiff_t>(i * size));
+            }
+
+            if (i != 0)
+            {
+                partial_dividend = add(shift_left_by_digits(partial_remainder, size), digits_range(normalized_dividend, (i - 1) * size, size));
+            }
+        }
+
+        if (quotient != nullptr)
+        {
+            normalize(result);
+            *quotient = std::move(result);
+        }
+        if (remainder != nullptr)
+        {
+            *remainder = shift_right(partial_remainder, shift);
+        }
+    }
+
+    // endregion division algorithms
+
+    // region greatest common divisor
+
+#ifdef __SIZEOF_INT128__
+    // Lehmer's steps look at the leading two digits of the operands, less a few bits so that the sums
+    // with cofactors stay in range
+    using Lehmer_word = __int128;
+    size_t const Lehmer_bits = 124;
+#else
+    using Lehmer_word = int64_t;
+    size_t const Lehmer_bits = 60;
+#endif
+
+    // cofactors of a Lehmer step stay below this, so they fit in int64_t and their products in Lehmer_word
+    Lehmer_word const Lehmer_factor_bound = Lehmer_word(1) << (Lehmer_bits / 2);
+
+    // (first, second) -> (entries[0] * first + entries[1] * second, entries[2] * first + entries[3] * second),
+    // the determinant is 1 or -1, so gcd(first, second) stays as it is
+    struct gcd_matrix final
+    {
+
+        signed_magnitude entries[4];
+
+    };
+
+    void negate(
+        signed_magnitude &value) noexcept
+    {
+        value.is_negative = !value.is_negative && !value.value.empty();
+    }
+
+    signed_magnitude multiply(
+        signed_magnitude const &first,
+        magnitude const &second,
+        digits_multiplication multiplication)
+    {
+        signed_magnitude result{ multiply(first.value, second, multiplication), first.is_negative };
+        result.is_negative = result.is_negative && !result.value.empty();
+        return result;
+    }
+
+    signed_magnitude multiply(
+        signed_magnitude const &first,
+        signed_magnitude const &second,
+        digits_multiplication multiplication)
+    {
+        signed_magnitude result = multiply(first, second.value, multiplication);
+        if (second.is_negative)
+        {
+            negate(result);
+        }
+        return result;
+    }
+
+    signed_magnitude multiply(
+        signed_magnitude const &first,
+        int64_t second)
+    {
+        digit const second_magnitude = second < 0
+            ? digit(0) - static_cast<digit>(second)
+            : static_cast<digit>(second);
+
+        signed_magnitude result{ magnitude(first.value.size() + 1), first.is_negative != (second < 0) };
+        result.value[first.value.size()] = multiply_by_digit(result.value.data(), first.value.data(), first.value.size(), second_magnitude);
+        normalize(result.value);
+        result.is_negative = result.is_negative && !result.value.empty();
+        return result;
+    }
+
+    gcd_matrix identity_gcd_matrix()
+    {
+        return gcd_matrix{
+            {
+                { magnitude(1, 1), false },
+                { magnitude(), false },
+                { magnitude(), false },
+                { magnitude(1, 1), false }
+            }
+        };
+    }
+
+    // the matrix doing second first and then first
+    gcd_matrix multiply(
+        gcd_matrix const &first,
+        gcd_matrix const &second,
+        digits_multiplication multiplication)
+    {
+        gcd_matrix result;
+        for (size_t row = 0; row < 2; ++row)
+        {
+            for (size_t column = 0; column < 2; ++column)
+            {
+                result.entries[2 * row + column] = add(
+                    multiply(first.entries[2 * row], second.entries[column], multiplication),
+                    multiply(first.entries[2 * row + 1], second.entries[2 + column], multiplication),
+                    false);
+            }
+        }
+        return result;
+    }
+
+    // matrix = factors * matrix, the factors laid out as the entries of a gcd_matrix
+    void apply_factors(
+        gcd_matrix &matrix,
+        int64_t const *factors)
+    {
+        for (size_t column = 0; column < 2; ++column)
+        {
+            signed_magnitude const &top = matrix.entries[column];
+            signed_magnitude const &bottom = matrix.entries[2 + column];
+            signed_magnitude next_top = add(multiply(top, factors[0]), multiply(bottom, factors[1]), false);
+            signed_magnitude next_bottom = add(multiply(top, factors[2]), multiply(bottom, factors[3]), false);
+            matrix.entries[column] = std::move(next_top);
+            matrix.entries[2 + column] = std::move(next_bottom);
+        }
+    }
+
+    // the bits of value below bits_count
+    magnitude low_bits(
+        magnitude const &value,
+        size_t bits_count)
+    {
+        magnitude result = digits_range(value, 0, (bits_count + digit_bits - 1) / digit_bits);
+        if (result.size() * digit_bits > bits_count)
+        {
+            result.back() &= (digit(1) << (bits_count % digit_bits)) - 1;
+            normalize(result);
+        }
+        return result;
+    }
+
+    // (first, second) = matrix * (first, second) for first >= second, where the leading bits of the operands
+    // from shift upwards are already reduced by the matrix, so only the low bits are left to multiply;
+    // signs of the results go into the matrix rows and the rows swap when needed, so that first >= second >= 0 again
+    void apply_matrix(
+        gcd_matrix &matrix,
+        magnitude &first,
+        magnitude &second,
+        magnitude const &reduced_leading_first,
+        magnitude const &reduced_leading_second,
+        size_t shift,
+        digits_multiplication multiplication)
+    {
+        magnitude const low_first = low_bits(first, shift);
+        magnitude const low_second = low_bits(second, shift);
+        signed_magnitude next_first = add(
+            signed_magnitude{ shift_left(reduced_leading_first, shift), false },
+            add(multiply(matrix.entries[0], low_first, multiplication), multiply(matrix.entries[1], low_second, multiplication), false),
+            false);
+        signed_magnitude next_second = add(
+            signed_magnitude{ shift_left(reduced_leading_second, shift), false },
+            add(multiply(matrix.entries[2], low_first, multiplication), multiply(matrix.entries[3], low_second, multiplication), false),
+            false);
+
+        if (next_first.is_negative)
+        {
+            negate(matrix.entries[0]);
+            negate(matrix.entries[1]);
+        }
+        if (next_second.is_negative)
+        {
+            negate(matrix.entries[2]);
+            negate(matrix.entries[3]);
+        }
+
+        first = std::move(next_first.value);
+        second = std::move(next_second.value);
+        if (compare(first, second) < 0)
+        {
+            std::swap(first, second);
+            std::swap(matrix.entries[0], matrix.entries[2]);
+            std::swap(matrix.entries[1], matrix.entries[3]);
+        }
+    }
+
+    // Euclid's step (first, second) -> (second, first mod second), second is not zero
+    void divide_step(
+        magnitude &first,
+        magnitude &second,
+        gcd_matrix *matrix)
+    {
+        magnitude quotient, remainder;
+        divide_trivial(first, second, matrix == nullptr
+            ? nullptr
+            : &quotient, &remainder);
+        first = std::move(second);
+        second = std::move(remainder);
+
+        if (matrix != nullptr)
+        {
+            for (size_t column = 0; column < 2; ++column)
+            {
+                signed_magnitude next_bottom = add(matrix->entries[column], multiply(matrix->entries[2 + column], quotient, multiply_digits_automatic), true);
+                matrix->entries[column] = std::move(matrix->entries[2 + column]);
+                matrix->entries[2 + column] = std::move(next_bottom);
+            }
+        }
+    }
+
+    // value / 2^shift, which is known to have at most Lehmer_bits bits
+    Lehmer_word leading_bits(
+        magnitude const &value,
+        size_t shift) noexcept
+    {
+        Lehmer_word result = 0;
+        for (size_t i = shift / digit_bits; i < value.size(); ++i)
+        {
+            size_t const position = i * digit_bits;
+            result |= position >= shift
+                ? Lehmer_word(value[i]) << (position - shift)
+                : Lehmer_word(value[i] >> (shift - position));
+        }
+        return result;
+    }
+
+    // Knuth's algorithm L on the leading bits of first >= second: the Euclidean quotients those bits are sure
+    // to share with the whole values, stopping once second has at most stop_bits bits, folded into factors
+    // laid out as the entries of a gcd_matrix; false when not even one quotient is sure
+    bool Lehmer_factors(
+        magnitude const &first,
+        magnitude const &second,
+        size_t stop_bits,
+        int64_t *factors)
+    {
+        size_t const bits = bit_length(first);
+        size_t const shift = bits > Lehmer_bits
+            ? bits - Lehmer_bits
+            : 0;
+        if (stop_bits >= shift + Lehmer_bits)
+        {
+            return false;
+        }
+
+        // second has at most stop_bits bits for sure once its leading bits drop below stop
+        Lehmer_word const stop = Lehmer_word(1) << (stop_bits > shift
+            ? stop_bits - shift
+            : 0);
+
+        Lehmer_word first_bits = leading_bits(first, shift);
+        Lehmer_word second_bits = leading_bits(second, shift);
+        Lehmer_word a = 1, b = 0, c = 0, d = 1;
+        bool is_reduced = false;
+
+        while (second_bits >= stop && second_bits + c > 0 && second_bits + d > 0)
+        {
+            Lehmer_word const quotient = (first_bits + a) / (second_bits + c);
+            if (quotient != (first_bits + b) / (second_bits + d) || quotient >= Lehmer_factor_bound)
+            {
+                break;
+            }
+
+            Lehmer_word const next_c = a - quotient * c;
+            Lehmer_word const next_d = b - quotient * d;
+            if (next_c <= -Lehmer_factor_bound || next_c >= Lehmer_factor_bound
+                || next_d <= -Lehmer_factor_bound || next_d >= Lehmer_factor_bound)
+            {
+                break;
+            }
+
+            a = c;
+            b = d;
+            c = next_c;
+            d = next_d;
+            Lehmer_word const next_second_bits = first_bits - quotient * second_bits;
+            first_bits = second_bits;
+            second_bits = next_second_bits;
+            is_reduced = true;
+        }
+
+        factors[0] = static_cast<int64_t>(a);
+        factors[1] = static_cast<int64_t>(b);
+        factors[2] = static_cast<int64_t>(c);
+        factors[3] = static_cast<int64_t>(d);
+        return is_reduced;
+    }
+
+    // first * first_factor + second * second_factor for factors of opposite signs and a result that isn't negative
+    magnitude combine(
+        magnitude const &first,
+        int64_t first_factor,
+        magnitude const &second,
+        int64_t second_factor)
+    {
+        if (second_factor > 0)
+        {
+            return combine(second, second_factor, first, first_factor);
+        }
+
+        size_t const size = std::max(first.size(), second.size()) + 1;
+        magnitude result(size, 0);
+        result[first.size()] = multiply_by_digit(result.data(), first.data(), first.size(), static_cast<digit>(first_factor));
+        digit const borrow = subtract_multiplied_by_digit(result.data(), second.data(), second.size(), digit(0) - static_cast<digit>(second_factor));
+        subtract_digit(result.data() + second.size(), result.data() + second.size(), size - second.size(), borrow);
+        normalize(result);
+        return result;
+    }
+
+    // Lehmer's step: as many Euclidean quotients as the leading bits give at once, Euclid's step if none
+    void Lehmer_step(
+        magnitude &first,
+        magnitude &second,
+        size_t stop_bits,
+        gcd_matrix *matrix)
+    {
+        int64_t factors[4];
+        if (!Lehmer_factors(first, second, stop_bits, factors))
+        {
+            divide_step(first, second, matrix);
+            return;
+        }
+
+        magnitude next_first = combine(first, factors[0], second, factors[1]);
+        second = combine(first, factors[2], second, factors[3]);
+        first = std::move(next_first);
+
+        if (matrix != nullptr)
+        {
+            apply_factors(*matrix, factors);
+        }
+    }
+
+    void half_gcd(
+        magnitude &first,
+        magnitude &second,
+        size_t stop_bits,
+        gcd_matrix &matrix,
+        digits_multiplication multiplication);
+
+    // half_gcd of the bits of first and second from shift upwards, applied to the whole operands and folded into matrix
+    void reduce_leading_part(
+        magnitude &first,
+        magnitude &second,
+        size_t shift,
+        gcd_matrix &matrix,
+        digits_multiplication multiplication)
+    {
+        magnitude leading_first = shift_right(first, shift);
+        magnitude leading_second = shift_right(second, shift);
+        size_t const leading_bits_count = bit_length(leading_first);
+
+        gcd_matrix leading_matrix;
+        half_gcd(leading_first, leading_second, leading_bits_count / 2 + 1, leading_matrix, multiplication);
+        apply_matrix(leading_matrix, first, second, leading_first, leading_second, shift, multiplication);
+        matrix = multiply(leading_matrix, matrix, multiplication);
+    }
+
+    // reduces first >= second, as Euclid's algorithm would, until second has at most stop_bits bits,
+    // and returns in matrix the transformation of the original operands into the reduced ones;
+    // the quotients of the leading part of the operands reduced to half of its length are the quotients
+    // of the whole operands too (up to a correction step or two), so the leading half of the bits above stop_bits
+    // takes the operands a half of the way down and the leading half of what is left takes them the rest of it
+    void half_gcd(
+        magnitude &first,
+        magnitude &second,
+        size_t stop_bits,
+        gcd_matrix &matrix,
+        digits_multiplication multiplication)
+    {
+        matrix = identity_gcd_matrix();
+        if (first.size() >= half_gcd_threshold && bit_length(second) > stop_bits)
+        {
+            reduce_leading_part(first, second, stop_bits, matrix, multiplication);
+            if (bit_length(second) > stop_bits)
+            {
+                divide_step(first, second, &matrix);
+            }
+
+            size_t const bits = bit_length(first);
+            if (bit_length(second) > stop_bits && first.size() >= half_gcd_threshold)
+            {
+                reduce_leading_part(first, second, 2 * stop_bits > bits
+                    ? 2 * stop_bits - bits
+                    : 0, matrix, multiplication);
+            }
+        }
+
+        while (bit_length(second) > stop_bits)
+        {
+            Lehmer_step(first, second, stop_bits, &matrix);
+        }
+    }
+
+    // gcd(first, second) for first >= second goes to first, second ends up zero;
+    // matrix, unless nullptr, gets the transformation of the original operands on top of what it already holds
+    void reduce_gcd(
+        magnitude &first,
+        magnitude &second,
+        big_integer::gcd_rule gcd_rule,
+        gcd_matrix *matrix,
+        digits_multiplication multiplication)
+    {
+        if (gcd_rule == big_integer::gcd_rule::Euclid)
+        {
+            while (!second.empty())
+            {
+                divide_step(first, second, matrix);
+            }
+            return;
+        }
+
+        // the quotient matrices cost less than the cofactors' Lehmer steps, but more than Lehmer's steps alone
+        size_t const threshold = matrix == nullptr
+            ? half_gcd_without_cofactors_threshold
+            : half_gcd_threshold;
+        while (gcd_rule == big_integer::gcd_rule::HalfGCD && second.size() >= threshold)
+        {
+            size_t const stop_bits = bit_length(first) / 2;
+            if (bit_length(second) <= stop_bits + 1)
+            {
+                divide_step(first, second, matrix);
+                continue;
+            }
+
+            gcd_matrix step;
+            half_gcd(first, second, stop_bits, step, multiplication);
+            if (matrix != nullptr)
+            {
+                *matrix = multiply(step, *matrix, multiplication);
+            }
+        }
+
+        while (!second.empty())
+        {
+            Lehmer_step(first, second, 0, matrix);
+        }
+    }
+
+    // endregion greatest common divisor
+
+    // region radix conversion
+
+    size_t digit_value(
+        char symbol) noexcept
+    {
+        if (symbol >= '0' && symbol <= '9')
+        {
+            return static_cast<size_t>(symbol - '0');
+        }
+        if (symbol >= 'a' && symbol <= 'z')
+        {
+            return static_cast<size_t>(symbol - 'a' + 10);
+        }
+        if (symbol >= 'A' && symbol <= 'Z')
+        {
+            return static_cast<size_t>(symbol - 'A' + 10);
+        }
+        return 36;
+    }
+
+    // largest power of base fitting in a digit and its exponent
+    std::pair<digit, size_t> chunk_base(
+        size_t base) noexcept
+    {
+        digit power = base;
+        size_t exponent = 1;
+        while (power <= ~digit(0) / base)
+        {
+            power *= base;
+            ++exponent;
+        }
+        return std::make_pair(power, exponent);
+    }
+
+    // bits per symbol of a power of two base, 0 for other bases
+    size_t power_of_two_base_bits(
+        size_t base) noexcept
+    {
+        size_t bits = 0;
+        while ((size_t(1) << bits) < base)
+        {
+            ++bits;
+        }
+        return (size_t(1) << bits) == base
+            ? bits
+            : 0;
+    }
+
+    // chunk_base(base).first ^ (2^level); kept between conversions, squared on demand
+    std::shared_ptr<magnitude const> get_radix_power(
+        size_t base,
+        size_t level)
+    {
+        static std::mutex cache_mutex;
+        static std::vector<std::shared_ptr<magnitude const>> cache[37];
+
+        std::lock_guard<std::mutex> lock(cache_mutex);
+        auto &powers = cache[base];
+        if (powers.empty())
+        {
+            powers.push_back(std::make_shared<magnitude const>(1, chunk_base(base).first));
+        }
+        while (powers.size() <= level)
+        {
+            magnitude const &previous = *powers.back();
+            powers.push_back(std::make_shared<magnitude const>(multiply(previous, previous, multiply_digits_automatic)));
+        }
+
+        return powers[level];
+    }
+
+    // symbols in begin..end - 1 are digits of a power of two base with bits bits each
+    magnitude parse_power_of_two_digits(
+        char const *begin,
+        char const *end,
+        size_t bits)
+    {
+        magnitude result((static_cast<size_t>(end - begin) * bits + digit_bits - 1) / digit_bits, 0);
+        size_t position = 0;
+        for (char const *symbol = end; symbol-- != begin; position += bits)
+        {
+            digit const value = digit_value(*symbol);
+            size_t const offset = position % digit_bits;
+            result[position / digit_bits] |= value << offset;
+            if (offset + bits > digit_bits)
+            {
+                result[position / digit_bits + 1] |= value >> (digit_bits - offset);
+            }
+        }
+
+        normalize(result);
+        return result;
+    }
+
+    // symbols in begin..end - 1 are digits of base; long strings are split at a power of base
+    // from the cache and their halves combined by a single fast multiplication
+    magnitude parse_digits(
+        char const *begin,
+        char const *end,
+        size_t base)
+    {
+        auto const chunk = chunk_base(base);
+        size_t const length = static_cast<size_t>(end - begin);
+
+        if (length > radix_conversion_threshold * chunk.second)
+        {
+            size_t level = 0;
+            while ((chunk.second << (level + 1)) < length)
+            {
+                ++level;
+            }
+
+            char const *middle = end - (chunk.second << level);
+            magnitude const high = multiply(parse_digits(begin, middle, base), *get_radix_power(base, level), multiply_digits_automatic);
+            return add(high, parse_digits(middle, end, base));
+        }
+
+        magnitude result;
+        result.reserve(length / chunk.second + 2);
+        for (char const *position = begin; position != end;)
+        {
+            size_t const chunk_length = std::min(chunk.second, static_cast<size_t>(end - position));
+
+            digit chunk_value = 0;
+            digit chunk_power = 1;
+            for (size_t i = 0; i < chunk_length; ++i)
+            {
+                chunk_value = chunk_value * base + digit_value(*position++);
+                chunk_power *= base;
+            }
+
+            digit carry = multiply_by_digit(result.data(), result.data(), result.size(), chunk_power);
+            if (carry != 0)
+            {
+                result.push_back(carry);
+            }
+            carry = add_digit(result.data(), result.data(), result.size(), chunk_value);
+            if (carry != 0)
+            {
+                result.push_back(carry);
+            }
+        }
+
+        return result;
+    }
+
+    char const radix_symbols[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+
+    std::string format_power_of_two_digits(
+        magnitude const &value,
+        size_t bits)
+    {
+        size_t const symbols_count = (bit_length(value) + bits - 1) / bits;
+        digit const mask = (digit(1) << bits) - 1;
+
+        std::string result(symbols_count, '0');
+        for (size_t i = 0, position = 0; i < symbols_count; ++i, position += bits)
+        {
+            size_t const offset = position % digit_bits;
+            digit symbol_value = value[position / digit_bits] >> offset;
+            if (offset + bits > digit_bits && position / digit_bits + 1 < value.size())
+            {
+                symbol_value |= value[position / digit_bits + 1] << (digit_bits - offset);
+            }
+            result[symbols_count - 1 - i] = radix_symbols[symbol_value & mask];
+        }
+
+        return result;
+    }
+
+    // writes exactly chunk_base(base).second * 2^level symbols of value < chunk_base(base).first ^ (2^level),
+    // padded with zeros; long values are split by a division by a power of base from the cache
+    void format_digits(
+        magnitude const &value,
+        size_t base,
+        size_t level,
+        char *output)
+    {
+        auto const chunk = chunk_base(base);
+        size_t const length = chunk.second << level;
+
+        if (value.size() > radix_conversion_threshold)
+        {
+            magnitude quotient;
+            magnitude remainder;
+            divide_Burnikel_Ziegler(value, *get_radix_power(base, level - 1), &quotient, &remainder, multiply_digits_automatic);
+            format_digits(quotient, base, level - 1, output);
+            format_digits(remainder, base, level - 1, output + length / 2);
+            return;
+        }
+
+        magnitude rest(value);
+        char *position = output + length;
+        while (!rest.empty())
+        {
+            digit chunk_value = divide_by_digit(rest.data(), rest.data(), rest.size(), chunk.first);
+            normalize(rest);
+            for (size_t i = 0; i < chunk.second; ++i)
+            {
+                *--position = radix_symbols[chunk_value % base];
+                chunk_value /= base;
+            }
+        }
+        std::fill(output, position, '0');
+    }
+
+    // value is not zero
+    std::string format_magnitude(
+        magnitude const &value,
+        size_t base)
+    {
+        size_t const bits = power_of_two_base_bits(base);
+        if (bits != 0)
+        {
+            return format_power_of_two_digits(value, bits);
+        }
+
+        size_t level = 0;
+        while (compare(value, *get_radix_power(base, level)) >= 0)
+        {
+            ++level;
+        }
+
+        std::string result(chunk_base(base).second << level, '0');
+        format_digits(value, base, level, &result[0]);
+        result.erase(0, result.find_first_not_of('0'));
+        return result;
+    }
+
+    // endregion radix conversion
+
+    // region binary serialization
+
+    // a sign byte and 8 bytes of count, or a LEB128 number of up to 64 bits
+    size_t const max_serialized_header_size = 10;
+
+    // digits a stream deserialization reads at first, before the data read shows the count is real
+    size_t const deserialization_chunk_size = 4096;
+
+    bool is_little_endian_host() noexcept
+    {
+        uint16_t const probe = 1;
+        unsigned char first_byte;
+        std::memcpy(&first_byte, &probe, 1);
+        return first_byte == 1;
+    }
+
+    void store_digits(
+        unsigned char *bytes,
+        digit const *digits,
+        size_t count) noexcept
+    {
+        if (is_little_endian_host())
+        {
+            std::memcpy(bytes, digits, count * sizeof(digit));
+            return;
+        }
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            for (size_t j = 0; j < sizeof(digit); ++j)
+            {
+                bytes[i * sizeof(digit) + j] = static_cast<unsigned char>(digits[i] >> (8 * j));
+            }
+        }
+    }
+
+    // bytes may alias digits
+    void load_digits(
+        digit *digits,
+        unsigned char const *bytes,
+        size_t count) noexcept
+    {
+        if (is_little_endian_host())
+        {
+            std::memmove(digits, bytes, count * sizeof(digit));
+            return;
+        }
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            digit value = 0;
+            for (size_t j = 0; j < sizeof(digit); ++j)
+            {
+                value |= digit(bytes[i * sizeof(digit) + j]) << (8 * j);
+            }
+            digits[i] = value;
+        }
+    }
+
+    // digits go to the stream straight from memory on little-endian hosts
+    void write_digits(
+        std::ostream &stream,
+        digit const *digits,
+        size_t count)
+    {
+        if (is_little_endian_host())
+        {
+            stream.write(reinterpret_cast<char const *>(digits), static_cast<std::streamsize>(count * sizeof(digit)));
+            return;
+        }
+
+        size_t const block_size = 512;
+        unsigned char block[block_size * sizeof(digit)];
+        for (size_t offset = 0; offset < count; offset += block_size)
+        {
+            size_t const block_count = std::min(block_size, count - offset);
+            store_digits(block, digits + offset, block_count);
+            stream.write(reinterpret_cast<char const *>(block), static_cast<std::streamsize>(block_count * sizeof(digit)));
+        }
+    }
+
+    // returns the count of bytes written
+    size_t store_count(
+        unsigned char *bytes,
+        uint64_t count,
+        big_integer::serialization_format format) noexcept
+    {
+        if (format == big_integer::serialization_format::fixed)
+        {
+            for (size_t i = 0; i < sizeof(uint64_t); ++i)
+            {
+                bytes[i] = static_cast<unsigned char>(count >> (8 * i));
+            }
+            return sizeof(uint64_t);
+        }
+
+        size_t size = 0;
+        do
+        {
+            bytes[size] = static_cast<unsigned char>(count & 0x7F);
+            count >>= 7;
+            if (count != 0)
+            {
+                bytes[size] |= 0x80;
+            }
+            ++size;
+        }
+        while (count != 0);
+        return size;
+    }
+
+    // returns the count of bytes read, 0 if size bytes don't hold a whole count
+    size_t load_count(
+        unsigned char const *bytes,
+        size_t size,
+        big_integer::serialization_format format,
+        uint64_t &count) noexcept
+    {
+        count = 0;
+        if (format == big_integer::serialization_format::fixed)
+        {
+            if (size < sizeof(uint64_t))
+            {
+                return 0;
+            }
+            for (size_t i = 0; i < sizeof(uint64_t); ++i)
+            {
+                count |= uint64_t(bytes[i]) << (8 * i);
+            }
+            return sizeof(uint64_t);
+        }
+
+        for (size_t i = 0; i < size && i < max_serialized_header_size; ++i)
+        {
+            // the tenth byte holds the 64th bit only
+            uint64_t const bits = bytes[i] & 0x7F;
+            if (i + 1 == max_serialized_header_size && bits > 1)
+            {
+                return 0;
+            }
+            count |= bits << (i * 7);
+            if ((bytes[i] & 0x80) == 0)
+            {
+                return i + 1;
+            }
+        }
+        return 0;
+    }
+
+    size_t store_header(
+        unsigned char *bytes,
+        bool is_negative,
+        uint64_t digits_count,
+        big_integer::serialization_format format) noexcept
+    {
+        if (format == big_integer::serialization_format::fixed)
+        {
+            bytes[0] = is_negative
+                ? 1
+                : 0;
+            return 1 + store_count(bytes + 1, digits_count, format);
+        }
+
+        return store_count(bytes, digits_count << 1 | (is_negative
+            ? 1
+            : 0), format);
+    }
+
+    // returns the count of bytes read, 0 if size bytes don't hold a whole valid header
+    size_t load_header(
+        unsigned char const *bytes,
+        size_t size,
+        big_integer::serialization_format format,
+        bool &is_negative,
+        uint64_t &digits_count) noexcept
+    {
+        if (format == big_integer::serialization_format::fixed)
+        {
+            if (size == 0 || bytes[0] > 1)
+            {
+                return 0;
+            }
+            is_negative = bytes[0] == 1;
+
+            size_t const count_size = load_count(bytes + 1, size - 1, format, digits_count);
+            return count_size == 0
+                ? 0
+                : count_size + 1;
+        }
+
+        uint64_t value;
+        size_t const header_size = load_count(bytes, size, format, value);
+        is_negative = (value & 1) != 0;
+        digits_count = value >> 1;
+        return header_size;
+    }
+
+    // reads just the bytes of a count or of a header, returns their count or 0 if the stream ends first
+    size_t read_count_bytes(
+        std::istream &stream,
+        unsigned char *bytes,
+        size_t fixed_size,
+        big_integer::serialization_format format)
+    {
+        if (format == big_integer::serialization_format::fixed)
+        {
+            stream.read(reinterpret_cast<char *>(bytes), static_cast<std::streamsize>(fixed_size));
+            return static_cast<size_t>(stream.gcount()) == fixed_size
+                ? fixed_size
+                : 0;
+        }
+
+        for (size_t i = 0; i < max_serialized_header_size; ++i)
+        {
+            auto const byte = stream.get();
+            if (byte == std::istream::traits_type::eof())
+            {
+                return 0;
+            }
+            bytes[i] = static_cast<unsigned char>(byte);
+            if ((bytes[i] & 0x80) == 0)
+            {
+                return i + 1;
+            }
+        }
+        return max_serialized_header_size;
+    }
+
+    // endregion binary serialization
+
+    // region modular arithmetic
+
+    // odd^-1 modulo 2^64: odd is its own inverse modulo 8 and every Newton step doubles the correct bits
+    digit inverse_digit(
+        digit odd) noexcept
+    {
+        digit inverse = odd;
+        for (size_t i = 0; i < 5; ++i)
+        {
+            inverse *= 2 - odd * inverse;
+        }
+        return inverse;
+    }
+
+    // value = -value modulo 2^(64 * size)
+    void negate_digits(
+        digit *value,
+        size_t size) noexcept
+    {
+        for (size_t i = 0; i < size; ++i)
+        {
+            value[i] = ~value[i];
+        }
+        add_digit(value, value, size, 1);
+    }
+
+    // odd^-1 modulo 2^(64 * size) by Hensel lifting, every step doubles the count of correct digits
+    magnitude inverse_digits(
+        digit const *odd,
+        size_t size)
+    {
+        magnitude inverse(size, 0);
+        magnitude product(2 * size);
+        magnitude correction(2 * size);
+        inverse[0] = inverse_digit(odd[0]);
+
+        for (size_t precision = 1; precision < size;)
+        {
+            size_t const next_precision = std::min(2 * precision, size);
+            size_t const high_size = next_precision - precision;
+
+            // odd * inverse is 1 plus a multiple of 2^(64 * precision), inverse * (1 - odd * inverse) corrects the next digits
+            multiply_digits_automatic(product.data(), odd, next_precision, inverse.data(), precision);
+            subtract_digit(product.data(), product.data(), next_precision, 1);
+            negate_digits(product.data() + precision, high_size);
+            multiply_digits_automatic(correction.data(), inverse.data(), high_size, product.data() + precision, high_size);
+            std::copy(correction.begin(), correction.begin() + static_cast<std::ptrdiff_t>(high_size), inverse.begin() + static_cast<std::ptrdiff_t>(precision));
+
+            precision = next_precision;
+        }
+
+        return inverse;
+    }
+
+    // result = value + carry * 2^(64 * size) brought below the modulus, the value being less than twice the modulus
+    void subtract_modulus_once(
+        digit *result,
+        digit const *value,
+        digit carry,
+        digit const *modulus,
+        size_t size) noexcept
+    {
+        if (carry != 0 || compare_digits(value, modulus, size) >= 0)
+        {
+            subtract_digits(result, value, modulus, size);
+        }
+        else
+        {
+            std::copy(value, value + size, result);
+        }
+    }
+
+    // result = product / 2^(64 * size) modulo modulus for a product of 2 * size digits below modulus * 2^(64 * size);
+    // every step adds the multiple of the modulus zeroing the lowest digit, digit_inverse is -modulus^-1 modulo 2^64;
+    // the product is destroyed
+    void reduce_Montgomery_basecase(
+        digit *result,
+        digit *product,
+        digit const *modulus,
+        size_t size,
+        digit digit_inverse) noexcept
+    {
+        digit carry = 0;
+        for (size_t i = 0; i < size; ++i)
+        {
+            digit const high_carry = add_multiplied_by_digit(product + i, modulus, size, product[i] * digit_inverse);
+            digit sum = product[i + size] + carry;
+            carry = sum < carry;
+            sum += high_carry;
+            carry += sum < high_carry;
+            product[i + size] = sum;
+        }
+
+        subtract_modulus_once(result, product + size, carry, modulus, size);
+    }
+
+    // as reduce_Montgomery_basecase, with inverse = -modulus^-1 modulo 2^(64 * size) turning the digit by digit steps
+    // into two products: (product + (product * inverse modulo 2^(64 * size)) * modulus) / 2^(64 * size);
+    // scratch gets 4 * size digits
+    void reduce_Montgomery(
+        digit *result,
+        digit const *product,
+        digit const *modulus,
+        digit const *inverse,
+        size_t size,
+        digit *scratch)
+    {
+        digit *quotient = scratch;
+        digit *multiple = scratch + 2 * size;
+        multiply_digits_automatic(quotient, product, size, inverse, size);
+        multiply_digits_automatic(multiple, quotient, size, modulus, size);
+
+        // the low halves add up to zero or to exactly 2^(64 * size)
+        digit carry = add_digits(multiple + size, multiple + size, product + size, size);
+        carry += add_digit(multiple + size, multiple + size, size, normalized_size(product, size) != 0
+            ? 1
+            : 0);
+
+        subtract_modulus_once(result, multiple + size, carry, modulus, size);
+    }
+
+    // result = product modulo modulus for a product of 2 * size digits, which is destroyed;
+    // reciprocal = min(floor(2^(128 * size) / modulus), 2^(64 * (size + 1)) - 1) zero padded to size + 1 digits,
+    // scratch gets 4 * size + 4 digits
+    void reduce_Barrett(
+        digit *result,
+        digit *product,
+        digit const *modulus,
+        digit const *reciprocal,
+        size_t size,
+        digit *scratch)
+    {
+        // floor(floor(product / 2^(64 * (size - 1))) * reciprocal / 2^(64 * (size + 1))) falls short of the quotient by 2 at most,
+        // by 3 for the clamped reciprocal of a power of the radix
+        digit *estimate = scratch;
+        digit *multiple = scratch + 2 * size + 2;
+        multiply_digits_automatic(estimate, product + size - 1, size + 1, reciprocal, size + 1);
+        multiply_digits_automatic(multiple, estimate + size + 1, size + 1, modulus, size);
+
+        // the remainder is below 4 * modulus, so its low size + 1 digits are enough
+        subtract_digits(product, product, multiple, size + 1);
+        while (product[size] != 0 || compare_digits(product, modulus, size) >= 0)
+        {
+            product[size] -= subtract_digits(product, product, modulus, size);
+        }
+
+        std::copy(product, product + size, result);
+    }
+
+    // the table of 2^(bits - 1) odd powers pays off against the products it saves from these exponent lengths on
+    size_t sliding_window_bits(
+        size_t exponent_bits) noexcept
+    {
+        size_t const thresholds[] = { 7, 25, 81, 241, 673 };
+
+        size_t bits = 1;
+        for (auto const threshold: thresholds)
+        {
+            if (exponent_bits > threshold)
+            {
+                ++bits;
+            }
+        }
+        return bits;
+    }
+
+    // endregion modular arithmetic
+
+}
+
+constexpr size_t big_integer::inline_digits_count;
+
+big_integer &big_integer::trivial_multiplication::multiply(
+    big_integer &first_multiplier,
+    big_integer const &second_multiplier) const
+{
+    return first_multiplier.assign_product(first_multiplier, second_multiplier, big_integer::multiplication_rule::trivial);
+}
+
+big_integer &big_integer::Karatsuba_multiplication::multiply(
+    big_integer &first_multiplier,
+    big_integer const &second_multiplier) const
+{
+    return first_multiplier.assign_product(first_multiplier, second_multiplier, big_integer::multiplication_rule::Karatsuba);
+}
+
+big_integer &big_integer::Toom_Cook_3_multiplication::multiply(
+    big_integer &first_multiplier,
+    big_integer const &second_multiplier) const
+{
+    return first_multiplier.assign_product(first_multiplier, second_multiplier, big_integer::multiplication_rule::ToomCook3);
+}
+
+big_integer &big_integer::Toom_Cook_4_multiplication::multiply(
+    big_integer &first_multiplier,
+    big_integer const &second_multiplier) const
+{
+    return first_multiplier.assign_product(first_multiplier, second_multiplier, big_integer::multiplication_rule::ToomCook4);
+}
+
+big_integer &big_integer::Schonhage_Strassen_multiplication::multiply(
+    big_integer &first_multiplier,
+    big_integer const &second_multiplier) const
+{
+    return first_multiplier.assign_product(first_multiplier, second_multiplier, big_integer::multiplication_rule::SchonhageStrassen);
+}
+
+big_integer &big_integer::NTT_multiplication::multiply(
+    big_integer &first_multiplier,
+    big_integer const &second_multiplier) const
+{
+    return first_multiplier.assign_product(first_multiplier, second_multiplier, big_integer::multiplication_rule::NTT);
+}
+
+big_integer &big_integer::automatic_multiplication::multiply(
+    big_integer &first_multiplier,
+    big_integer const &second_multiplier) const
+{
+    return first_multiplier.assign_product(first_multiplier, second_multiplier, big_integer::multiplication_rule::automatic);
+}
+
+namespace
+{
+
+    // products of the fused multiply-add operations of a thread, grows but never shrinks
+    digit *get_product_scratch(
+        size_t size)
+    {
+        thread_local magnitude scratch;
+        if (scratch.size() < size)
+        {
+            scratch.resize(size);
+        }
+        return scratch.data();
+    }
+
+    digits_multiplication get_digits_multiplication(
+        big_integer::multiplication_rule multiplication_rule) noexcept
+    {
+        switch (multiplication_rule)
+        {
+            case big_integer::multiplication_rule::Karatsuba:
+                return multiply_digits_Karatsuba;
+            case big_integer::multiplication_rule::ToomCook3:
+                return multiply_digits_Toom_Cook_3;
+            case big_integer::multiplication_rule::ToomCook4:
+                return multiply_digits_Toom_Cook_4;
+            case big_integer::multiplication_rule::SchonhageStrassen:
+                return multiply_digits_Schonhage_Strassen;
+            case big_integer::multiplication_rule::NTT:
+                return multiply_digits_NTT;
+            case big_integer::multiplication_rule::automatic:
+                return multiply_digits_automatic;
+            default:
+                return multiply_digits_trivial;
+        }
+    }
+
+}
+
+big_integer &big_integer::trivial_division::divide(
+    big_integer &dividend,
+    big_integer const &divisor,
+    big_integer::multiplication_rule multiplication_rule) const
+{
+    if (compare_magnitudes(dividend, divisor) < 0)
+    {
+        dividend.clear();
+        return dividend;
+    }
+
+    // the quotient replaces the dividend digits, divisor may be the dividend itself
+    bool const is_negative = dividend._is_negative != divisor._is_negative;
+    divide_digits_trivial(dividend._digits, nullptr, dividend._digits, dividend._digits_count, divisor._digits, divisor._digits_count);
+    dividend._is_negative = is_negative;
+    dividend.set_digits_count(dividend._digits_count - divisor._digits_count + 1);
+
+    return dividend;
+}
+
+big_integer &big_integer::trivial_division::modulo(
+    big_integer &dividend,
+    big_integer const &divisor,
+    big_integer::multiplication_rule multiplication_rule) const
+{
+    if (compare_magnitudes(dividend, divisor) < 0)
+    {
+        return dividend;
+    }
+
+    size_t const divisor_size = divisor._digits_count;
+    divide_digits_trivial(nullptr, dividend._digits, dividend._digits, dividend._digits_count, divisor._digits, divisor_size);
+    dividend.set_digits_count(divisor_size);
+
+    return dividend;
+}
+
+void big_integer::trivial_division::divmod(
+    big_integer &dividend,
+    big_integer const &divisor,
+    big_integer &remainder,
+    big_integer::multiplication_rule multiplication_rule) const
+{
+    if (compare_magnitudes(dividend, divisor) < 0)
+    {
+        remainder.assign(dividend._digits, dividend._digits_count, dividend._is_negative);
+        dividend.clear();
+        return;
+    }
+
+    // a remainder being the divisor already has room for it, so the divisor digits stay in place until they are read
+    size_t const dividend_size = dividend._digits_count;
+    size_t const divisor_size = divisor._digits_count;
+    bool const is_negative = dividend._is_negative;
+    bool const quotient_is_negative = is_negative != divisor._is_negative;
+    remainder.ensure_capacity(divisor_size);
+    divide_digits_trivial(dividend._digits, remainder._digits, dividend._digits, dividend_size, divisor._digits, divisor_size);
+
+    dividend._is_negative = quotient_is_negative;
+    dividend.set_digits_count(dividend_size - divisor_size + 1);
+    remainder._is_negative = is_negative;
+    remainder.set_digits_count(divisor_size);
+}
+
+big_integer &big_integer::Newton_division::divide(
+    big_integer &dividend,
+    big_integer const &divisor,
+    big_integer::multiplication_rule multiplication_rule) const
+{
+    if (divisor._digits_count < Newton_threshold)
+    {
+        return trivial_division().divide(dividend, divisor, multiplication_rule);
+    }
+
+    magnitude quotient;
+    divide_Newton(
+        make_magnitude(dividend._digits, dividend._digits_count),
+        make_magnitude(divisor._digits, divisor._digits_count),
+        &quotient,
+        nullptr,
+        get_digits_multiplication(multiplication_rule));
+    dividend.assign(quotient.data(), quotient.size(), dividend._is_negative != divisor._is_negative);
+
+    return dividend;
+}
+
+big_integer &big_integer::Newton_division::modulo(
+    big_integer &dividend,
+    big_integer const &divisor,
+    big_integer::multiplication_rule multiplication_rule) const
+{
+    if (divisor._digits_count < Newton_threshold)
+    {
+        return trivial_division().modulo(dividend, divisor, multiplication_rule);
+    }
+
+    magnitude remainder;
+    divide_Newton(
+        make_magnitude(dividend._digits, dividend._digits_count),
+        make_magnitude(divisor._digits, divisor._digits_count),
+        nullptr,
+        &remainder,
+        get_digits_multiplication(multiplication_rule));
+    dividend.assign(remainder.data(), remainder.size(), dividend._is_negative);
+
+    return dividend;
+}
+
+void big_integer::Newton_division::divmod(
+    big_integer &dividend,
+    big_integer const &divisor,
+    big_integer &remainder,
+    big_integer::multiplication_rule multiplication_rule) const
+{
+    if (divisor._digits_count < Newton_threshold)
+    {
+        trivial_division().divmod(dividend, divisor, remainder, multiplication_rule);
+        return;
+    }
+
+    magnitude quotient_digits, remainder_digits;
+    divide_Newton(
+        make_magnitude(dividend._digits, dividend._digits_count),
+        make_magnitude(divisor._digits, divisor._digits_count),
+        &quotient_digits,
+        &remainder_digits,
+        get_digits_multiplication(multiplication_rule));
+
+    bool const is_negative = dividend._is_negative;
+    dividend.assign(quotient_digits.data(), quotient_digits.size(), is_negative != divisor._is_negative);
+    remainder.assign(remainder_digits.data(), remainder_digits.size(), is_negative);
+}
+
+big_integer &big_integer::Burnikel_Ziegler_division::divide(
+    big_integer &dividend,
+    big_integer const &divisor,
+    big_integer::multiplication_rule multiplication_rule) const
+{
+    if (divisor._digits_count < Burnikel_Ziegler_threshold)
+    {
+        return trivial_division().divide(dividend, divisor, multiplication_rule);
+    }
+
+    magnitude quotient;
+    divide_Burnikel_Ziegler(
+        make_magnitude(dividend._digits, dividend._digits_count),
+        make_magnitude(divisor._digits, divisor._digits_count),
+        &quotient,
+        nullptr,
+        get_digits_multiplication(multiplication_rule));
+    dividend.assign(quotient.data(), quotient.size(), dividend._is_negative != divisor._is_negative);
+
+    return dividend;
+}
+
+big_integer &big_integer::Burnikel_Ziegler_division::modulo(
+    big_integer &dividend,
+    big_integer const &divisor,
+    big_integer::multiplication_rule multiplication_rule) const
+{
+    if (divisor._digits_count < Burnikel_Ziegler_threshold)
+    {
+        return trivial_division().modulo(dividend, divisor, multiplication_rule);
+    }
+
+    magnitude remainder;
+    divide_Burnikel_Ziegler(
+        make_magnitude(dividend._digits, dividend._digits_count),
+        make_magnitude(divisor._digits, divisor._digits_count),
+        nullptr,
+        &remainder,
+        get_digits_multiplication(multiplication_rule));
+    dividend.assign(remainder.data(), remainder.size(), dividend._is_negative);
+
+    return dividend;
+}
+
+void big_integer::Burnikel_Ziegler_division::divmod(
+    big_integer &dividend,
+    big_integer const &divisor,
+    big_integer &remainder,
+    big_integer::multiplication_rule multiplication_rule) const
+{
+    if (divisor._digits_count < Burnikel_Ziegler_threshold)
+    {
+        trivial_division().divmod(dividend, divisor, remainder, multiplication_rule);
+        return;
+    }
+
+    magnitude quotient_digits, remainder_digits;
+    divide_Burnikel_Ziegler(
+        make_magnitude(dividend._digits, dividend._digits_count),
+        make_magnitude(divisor._digits, divisor._digits_count),
+        &quotient_digits,
+        &remainder_digits,
+        get_digits_multiplication(multiplication_rule));
+
+    bool const is_negative = dividend._is_negative;
+    dividend.assign(quotient_digits.data(), quotient_digits.size(), is_negative != divisor._is_negative);
+    remainder.assign(remainder_digits.data(), remainder_digits.size(), is_negative);
+}
+
+big_integer::big_integer(
+    int const *digits,
+    size_t digits_count,
+    allocator *allocator):
+        _is_negative(false),
+        _digits_count(0),
+        _digits_capacity(inline_digits_count),
+        _digits(_inline_digits),
+        _allocator(allocator)
+{
+    if (digits == nullptr || digits_count == 0)
+    {
+        return;
+    }
+
+    // 32-bit two's complement digits, the last one is the oldest (signed) one
+    std::vector<uint32_t> value(digits_count);
+    for (size_t i = 0; i < digits_count; ++i)
+    {
+        value[i] = static_cast<uint32_t>(digits[i]);
+    }
+
+    bool const is_negative = digits[digits_count - 1] < 0;
+    if (is_negative)
+    {
+        uint32_t carry = 1;
+        for (auto &value_digit: value)
+        {
+            value_digit = ~value_digit + carry;
+            carry = carry != 0 && value_digit == 0;
+        }
+    }
+
+    magnitude result((digits_count + 1) / 2, 0);
+    for (size_t i = 0; i < digits_count; ++i)
+    {
+        result[i / 2] |= static_cast<digit>(value[i]) << (32 * (i % 2));
+    }
+
+    assign(result.data(), result.size(), is_negative);
+}
+
+big_integer::big_integer(
+    std::vector<int> const &digits,
+    allocator *allocator):
+        big_integer(digits.data(), digits.size(), allocator)
+{
+
+}
+
+big_integer::big_integer(
+    std::string const &value_as_string,
+    size_t base,
+    allocator *allocator):
+        _is_negative(false),
+        _digits_count(0),
+        _digits_capacity(inline_digits_count),
+        _digits(_inline_digits),
+        _allocator(allocator)
+{
+    if (base < 2 || base > 36)
+    {
+        throw std::invalid_argument("base must be in range [2, 36]");
+    }
+
+    size_t position = 0;
+    bool is_negative = false;
+    if (position < value_as_string.size() && (value_as_string[position] == '-' || value_as_string[position] == '+'))
+    {
+        is_negative = value_as_string[position++] == '-';
+    }
+
+    if (position == value_as_string.size())
+    {
+        throw std::invalid_argument("\"" + value_as_string + "\" is not a number");
+    }
+
+    for (size_t i = position; i < value_as_string.size(); ++i)
+    {
+        if (digit_value(value_as_string[i]) >= base)
+        {
+            throw std::invalid_argument("\"" + value_as_string + "\" is not a number in base " + std::to_string(base));
+        }
+    }
+
+    char const *begin = value_as_string.data() + position;
+    char const *end = value_as_string.data() + value_as_string.size();
+    size_t const bits = power_of_two_base_bits(base);
+    magnitude const result = bits == 0
+        ? parse_digits(begin, end, base)
+        : parse_power_of_two_digits(begin, end, bits);
+
+    assign(result.data(), result.size(), is_negative);
+}
+
+big_integer::big_integer(
+    uint64_t magnitude,
+    bool is_negative,
+    allocator *allocator):
+        big_integer(&magnitude, magnitude == 0
+            ? 0
+            : 1, is_negative, allocator)
+{
+
+}
+
+big_integer::big_integer(
+    digit_t const *digits,
+    size_t digits_count,
+    bool is_negative,
+    allocator *allocator):
+        _is_negative(false),
+        _digits_count(0),
+        _digits_capacity(inline_digits_count),
+        _digits(_inline_digits),
+        _allocator(allocator)
+{
+    assign(digits, digits_count, is_negative);
+}
+
+big_integer::~big_integer()
+{
+    release_digits();
+}
+
+big_integer::big_integer(
+    big_integer const &other):
+        big_integer(other._digits, other._digits_count, other._is_negative, other._allocator)
+{
+
+}
+
+big_integer &big_integer::operator=(
+    big_integer const &other)
+{
+    if (this != &other)
+    {
+        if (_allocator != other._allocator)
+        {
+            release_digits();
+            _allocator = other._allocator;
+        }
+
+        assign(other._digits, other._digits_count, other._is_negative);
+    }
+
+    return *this;
+}
+
+big_integer::big_integer(
+    big_integer &&other) noexcept:
+        _is_negative(false),
+        _digits_count(0),
+        _digits_capacity(inline_digits_count),
+        _digits(_inline_digits),
+        _allocator(other._allocator)
+{
+    *this = std::move(other);
+}
+
+big_integer &big_integer::operator=(
+    big_integer &&other) noexcept
+{
+    if (this != &other)
+    {
+        release_digits();
+        _allocator = other._allocator;
+
+        if (other._digits == other._inline_digits)
+        {
+            std::memcpy(_inline_digits, other._inline_digits, other._digits_count * sizeof(digit_t));
+        }
+        else
+        {
+            _digits = other._digits;
+            _digits_capacity = other._digits_capacity;
+
+            other._digits = other._inline_digits;
+            other._digits_capacity = inline_digits_count;
+        }
+
+        _is_negative = other._is_negative;
+        _digits_count = other._digits_count;
+
+        other._is_negative = false;
+        other._digits_count = 0;
+    }
+
+    return *this;
+}
+
+bool big_integer::operator==(
+    big_integer const &other) const
+{
+    return _is_negative == other._is_negative && compare_magnitudes(*this, other) == 0;
+}
+
+bool big_integer::operator!=(
+    big_integer const &other) const
+{
+    return !(*this == other);
+}
+
+bool big_integer::operator<(
+    big_integer const &other) const
+{
+    if (_is_negative != other._is_negative)
+    {
+        return _is_negative;
+    }
+
+    int const magnitudes_comparison = compare_magnitudes(*this, other);
+    return _is_negative
+        ? magnitudes_comparison > 0
+        : magnitudes_comparison < 0;
+}
+
+bool big_integer::operator>(
+    big_integer const &other) const
+{
+    return other < *this;
+}
+
+bool big_integer::operator<=(
+    big_integer const &other) const
+{
+    return !(other < *this);
+}
+
+bool big_integer::operator>=(
+    big_integer const &other) const
+{
+    return !(*this < other);
+}
+
+big_integer big_integer::operator-() const
+{
+    return big_integer(_digits, _digits_count, !_is_negative, _allocator);
+}
+
+big_integer &big_integer::operator+=(
+    big_integer const &other)
+{
+    return assign_sum(*this, other, other._is_negative);
+}
+
+big_integer big_integer::operator+(
+    big_integer const &other) const
+{
+    big_integer result(nullptr, 0, false, _allocator);
+    result.assign_sum(*this, other, other._is_negative);
+    return result;
+}
+
+big_integer big_integer::operator+(
+    std::pair<big_integer, allocator *> const &other) const
+{
+    big_integer result(nullptr, 0, false, other.second);
+    result.assign_sum(*this, other.first, other.first._is_negative);
+    return result;
+}
+
+big_integer &big_integer::operator-=(
+    big_integer const &other)
+{
+    return assign_sum(*this, other, !other._is_negative);
+}
+
+big_integer big_integer::operator-(
+    big_integer const &other) const
+{
+    big_integer result(nullptr, 0, false, _allocator);
+    result.assign_sum(*this, other, !other._is_negative);
+    return result;
+}
+
+big_integer big_integer::operator-(
+    std::pair<big_integer, allocator *> const &other) const
+{
+    big_integer result(nullptr, 0, false, other.second);
+    result.assign_sum(*this, other.first, !other.first._is_negative);
+    return result;
+}
+
+big_integer &big_integer::operator*=(
+    big_integer const &other)
+{
+    return multiply(*this, other);
+}
+
+big_integer big_integer::operator*(
+    big_integer const &other) const
+{
+    return multiply(*this, other, _allocator);
+}
+
+big_integer big_integer::operator*(
+    std::pair<big_integer, allocator *> const &other) const
+{
+    return multiply(*this, other.first, other.second);
+}
+
+big_integer &big_integer::operator/=(
+    big_integer const &other)
+{
+    return divide(*this, other);
+}
+
+big_integer big_integer::operator/(
+    big_integer const &other) const
+{
+    return divide(*this, other, _allocator);
+}
+
+big_integer big_integer::operator/(
+    std::pair<big_integer, allocator *> const &other) const
+{
+    return divide(*this, other.first, other.second);
+}
+
+big_integer &big_integer::operator%=(
+    big_integer const &other)
+{
+    return modulo(*this, other);
+}
+
+big_integer big_integer::operator%(
+    big_integer const &other) const
+{
+    return modulo(*this, other, _allocator);
+}
+
+big_integer big_integer::operator%(
+    std::pair<big_integer, allocator *> const &other) const
+{
+    return modulo(*this, other.first, other.second);
+}
+
+big_integer big_integer::operator~() const
+{
+    // two's complement: ~x == -(x + 1)
+    digit_t const one_digit = 1;
+    big_integer const one(&one_digit, 1, false, _allocator);
+
+    big_integer result(nullptr, 0, false, _allocator);
+    result.assign_sum(*this, one, false);
+    result._is_negative = !result._is_negative && !result.is_zero();
+    return result;
+}
+
+big_integer &big_integer::operator&=(
+    big_integer const &other)
+{
+    return apply_bitwise(other, '&');
+}
+
+big_integer big_integer::operator&(
+    big_integer const &other) const
+{
+    return big_integer(*this) &= other;
+}
+
+big_integer big_integer::operator&(
+    std::pair<big_integer, allocator *> const &other) const
+{
+    return big_integer(_digits, _digits_count, _is_negative, other.second) &= other.first;
+}
 
-big_integer &big_integer::trivial_multiplication::multiply(
-    big_integer &first_multiplier,
-    big_integer const &second_multiplier) const
+big_integer &big_integer::operator|=(
+    big_integer const &other)
 {
-    throw not_implemented("big_integer &big_integer::trivial_multiplication::multiply(big_integer &, big_integer const &)", "your code should be here...");
+    return apply_bitwise(other, '|');
 }
 
-big_integer &big_integer::Karatsuba_multiplication::multiply(
-    big_integer &first_multiplier,
-    big_integer const &second_multiplier) const
+big_integer big_integer::operator|(
+    big_integer const &other) const
 {
-    throw not_implemented("big_integer &big_integer::Karatsuba_multiplication::multiply(big_integer &, big_integer const &)", "your code should be here...");
+    return big_integer(*this) |= other;
 }
 
-big_integer &big_integer::Schonhage_Strassen_multiplication::multiply(
+big_integer big_integer::operator|(
+    std::pair<big_integer, allocator *> const &other) const
+{
+    return big_integer(_digits, _digits_count, _is_negative, other.second) |= other.first;
+}
+
+big_integer &big_integer::operator^=(
+    big_integer const &other)
+{
+    return apply_bitwise(other, '^');
+}
+
+big_integer big_integer::operator^(
+    big_integer const &other) const
+{
+    return big_integer(*this) ^= other;
+}
+
+big_integer big_integer::operator^(
+    std::pair<big_integer, allocator *> const &other) const
+{
+    return big_integer(_digits, _digits_count, _is_negative, other.second) ^= other.first;
+}
+
+big_integer &big_integer::operator<<=(
+    size_t shift)
+{
+    if (is_zero() || shift == 0)
+    {
+        return *this;
+    }
+
+    size_t const digits_shift = shift / digit_bits;
+    size_t const bits_shift = shift % digit_bits;
+    size_t const size = _digits_count;
+
+    ensure_capacity(size + digits_shift + 1);
+
+    if (bits_shift == 0)
+    {
+        std::memmove(_digits + digits_shift, _digits, size * sizeof(digit_t));
+        _digits[size + digits_shift] = 0;
+    }
+    else
+    {
+        _digits[size + digits_shift] = shift_left_digits(_digits + digits_shift, _digits, size, bits_shift);
+    }
+    std::fill(_digits, _digits + digits_shift, 0);
+
+    set_digits_count(size + digits_shift + 1);
+
+    return *this;
+}
+
+big_integer big_integer::operator<<(
+    size_t shift) const
+{
+    return big_integer(*this) <<= shift;
+}
+
+big_integer big_integer::operator<<(
+    std::pair<size_t, allocator *> const &shift) const
+{
+    return big_integer(_digits, _digits_count, _is_negative, shift.second) <<= shift.first;
+}
+
+big_integer &big_integer::operator>>=(
+    size_t shift)
+{
+    if (is_zero() || shift == 0)
+    {
+        return *this;
+    }
+
+    size_t const digits_shift = shift / digit_bits;
+    size_t const bits_shift = shift % digit_bits;
+
+    // arithmetic shift rounds towards minus infinity, so negative values lose one more unit when any one bits go out
+    bool shifted_out_nonzero = false;
+    if (_is_negative)
+    {
+        for (size_t i = 0; i < std::min(digits_shift, _digits_count) && !shifted_out_nonzero; ++i)
+        {
+            shifted_out_nonzero = _digits[i] != 0;
+        }
+        if (digits_shift < _digits_count && bits_shift != 0)
+        {
+            shifted_out_nonzero = shifted_out_nonzero || (_digits[digits_shift] & ((digit(1) << bits_shift) - 1)) != 0;
+        }
+    }
+
+    if (digits_shift >= _digits_count)
+    {
+        if (_is_negative)
+        {
+            _digits[0] = 1;
+            _digits_count = 1;
+        }
+        else
+        {
+            clear();
+        }
+        return *this;
+    }
+
+    size_t size = _digits_count - digits_shift;
+    if (bits_shift == 0)
+    {
+        std::memmove(_digits, _digits + digits_shift, size * sizeof(digit_t));
+    }
+    else
+    {
+        shift_right_digits(_digits, _digits + digits_shift, size, bits_shift);
+    }
+
+    if (shifted_out_nonzero)
+    {
+        digit const carry = add_digit(_digits, _digits, size, 1);
+        if (carry != 0)
+        {
+            ensure_capacity(size + 1);
+            _digits[size++] = carry;
+        }
+    }
+
+    set_digits_count(size);
+
+    return *this;
+}
+
+big_integer big_integer::operator>>(
+    size_t shift) const
+{
+    return big_integer(*this) >>= shift;
+}
+
+big_integer big_integer::operator>>(
+    std::pair<size_t, allocator *> const &shift) const
+{
+    return big_integer(_digits, _digits_count, _is_negative, shift.second) >>= shift.first;
+}
+
+big_integer &big_integer::multiply(
     big_integer &first_multiplier,
-    big_integer const &second_multiplier) const
+    big_integer const &second_multiplier,
+    allocator *allocator,
+    big_integer::multiplication_rule multiplication_rule)
 {
-    throw not_implemented("big_integer &big_integer::Schonhage_Strassen_multiplication::multiply(big_integer &, big_integer const &)", "your code should be here...");
+    // the result stays in the first multiplier, which keeps its own allocator
+    return multiply_with_rule(first_multiplier, second_multiplier, multiplication_rule);
 }
 
-big_integer &big_integer::trivial_division::divide(
+big_integer big_integer::multiply(
+    big_integer const &first_multiplier,
+    big_integer const &second_multiplier,
+    allocator *allocator,
+    big_integer::multiplication_rule multiplication_rule)
+{
+    big_integer result(first_multiplier._digits, first_multiplier._digits_count, first_multiplier._is_negative, allocator);
+    // a value multiplied by itself goes through the squaring paths
+    multiply_with_rule(result, &first_multiplier == &second_multiplier
+        ? result
+        : second_multiplier, multiplication_rule);
+    return result;
+}
+
+big_integer &big_integer::square(
+    big_integer &value,
+    allocator *allocator,
+    big_integer::multiplication_rule multiplication_rule)
+{
+    return multiply_with_rule(value, value, multiplication_rule);
+}
+
+big_integer big_integer::square(
+    big_integer const &value,
+    allocator *allocator,
+    big_integer::multiplication_rule multiplication_rule)
+{
+    big_integer result(value._digits, value._digits_count, value._is_negative, allocator);
+    multiply_with_rule(result, result, multiplication_rule);
+    return result;
+}
+
+big_integer &big_integer::pow(
+    big_integer &value,
+    size_t degree,
+    allocator *allocator,
+    big_integer::multiplication_rule multiplication_rule)
+{
+    if (degree == 0)
+    {
+        digit_t const one = 1;
+        value.assign(&one, 1, false);
+        return value;
+    }
+    if (value.is_zero() || degree == 1)
+    {
+        return value;
+    }
+
+    bool const is_negative = value._is_negative && degree % 2 == 1;
+    size_t const zero_bits = value.trailing_zero_bits_count();
+
+    value._is_negative = false;
+    value >>= zero_bits;
+
+    if (value._digits_count != 1 || value._digits[0] != 1)
+    {
+        big_integer const base(value._digits, value._digits_count, false, nullptr);
+        size_t mask = 1;
+        while (mask <= degree / 2)
+        {
+            mask <<= 1;
+        }
+
+        for (mask >>= 1; mask != 0; mask >>= 1)
+        {
+            multiply_with_rule(value, value, multiplication_rule);
+            if ((degree & mask) != 0)
+            {
+                multiply_with_rule(value, base, multiplication_rule);
+            }
+        }
+    }
+
+    value <<= zero_bits * degree;
+    value._is_negative = is_negative;
+    return value;
+}
+
+big_integer big_integer::pow(
+    big_integer const &value,
+    size_t degree,
+    allocator *allocator,
+    big_integer::multiplication_rule multiplication_rule)
+{
+    big_integer result(value._digits, value._digits_count, value._is_negative, allocator);
+    pow(result, degree, allocator, multiplication_rule);
+    return result;
+}
+
+big_integer &big_integer::isqrt(
+    big_integer &value,
+    allocator *allocator,
+    big_integer::multiplication_rule multiplication_rule)
+{
+    return iroot(value, 2, allocator, multiplication_rule);
+}
+
+big_integer big_integer::isqrt(
+    big_integer const &value,
+    allocator *allocator,
+    big_integer::multiplication_rule multiplication_rule)
+{
+    return iroot(value, 2, allocator, multiplication_rule);
+}
+
+big_integer &big_integer::iroot(
+    big_integer &value,
+    size_t degree,
+    allocator *allocator,
+    big_integer::multiplication_rule multiplication_rule)
+{
+    throw_if_invalid_root(value, degree);
+    if (degree == 1)
+    {
+        return value;
+    }
+
+    big_integer root(nullptr, 0, false, nullptr);
+    assign_root(root, value, degree, multiplication_rule);
+    value.assign(root._digits, root._digits_count, value._is_negative);
+    return value;
+}
+
+big_integer big_integer::iroot(
+    big_integer const &value,
+    size_t degree,
+    allocator *allocator,
+    big_integer::multiplication_rule multiplication_rule)
+{
+    throw_if_invalid_root(value, degree);
+    if (degree == 1)
+    {
+        return big_integer(value._digits, value._digits_count, value._is_negative, allocator);
+    }
+
+    big_integer result(nullptr, 0, false, allocator);
+    assign_root(result, value, degree, multiplication_rule);
+    result._is_negative = value._is_negative && !result.is_zero();
+    return result;
+}
+
+void big_integer::reserve(
+    size_t bits_count)
+{
+    size_t const digits_count = bits_count / digit_bits + (bits_count % digit_bits != 0
+        ? 1
+        : 0);
+    if (digits_count > _digits_capacity)
+    {
+        reallocate_digits(digits_count);
+    }
+}
+
+size_t big_integer::capacity() const noexcept
+{
+    return _digits_capacity * digit_bits;
+}
+
+void big_integer::shrink_to_fit()
+{
+    if (_digits != _inline_digits && _digits_capacity > _digits_count)
+    {
+        reallocate_digits(_digits_count);
+    }
+}
+
+size_t big_integer::bit_length() const noexcept
+{
+    return is_zero()
+        ? 0
+        : _digits_count * digit_bits - leading_zero_bits(_digits[_digits_count - 1]);
+}
+
+size_t big_integer::trailing_zero_bits_count() const noexcept
+{
+    if (is_zero())
+    {
+        return 0;
+    }
+
+    size_t index = 0;
+    while (_digits[index] == 0)
+    {
+        ++index;
+    }
+    return index * digit_bits + trailing_zero_bits(_digits[index]);
+}
+
+big_integer big_integer::power_of_two(
+    size_t exponent,
+    allocator *allocator)
+{
+    magnitude digits(exponent / digit_bits + 1, 0);
+    digits.back() = digit(1) << (exponent % digit_bits);
+    return big_integer(digits.data(), digits.size(), false, allocator);
+}
+
+big_integer &big_integer::assign_product(
+    big_integer const &first_multiplier,
+    big_integer const &second_multiplier,
+    big_integer::multiplication_rule multiplication_rule)
+{
+    if (first_multiplier.is_zero() || second_multiplier.is_zero())
+    {
+        clear();
+        return *this;
+    }
+
+    size_t const product_size = first_multiplier._digits_count + second_multiplier._digits_count;
+    bool const is_negative = first_multiplier._is_negative != second_multiplier._is_negative;
+    auto const multiplication = get_digits_multiplication(multiplication_rule);
+
+    if (this == &first_multiplier || this == &second_multiplier)
+    {
+        digit_t *product = get_product_scratch(product_size);
+        multiplication(product, first_multiplier._digits, first_multiplier._digits_count, second_multiplier._digits, second_multiplier._digits_count);
+        assign(product, product_size, is_negative);
+        return *this;
+    }
+
+    // the own digits aren't an operand, so the product is written straight into them
+    _digits_count = 0;
+    ensure_capacity(product_size);
+    multiplication(_digits, first_multiplier._digits, first_multiplier._digits_count, second_multiplier._digits, second_multiplier._digits_count);
+    _is_negative = is_negative;
+    set_digits_count(product_size);
+    return *this;
+}
+
+big_integer &big_integer::add_product(
+    big_integer const &first_multiplier,
+    big_integer const &second_multiplier,
+    big_integer::multiplication_rule multiplication_rule)
+{
+    return accumulate_product(first_multiplier, second_multiplier, false, multiplication_rule);
+}
+
+big_integer &big_integer::subtract_product(
+    big_integer const &first_multiplier,
+    big_integer const &second_multiplier,
+    big_integer::multiplication_rule multiplication_rule)
+{
+    return accumulate_product(first_multiplier, second_multiplier, true, multiplication_rule);
+}
+
+big_integer &big_integer::divide(
     big_integer &dividend,
     big_integer const &divisor,
-    big_integer::multiplication_rule multiplication_rule) const
+    allocator *allocator,
+    big_integer::division_rule division_rule,
+    big_integer::multiplication_rule multiplication_rule)
 {
-    throw not_implemented("big_integer &big_integer::trivial_division::divide(big_integer &, big_integer const &, big_integer::multiplication_rule)", "your code should be here...");
+    throw_if_division_by_zero(divisor);
+
+    return get_division(division_rule).divide(dividend, divisor, multiplication_rule);
 }
 
-big_integer &big_integer::trivial_division::modulo(
-    big_integer &dividend,
+big_integer big_integer::divide(
+    big_integer const &dividend,
     big_integer const &divisor,
-    big_integer::multiplication_rule multiplication_rule) const
+    allocator *allocator,
+    big_integer::division_rule division_rule,
+    big_integer::multiplication_rule multiplication_rule)
 {
-    throw not_implemented("big_integer &big_integer::trivial_division::modulo(big_integer &, big_integer const &, big_integer::multiplication_rule)", "your code should be here...");
+    throw_if_division_by_zero(divisor);
+
+    big_integer result(dividend._digits, dividend._digits_count, dividend._is_negative, allocator);
+    get_division(division_rule).divide(result, divisor, multiplication_rule);
+    return result;
 }
 
-big_integer &big_integer::Newton_division::divide(
+big_integer &big_integer::modulo(
     big_integer &dividend,
     big_integer const &divisor,
-    big_integer::multiplication_rule multiplication_rule) const
+    allocator *allocator,
+    big_integer::division_rule division_rule,
+    big_integer::multiplication_rule multiplication_rule)
 {
-    throw not_implemented("big_integer &big_integer::Newton_division::divide(big_integer &, big_integer const &, big_integer::multiplication_rule)", "your code should be here...");
+    throw_if_division_by_zero(divisor);
+
+    return get_division(division_rule).modulo(dividend, divisor, multiplication_rule);
 }
 
-big_integer &big_integer::Newton_division::modulo(
-    big_integer &dividend,
+big_integer big_integer::modulo(
+    big_integer const &dividend,
     big_integer const &divisor,
-    big_integer::multiplication_rule multiplication_rule) const
+    allocator *allocator,
+    big_integer::division_rule division_rule,
+    big_integer::multiplication_rule multiplication_rule)
 {
-    throw not_implemented("big_integer &big_integer::Newton_division::modulo(big_integer &, big_integer const &, big_integer::multiplication_rule)", "your code should be here...");
+    throw_if_division_by_zero(divisor);
+
+    big_integer result(dividend._digits, dividend._digits_count, dividend._is_negative, allocator);
+    get_division(division_rule).modulo(result, divisor, multiplication_rule);
+    return result;
 }
 
-big_integer &big_integer::Burnikel_Ziegler_division::divide(
+big_integer &big_integer::divmod(
     big_integer &dividend,
     big_integer const &divisor,
-    big_integer::multiplication_rule multiplication_rule) const
+    big_integer &remainder,
+    big_integer::division_rule division_rule,
+    big_integer::multiplication_rule multiplication_rule)
+{
+    throw_if_division_by_zero(divisor);
+    if (&remainder == &dividend)
+    {
+        throw std::invalid_argument("remainder can't be the dividend");
+    }
+
+    get_division(division_rule).divmod(dividend, divisor, remainder, multiplication_rule);
+    return dividend;
+}
+
+std::pair<big_integer, big_integer> big_integer::divmod(
+    big_integer const &dividend,
+    big_integer const &divisor,
+    allocator *allocator,
+    big_integer::division_rule division_rule,
+    big_integer::multiplication_rule multiplication_rule)
+{
+    throw_if_division_by_zero(divisor);
+
+    std::pair<big_integer, big_integer> result(
+        big_integer(dividend._digits, dividend._digits_count, dividend._is_negative, allocator),
+        big_integer(nullptr, 0, false, allocator));
+    get_division(division_rule).divmod(result.first, divisor, result.second, multiplication_rule);
+    return result;
+}
+
+big_integer big_integer::gcd(
+    big_integer const &first,
+    big_integer const &second,
+    allocator *allocator,
+    big_integer::gcd_rule gcd_rule,
+    big_integer::multiplication_rule multiplication_rule)
+{
+    magnitude first_digits = make_magnitude(first._digits, first._digits_count);
+    magnitude second_digits = make_magnitude(second._digits, second._digits_count);
+    if (compare(first_digits, second_digits) < 0)
+    {
+        std::swap(first_digits, second_digits);
+    }
+
+    reduce_gcd(first_digits, second_digits, gcd_rule, nullptr, get_digits_multiplication(multiplication_rule));
+    return big_integer(first_digits.data(), first_digits.size(), false, allocator);
+}
+
+big_integer big_integer::extended_gcd(
+    big_integer const &first,
+    big_integer const &second,
+    big_integer &first_coefficient,
+    big_integer &second_coefficient,
+    allocator *allocator,
+    big_integer::gcd_rule gcd_rule,
+    big_integer::multiplication_rule multiplication_rule)
+{
+    magnitude first_digits = make_magnitude(first._digits, first._digits_count);
+    magnitude second_digits = make_magnitude(second._digits, second._digits_count);
+    bool const is_swapped = compare(first_digits, second_digits) < 0;
+    if (is_swapped)
+    {
+        std::swap(first_digits, second_digits);
+    }
+
+    gcd_matrix matrix = identity_gcd_matrix();
+    reduce_gcd(first_digits, second_digits, gcd_rule, &matrix, get_digits_multiplication(multiplication_rule));
+
+    big_integer result(first_digits.data(), first_digits.size(), false, allocator);
+    if (result.is_zero())
+    {
+        first_coefficient = result;
+        second_coefficient = result;
+        return result;
+    }
+
+    // gcd = entries[0] * the larger magnitude + entries[1] * the smaller one
+    signed_magnitude const &first_entry = matrix.entries[is_swapped
+        ? 1
+        : 0];
+    big_integer coefficient(first_entry.value.data(), first_entry.value.size(), first_entry.is_negative != first._is_negative, allocator);
+
+    if (second.is_zero())
+    {
+        first_coefficient = coefficient;
+        second_coefficient = big_integer(nullptr, 0, false, allocator);
+        return result;
+    }
+
+    // the coefficients of the other solutions differ by multiples of |second| / gcd and -first / gcd
+    big_integer const period = divide(big_integer(second._digits, second._digits_count, false, nullptr), result);
+    modulo(coefficient, period);
+    if (coefficient._is_negative)
+    {
+        coefficient += period;
+    }
+
+    big_integer other_coefficient = result;
+    other_coefficient.subtract_product(first, coefficient);
+    divide(other_coefficient, second);
+
+    first_coefficient = std::move(coefficient);
+    second_coefficient = std::move(other_coefficient);
+    return result;
+}
+
+big_integer::multiplication_thresholds big_integer::get_multiplication_thresholds() noexcept
+{
+    multiplication_thresholds thresholds{};
+    thresholds.Karatsuba = automatic_Karatsuba_threshold.load(std::memory_order_relaxed);
+    thresholds.Toom_Cook_3 = automatic_Toom_Cook_3_threshold.load(std::memory_order_relaxed);
+    thresholds.Toom_Cook_4 = automatic_Toom_Cook_4_threshold.load(std::memory_order_relaxed);
+    thresholds.Schonhage_Strassen = automatic_Schonhage_Strassen_threshold.load(std::memory_order_relaxed);
+    thresholds.NTT = automatic_NTT_threshold.load(std::memory_order_relaxed);
+    return thresholds;
+}
+
+void big_integer::set_multiplication_thresholds(
+    multiplication_thresholds const &thresholds)
 {
-    throw not_implemented("big_integer &big_integer::Burnikel_Ziegler_division::divide(big_integer &, big_integer const &, big_integer::multiplication_rule)", "your code should be here...");
+    if (thresholds.Karatsuba < 2
+        || thresholds.Toom_Cook_3 < thresholds.Karatsuba
+        || thresholds.Toom_Cook_4 < thresholds.Toom_Cook_3
+        || thresholds.Schonhage_Strassen < thresholds.Toom_Cook_4
+        || thresholds.NTT < thresholds.Schonhage_Strassen)
+    {
+        throw std::invalid_argument("multiplication thresholds must be non-decreasing, starting from at least 2");
+    }
+
+    automatic_Karatsuba_threshold.store(thresholds.Karatsuba, std::memory_order_relaxed);
+    automatic_Toom_Cook_3_threshold.store(thresholds.Toom_Cook_3, std::memory_order_relaxed);
+    automatic_Toom_Cook_4_threshold.store(thresholds.Toom_Cook_4, std::memory_order_relaxed);
+    automatic_Schonhage_Strassen_threshold.store(thresholds.Schonhage_Strassen, std::memory_order_relaxed);
+    automatic_NTT_threshold.store(thresholds.NTT, std::memory_order_relaxed);
+}
+
+big_integer::multiplication_parallelism big_integer::get_multiplication_parallelism() noexcept
+{
+    multiplication_parallelism parallelism{};
+    parallelism.threads_count = multiplication_threads_count.load(std::memory_order_relaxed);
+    parallelism.threshold = parallel_multiplication_threshold.load(std::memory_order_relaxed);
+    return parallelism;
+}
+
+void big_integer::set_multiplication_parallelism(
+    multiplication_parallelism const &parallelism)
+{
+    if (parallelism.threads_count == 0)
+    {
+        throw std::invalid_argument("multiplication needs at least one thread");
+    }
+
+    multiplication_threads_count.store(parallelism.threads_count, std::memory_order_relaxed);
+    parallel_multiplication_threshold.store(parallelism.threshold, std::memory_order_relaxed);
 }
 
-big_integer &big_integer::Burnikel_Ziegler_division::modulo(
-    big_integer &dividend,
-    big_integer const &divisor,
-    big_integer::multiplication_rule multiplication_rule) const
+big_integer::vectorization big_integer::get_supported_vectorization() noexcept
 {
-    throw not_implemented("big_integer &big_integer::Burnikel_Ziegler_division::modulo(big_integer &, big_integer const &, big_integer::multiplication_rule)", "your code should be here...");
+    return ::get_supported_vectorization();
 }
 
-big_integer::big_integer(
-    int const *digits,
-    size_t digits_count,
-    allocator *allocator)
+big_integer::vectorization big_integer::get_vectorization() noexcept
 {
-    throw not_implemented("big_integer::big_integer(int *, size_t, allocator *)", "your code should be here...");
+    return get_vectorization_state().load(std::memory_order_relaxed);
 }
 
-big_integer::big_integer(
-    std::vector<int> const &digits,
-    allocator *allocator)
+void big_integer::set_vectorization(
+    vectorization vectorization)
 {
-    throw not_implemented("big_integer::big_integer(std::vector<int> const &, allocator *)", "your code should be here...");
+    if (static_cast<int>(vectorization) > static_cast<int>(get_supported_vectorization()))
+    {
+        throw std::invalid_argument("vectorization isn't supported by the build or the processor");
+    }
+
+    get_vectorization_state().store(vectorization, std::memory_order_relaxed);
 }
 
-big_integer::big_integer(
-    std::string const &value_as_string,
-    size_t base,
-    allocator *allocator)
+std::string big_integer::to_string(
+    size_t base) const
 {
-    throw not_implemented("big_integer::big_integer(std::string const &, size_t, allocator *)", "your code should be here...");
+    if (base < 2 || base > 36)
+    {
+        throw std::invalid_argument("base must be in range [2, 36]");
+    }
+
+    if (is_zero())
+    {
+        return "0";
+    }
+
+    std::string const digits = format_magnitude(magnitude(_digits, _digits + _digits_count), base);
+    return _is_negative
+        ? "-" + digits
+        : digits;
 }
 
-big_integer::~big_integer()
+size_t big_integer::serialized_size(
+    big_integer::serialization_format format) const noexcept
 {
-    throw not_implemented("big_integer::~big_integer()", "your code should be here...");
+    unsigned char header[max_serialized_header_size];
+    return store_header(header, _is_negative, _digits_count, format) + _digits_count * sizeof(digit_t);
 }
 
-big_integer::big_integer(
-    big_integer const &other)
+size_t big_integer::serialize(
+    void *buffer,
+    size_t buffer_size,
+    big_integer::serialization_format format) const
 {
-    throw not_implemented("big_integer::big_integer(big_integer const &)", "your code should be here...");
+    size_t const size = serialized_size(format);
+    if (size > buffer_size)
+    {
+        throw std::length_error("buffer is too small for the serialized big integer");
+    }
+
+    auto *bytes = static_cast<unsigned char *>(buffer);
+    size_t const header_size = store_header(bytes, _is_negative, _digits_count, format);
+    store_digits(bytes + header_size, _digits, _digits_count);
+    return size;
 }
 
-big_integer &big_integer::operator=(
-    big_integer const &other)
+void big_integer::serialize(
+    std::ostream &stream,
+    big_integer::serialization_format format) const
 {
-    throw not_implemented("big_integer &big_integer::operator=(big_integer const &)", "your code should be here...");
+    unsigned char header[max_serialized_header_size];
+    size_t const header_size = store_header(header, _is_negative, _digits_count, format);
+    stream.write(reinterpret_cast<char const *>(header), static_cast<std::streamsize>(header_size));
+    write_digits(stream, _digits, _digits_count);
 }
 
-big_integer::big_integer(
-    big_integer &&other) noexcept
+big_integer big_integer::deserialize(
+    void const *buffer,
+    size_t buffer_size,
+    size_t &bytes_read,
+    big_integer::serialization_format format,
+    allocator *allocator)
 {
-    throw not_implemented("big_integer::big_integer(big_integer &&other) noexcept", "your code should be here...");
+    auto const *bytes = static_cast<unsigned char const *>(buffer);
+    bool is_negative = false;
+    uint64_t digits_count = 0;
+    size_t const header_size = load_header(bytes, buffer_size, format, is_negative, digits_count);
+    if (header_size == 0 || digits_count > (buffer_size - header_size) / sizeof(digit_t))
+    {
+        throw std::invalid_argument("buffer doesn't hold a whole serialized big integer");
+    }
+
+    // digits go straight into the result
+    big_integer result(nullptr, 0, false, allocator);
+    result.ensure_capacity(digits_count);
+    load_digits(result._digits, bytes + header_size, digits_count);
+    result._is_negative = is_negative;
+    result.set_digits_count(digits_count);
+
+    bytes_read = header_size + digits_count * sizeof(digit_t);
+    return result;
 }
 
-big_integer &big_integer::operator=(
-    big_integer &&other) noexcept
+big_integer big_integer::deserialize(
+    std::istream &stream,
+    big_integer::serialization_format format,
+    allocator *allocator)
 {
-    throw not_implemented("big_integer &big_integer::operator=(big_integer &&) noexcept", "your code should be here...");
+    unsigned char header[max_serialized_header_size];
+    size_t const header_size = read_count_bytes(stream, header, 1 + sizeof(uint64_t), format);
+    bool is_negative = false;
+    uint64_t digits_count = 0;
+    if (header_size == 0
+        || load_header(header, header_size, format, is_negative, digits_count) == 0
+        || digits_count > ~size_t(0) / sizeof(digit_t))
+    {
+        throw std::invalid_argument("stream doesn't hold a whole serialized big integer");
+    }
+
+    // digits are read straight into the result in chunks doubling as they arrive, so a corrupted count
+    // runs into the end of the stream instead of reserving all of its digits up front
+    big_integer result(nullptr, 0, false, allocator);
+    while (result._digits_count < digits_count)
+    {
+        size_t const chunk_size = static_cast<size_t>(std::min<uint64_t>(digits_count - result._digits_count,
+            std::max(deserialization_chunk_size, result._digits_count)));
+        result.ensure_capacity(result._digits_count + chunk_size);
+        auto *chunk = result._digits + result._digits_count;
+        auto const chunk_bytes = static_cast<std::streamsize>(chunk_size * sizeof(digit_t));
+        stream.read(reinterpret_cast<char *>(chunk), chunk_bytes);
+        if (stream.gcount() != chunk_bytes)
+        {
+            throw std::invalid_argument("stream doesn't hold a whole serialized big integer");
+        }
+        load_digits(chunk, reinterpret_cast<unsigned char const *>(chunk), chunk_size);
+        // not normalized yet, so the reallocations keep the leading zero digits read so far
+        result._digits_count += chunk_size;
+    }
+    result._is_negative = is_negative;
+    result.set_digits_count(result._digits_count);
+
+    return result;
 }
 
-bool big_integer::operator==(
-    big_integer const &other) const
+size_t big_integer::serialized_size(
+    std::vector<big_integer> const &values,
+    big_integer::serialization_format format) noexcept
 {
-    throw not_implemented("bool big_integer::operator==(big_integer const &) const", "your code should be here...");
+    unsigned char count[max_serialized_header_size];
+    size_t size = store_count(count, values.size(), format);
+    for (auto const &value: values)
+    {
+        size += value.serialized_size(format);
+    }
+    return size;
 }
 
-bool big_integer::operator!=(
-    big_integer const &other) const
+size_t big_integer::serialize(
+    std::vector<big_integer> const &values,
+    void *buffer,
+    size_t buffer_size,
+    big_integer::serialization_format format)
 {
-    throw not_implemented("bool big_integer::operator!=(big_integer const &) const", "your code should be here...");
+    size_t const size = serialized_size(values, format);
+    if (size > buffer_size)
+    {
+        throw std::length_error("buffer is too small for the serialized big integers");
+    }
+
+    auto *bytes = static_cast<unsigned char *>(buffer);
+    size_t offset = store_count(bytes, values.size(), format);
+    for (auto const &value: values)
+    {
+        offset += value.serialize(bytes + offset, size - offset, format);
+    }
+    return size;
 }
 
-bool big_integer::operator<(
-    big_integer const &other) const
+void big_integer::serialize(
+    std::vector<big_integer> const &values,
+    std::ostream &stream,
+    big_integer::serialization_format format)
 {
-    throw not_implemented("bool big_integer::operator<(big_integer const &) const", "your code should be here...");
+    unsigned char count[max_serialized_header_size];
+    size_t const count_size = store_count(count, values.size(), format);
+    stream.write(reinterpret_cast<char const *>(count), static_cast<std::streamsize>(count_size));
+    for (auto const &value: values)
+    {
+        value.serialize(stream, format);
+    }
 }
 
-bool big_integer::operator>(
-    big_integer const &other) const
+std::vector<big_integer> big_integer::deserialize_all(
+    void const *buffer,
+    size_t buffer_size,
+    size_t &bytes_read,
+    big_integer::serialization_format format,
+    allocator *allocator)
 {
-    throw not_implemented("bool big_integer::operator>(big_integer const &) const", "your code should be here...");
+    auto const *bytes = static_cast<unsigned char const *>(buffer);
+    uint64_t count = 0;
+    size_t offset = load_count(bytes, buffer_size, format, count);
+    if (offset == 0)
+    {
+        throw std::invalid_argument("buffer doesn't hold a whole serialized big integers count");
+    }
+
+    // every value takes at least a byte, so a damaged count can't reserve more than the buffer size
+    std::vector<big_integer> values;
+    values.reserve(std::min<uint64_t>(count, buffer_size - offset));
+    for (uint64_t i = 0; i < count; ++i)
+    {
+        size_t value_size = 0;
+        values.push_back(deserialize(bytes + offset, buffer_size - offset, value_size, format, allocator));
+        offset += value_size;
+    }
+
+    bytes_read = offset;
+    return values;
 }
 
-bool big_integer::operator<=(
-    big_integer const &other) const
+std::vector<big_integer> big_integer::deserialize_all(
+    std::istream &stream,
+    big_integer::serialization_format format,
+    allocator *allocator)
 {
-    throw not_implemented("bool big_integer::operator<=(big_integer const &) const", "your code should be here...");
+    unsigned char count_bytes[max_serialized_header_size];
+    size_t const count_size = read_count_bytes(stream, count_bytes, sizeof(uint64_t), format);
+    uint64_t count = 0;
+    if (count_size == 0 || load_count(count_bytes, count_size, format, count) == 0)
+    {
+        throw std::invalid_argument("stream doesn't hold a whole serialized big integers count");
+    }
+
+    std::vector<big_integer> values;
+    for (uint64_t i = 0; i < count; ++i)
+    {
+        values.push_back(deserialize(stream, format, allocator));
+    }
+    return values;
 }
 
-bool big_integer::operator>=(
-    big_integer const &other) const
+std::ostream &operator<<(
+    std::ostream &stream,
+    big_integer const &value)
 {
-    throw not_implemented("bool big_integer::operator>=(big_integer const &) const", "your code should be here...");
+    return stream << value.to_string();
 }
 
-big_integer big_integer::operator-() const
+std::istream &operator>>(
+    std::istream &stream,
+    big_integer &value)
 {
-    throw not_implemented("big_integer big_integer::operator-() const", "your code should be here...");
+    std::string value_as_string;
+    if (stream >> value_as_string)
+    {
+        value = big_integer(value_as_string, 10, value.get_allocator());
+    }
+
+    return stream;
 }
 
-big_integer &big_integer::operator+=(
-    big_integer const &other)
+[[nodiscard]] allocator *big_integer::get_allocator() const noexcept
 {
-    throw not_implemented("big_integer &big_integer::operator+=(big_integer const &)", "your code should be here...");
+    return _allocator;
 }
 
-big_integer big_integer::operator+(
-    big_integer const &other) const
+void big_integer::assign(
+    digit_t const *digits,
+    size_t digits_count,
+    bool is_negative)
 {
-    throw not_implemented("big_integer big_integer::operator+(big_integer const &) const", "your code should be here...");
+    digits_count = normalized_size(digits, digits_count);
+    if (digits_count > _digits_capacity)
+    {
+        // the source can't be the own digits, they are too short
+        _digits_count = 0;
+        ensure_capacity(digits_count);
+    }
+
+    if (digits_count != 0)
+    {
+        std::memmove(_digits, digits, digits_count * sizeof(digit_t));
+    }
+
+    _digits_count = digits_count;
+    _is_negative = is_negative && digits_count != 0;
 }
 
-big_integer big_integer::operator+(
-    std::pair<big_integer, allocator *> const &other) const
+void big_integer::clear() noexcept
 {
-    throw not_implemented("big_integer big_integer::operator+(std::pair<big_integer, allocator *> const &) const", "your code should be here...");
+    _is_negative = false;
+    _digits_count = 0;
 }
 
-big_integer &big_integer::operator-=(
-    big_integer const &other)
+void big_integer::ensure_capacity(
+    size_t digits_count)
 {
-    throw not_implemented("big_integer &big_integer::operator-=(big_integer const &)", "your code should be here...");
+    if (digits_count <= _digits_capacity)
+    {
+        return;
+    }
+
+    // grows by half at least, so values growing digit by digit reallocate a logarithmic count of times
+    reallocate_digits(std::max(digits_count, _digits_capacity + _digits_capacity / 2));
 }
 
-big_integer big_integer::operator-(
-    big_integer const &other) const
+void big_integer::reallocate_digits(
+    size_t capacity)
 {
-    throw not_implemented("big_integer big_integer::operator-(big_integer const &) const", "your code should be here...");
+    digit_t *digits = _inline_digits;
+    if (capacity > inline_digits_count)
+    {
+        digits = static_cast<digit_t *>(allocate_with_guard(sizeof(digit_t), capacity));
+    }
+    else
+    {
+        capacity = inline_digits_count;
+    }
+
+    if (digits != _digits)
+    {
+        std::memcpy(digits, _digits, _digits_count * sizeof(digit_t));
+    }
+
+    if (_digits != _inline_digits && _digits != digits)
+    {
+        deallocate_with_guard(_digits);
+    }
+
+    _digits = digits;
+    _digits_capacity = capacity;
 }
 
-big_integer big_integer::operator-(
-    std::pair<big_integer, allocator *> const &other) const
+void big_integer::release_digits() noexcept
 {
-    throw not_implemented("big_integer big_integer::operator-(std::pair<big_integer, allocator *> const &) const", "your code should be here...");
+    if (_digits != _inline_digits)
+    {
+        deallocate_with_guard(_digits);
+    }
+
+    _is_negative = false;
+    _digits_count = 0;
+    _digits_capacity = inline_digits_count;
+    _digits = _inline_digits;
 }
 
-big_integer &big_integer::operator*=(
-    big_integer const &other)
+void big_integer::set_digits_count(
+    size_t digits_count) noexcept
 {
-    throw not_implemented("big_integer &big_integer::operator*=(big_integer const &)", "your code should be here...");
+    _digits_count = normalized_size(_digits, digits_count);
+    if (_digits_count == 0)
+    {
+        _is_negative = false;
+    }
 }
 
-big_integer big_integer::operator*(
-    big_integer const &other) const
+bool big_integer::is_zero() const noexcept
 {
-    throw not_implemented("big_integer big_integer::operator*(big_integer const &) const", "your code should be here...");
+    return _digits_count == 0;
 }
 
-big_integer big_integer::operator*(
-    std::pair<big_integer, allocator *> const &other) const
+int big_integer::compare_magnitudes(
+    big_integer const &first,
+    big_integer const &second) noexcept
 {
-    throw not_implemented("big_integer big_integer::operator*(std::pair<big_integer, allocator *> const &) const", "your code should be here...");
+    return compare_digits(first._digits, first._digits_count, second._digits, second._digits_count);
 }
 
-big_integer &big_integer::operator/=(
-    big_integer const &other)
+big_integer &big_integer::assign_sum(
+    big_integer const &first,
+    big_integer const &second,
+    bool second_is_negative)
 {
-    throw not_implemented("big_integer &big_integer::operator/=(big_integer const &)", "your code should be here...");
+    if (second.is_zero())
+    {
+        if (this != &first)
+        {
+            assign(first._digits, first._digits_count, first._is_negative);
+        }
+        return *this;
+    }
+
+    if (first.is_zero())
+    {
+        assign(second._digits, second._digits_count, second_is_negative);
+        return *this;
+    }
+
+    bool const same_signs = first._is_negative == second_is_negative;
+    int const magnitudes_comparison = compare_magnitudes(first, second);
+    if (!same_signs && magnitudes_comparison == 0)
+    {
+        clear();
+        return *this;
+    }
+
+    big_integer const &larger = magnitudes_comparison >= 0
+        ? first
+        : second;
+    big_integer const &smaller = magnitudes_comparison >= 0
+        ? second
+        : first;
+    bool const is_negative = magnitudes_comparison >= 0
+        ? first._is_negative
+        : second_is_negative;
+    size_t const larger_size = larger._digits_count;
+
+    // the operands may be *this: the digits survive the growth and are processed in the same order they are read
+    ensure_capacity(larger_size);
+
+    digit_t carry = 0;
+    if (same_signs)
+    {
+        carry = add_digits(_digits, larger._digits, larger_size, smaller._digits, smaller._digits_count);
+    }
+    else
+    {
+        subtract_digits(_digits, larger._digits, larger_size, smaller._digits, smaller._digits_count);
+    }
+
+    _digits_count = larger_size;
+    if (carry != 0)
+    {
+        ensure_capacity(larger_size + 1);
+        _digits[_digits_count++] = carry;
+    }
+
+    _is_negative = is_negative;
+    set_digits_count(_digits_count);
+
+    return *this;
 }
 
-big_integer big_integer::operator/(
-    big_integer const &other) const
+big_integer &big_integer::add_magnitude(
+    digit_t const *digits,
+    size_t digits_count,
+    bool is_negative)
 {
-    throw not_implemented("big_integer big_integer::operator/(big_integer const &) const", "your code should be here...");
+    digits_count = normalized_size(digits, digits_count);
+    if (digits_count == 0)
+    {
+        return *this;
+    }
+
+    int const magnitudes_comparison = compare_digits(_digits, _digits_count, digits, digits_count);
+    if (_is_negative != is_negative && magnitudes_comparison == 0)
+    {
+        clear();
+        return *this;
+    }
+
+    size_t const own_size = _digits_count;
+    size_t const larger_size = std::max(own_size, digits_count);
+    ensure_capacity(larger_size + 1);
+
+    // the own digits are read and written in the same order, whichever operand they are
+    digit_t carry = 0;
+    if (_is_negative == is_negative || own_size == 0)
+    {
+        carry = own_size >= digits_count
+            ? add_digits(_digits, _digits, own_size, digits, digits_count)
+            : add_digits(_digits, digits, digits_count, _digits, own_size);
+        _is_negative = is_negative;
+    }
+    else if (magnitudes_comparison > 0)
+    {
+        subtract_digits(_digits, _digits, own_size, digits, digits_count);
+    }
+    else
+    {
+        subtract_digits(_digits, digits, digits_count, _digits, own_size);
+        _is_negative = is_negative;
+    }
+
+    _digits[larger_size] = carry;
+    set_digits_count(larger_size + 1);
+
+    return *this;
 }
 
-big_integer big_integer::operator/(
-    std::pair<big_integer, allocator *> const &other) const
+big_integer &big_integer::accumulate_product(
+    big_integer const &first_multiplier,
+    big_integer const &second_multiplier,
+    bool subtract,
+    big_integer::multiplication_rule multiplication_rule)
 {
-    throw not_implemented("big_integer big_integer::operator/(std::pair<big_integer, allocator *> const &) const", "your code should be here...");
+    if (first_multiplier.is_zero() || second_multiplier.is_zero())
+    {
+        return *this;
+    }
+
+    bool const is_negative = (first_multiplier._is_negative != second_multiplier._is_negative) != subtract;
+    if (is_zero())
+    {
+        assign_product(first_multiplier, second_multiplier, multiplication_rule);
+        _is_negative = is_negative;
+        return *this;
+    }
+
+    size_t const product_size = first_multiplier._digits_count + second_multiplier._digits_count;
+    digit_t *product = get_product_scratch(product_size);
+    get_digits_multiplication(multiplication_rule)(product, first_multiplier._digits, first_multiplier._digits_count, second_multiplier._digits, second_multiplier._digits_count);
+
+    return add_magnitude(product, product_size, is_negative);
 }
 
-big_integer &big_integer::operator%=(
-    big_integer const &other)
+big_integer &big_integer::apply_bitwise(
+    big_integer const &other,
+    char operation)
 {
-    throw not_implemented("big_integer &big_integer::operator%=(big_integer const &)", "your code should be here...");
+    size_t const this_size = _digits_count;
+    size_t const other_size = other._digits_count;
+    bool const this_is_negative = _is_negative;
+    bool const other_is_negative = other._is_negative;
+    size_t const longer_size = std::max(this_size, other_size);
+    size_t const size = longer_size + 1;
+
+    ensure_capacity(size);
+
+    // infinite precision two's complement digits of a negative value are zeros up to its lowest nonzero digit,
+    // that digit negated and then complements; only the digits up to the lowest nonzero ones need the carries
+    // and are produced on the fly, the rest are masked by the vectorized kernels; other may be *this
+    digit const *other_digits = other._digits;
+    digit const this_mask = this_is_negative
+        ? ~digit(0)
+        : 0;
+    digit const other_mask = other_is_negative
+        ? ~digit(0)
+        : 0;
+    size_t const prefix_size = std::max(
+        this_is_negative
+            ? lowest_nonzero_digit(_digits, this_size) + 1
+            : 0,
+        other_is_negative
+            ? lowest_nonzero_digit(other_digits, other_size) + 1
+            : 0);
+
+    digit this_carry = 1;
+    digit other_carry = 1;
+    for (size_t i = 0; i < prefix_size; ++i)
+    {
+        digit this_digit = i < this_size
+            ? _digits[i]
+            : 0;
+        if (this_is_negative)
+        {
+            this_digit = ~this_digit + this_carry;
+            this_carry = this_carry != 0 && this_digit == 0;
+        }
+
+        digit other_digit = i < other_size
+            ? other_digits[i]
+            : 0;
+        if (other_is_negative)
+        {
+            other_digit = ~other_digit + other_carry;
+            other_carry = other_carry != 0 && other_digit == 0;
+        }
+
+        bitwise_digits(_digits + i, &this_digit, 0, &other_digit, 0, 1, operation);
+    }
+
+    size_t const common_size = std::min(this_size, other_size);
+    if (prefix_size < common_size)
+    {
+        bitwise_digits(_digits + prefix_size, _digits + prefix_size, this_mask, other_digits + prefix_size, other_mask, common_size - prefix_size, operation);
+    }
+
+    // past the shorter operand its digits are all zeros or all ones
+    size_t const tail_start = std::max(prefix_size, common_size);
+    if (tail_start < longer_size)
+    {
+        bool const this_is_longer = this_size >= other_size;
+        digit const *longer_digits = this_is_longer
+            ? _digits
+            : other_digits;
+        digit const longer_mask = this_is_longer
+            ? this_mask
+            : other_mask;
+        digit const filler = this_is_longer
+            ? other_mask
+            : this_mask;
+
+        if ((operation == '&' && filler == 0) || (operation == '|' && filler != 0))
+        {
+            std::fill(_digits + tail_start, _digits + longer_size, filler);
+        }
+        else
+        {
+            mask_digits(_digits + tail_start, longer_digits + tail_start, operation == '^'
+                ? longer_mask ^ filler
+                : longer_mask, longer_size - tail_start);
+        }
+    }
+    bitwise_digits(_digits + longer_size, &this_mask, 0, &other_mask, 0, 1, operation);
+
+    bool const is_negative = (_digits[size - 1] >> (digit_bits - 1)) != 0;
+    if (is_negative)
+    {
+        size_t const lowest_nonzero = lowest_nonzero_digit(_digits, size);
+        _digits[lowest_nonzero] = 0 - _digits[lowest_nonzero];
+        mask_digits(_digits + lowest_nonzero + 1, _digits + lowest_nonzero + 1, ~digit(0), size - lowest_nonzero - 1);
+    }
+
+    _is_negative = is_negative;
+    set_digits_count(size);
+
+    return *this;
 }
 
-big_integer big_integer::operator%(
-    big_integer const &other) const
+big_integer &big_integer::multiply_with_rule(
+    big_integer &first_multiplier,
+    big_integer const &second_multiplier,
+    big_integer::multiplication_rule multiplication_rule)
 {
-    throw not_implemented("big_integer big_integer::operator%(big_integer const &) const", "your code should be here...");
+    return get_multiplication(multiplication_rule).multiply(first_multiplier, second_multiplier);
 }
 
-big_integer big_integer::operator%(
-    std::pair<big_integer, allocator *> const &other) const
+void big_integer::assign_root(
+    big_integer &result,
+    big_integer const &value,
+    size_t degree,
+    big_integer::multiplication_rule multiplication_rule)
 {
-    throw not_implemented("big_integer big_integer::operator%(std::pair<big_integer, allocator *> const &) const", "your code should be here...");
+    size_t const bits = value.bit_length();
+    if (bits <= degree)
+    {
+        // value < 2^degree, so the root is 0 or 1
+        digit_t const one = 1;
+        result.assign(&one, bits == 0
+            ? 0
+            : 1, false);
+        return;
+    }
+
+    // the root of value >> (degree * shift) is good to about shift bits, one more unit of it keeps the start above the root
+    size_t const shift = bits / (2 * degree);
+    if (shift == 0)
+    {
+        digit_t const one = 1;
+        result.assign(&one, 1, false);
+        result <<= (bits + degree - 1) / degree;
+    }
+    else
+    {
+        big_integer leading(value._digits, value._digits_count, false, nullptr);
+        leading >>= degree * shift;
+        assign_root(result, leading, degree, multiplication_rule);
+
+        digit_t const one = 1;
+        result.add_magnitude(&one, 1, false);
+        result <<= shift;
+    }
+
+    // x' = ((degree - 1) * x + value / x^(degree - 1)) / degree decreases from above until it stops at the root
+    digit_t const degree_digit = degree;
+    digit_t const degree_minus_one_digit = degree - 1;
+    big_integer const degree_value(&degree_digit, 1, false, nullptr);
+    big_integer const degree_minus_one(&degree_minus_one_digit, 1, false, nullptr);
+    big_integer power(nullptr, 0, false, nullptr);
+    big_integer next(nullptr, 0, false, nullptr);
+    while (true)
+    {
+        power.assign(result._digits, result._digits_count, false);
+        pow(power, degree - 1, nullptr, multiplication_rule);
+
+        next.assign(value._digits, value._digits_count, false);
+        get_division(division_rule::BurnikelZiegler).divide(next, power, multiplication_rule);
+        next.accumulate_product(result, degree_minus_one, false, multiplication_rule);
+        get_division(division_rule::trivial).divide(next, degree_value, multiplication_rule);
+
+        if (compare_magnitudes(next, result) >= 0)
+        {
+            return;
+        }
+        result.assign(next._digits, next._digits_count, false);
+    }
 }
 
-big_integer big_integer::operator~() const
+big_integer::multiplication const &big_integer::get_multiplication(
+    big_integer::multiplication_rule multiplication_rule)
 {
-    throw not_implemented("big_integer big_integer::operator~() const", "your code should be here...");
+    static trivial_multiplication const trivial;
+    static Karatsuba_multiplication const Karatsuba;
+    static Toom_Cook_3_multiplication const Toom_Cook_3;
+    static Toom_Cook_4_multiplication const Toom_Cook_4;
+    static Schonhage_Strassen_multiplication const Schonhage_Strassen;
+    static NTT_multiplication const NTT;
+    static automatic_multiplication const automatic;
+
+    switch (multiplication_rule)
+    {
+        case big_integer::multiplication_rule::trivial:
+            return trivial;
+        case big_integer::multiplication_rule::Karatsuba:
+            return Karatsuba;
+        case big_integer::multiplication_rule::ToomCook3:
+            return Toom_Cook_3;
+        case big_integer::multiplication_rule::ToomCook4:
+            return Toom_Cook_4;
+        case big_integer::multiplication_rule::SchonhageStrassen:
+            return Schonhage_Strassen;
+        case big_integer::multiplication_rule::NTT:
+            return NTT;
+        case big_integer::multiplication_rule::automatic:
+            return automatic;
+    }
+
+    throw std::out_of_range("invalid multiplication rule value");
 }
 
-big_integer &big_integer::operator&=(
-    big_integer const &other)
+big_integer::division const &big_integer::get_division(
+    big_integer::division_rule division_rule)
 {
-    throw not_implemented("big_integer &big_integer::operator&=(big_integer const &)", "your code should be here...");
+    static trivial_division const trivial;
+    static Newton_division const Newton;
+    static Burnikel_Ziegler_division const Burnikel_Ziegler;
+
+    switch (division_rule)
+    {
+        case big_integer::division_rule::trivial:
+            return trivial;
+        case big_integer::division_rule::Newton:
+            return Newton;
+        case big_integer::division_rule::BurnikelZiegler:
+            return Burnikel_Ziegler;
+    }
+
+    throw std::out_of_range("invalid division rule value");
 }
 
-big_integer big_integer::operator&(
-    big_integer const &other) const
+void big_integer::throw_if_invalid_root(
+    big_integer const &value,
+    size_t degree)
 {
-    throw not_implemented("big_integer big_integer::operator&(big_integer const &) const", "your code should be here...");
+    if (degree == 0)
+    {
+        throw std::invalid_argument("root degree can't be zero");
+    }
+    if (value._is_negative && degree % 2 == 0)
+    {
+        throw std::invalid_argument("even degree root of a negative value");
+    }
 }
 
-big_integer big_integer::operator&(
-    std::pair<big_integer, allocator *> const &other) const
+void big_integer::throw_if_division_by_zero(
+    big_integer const &divisor)
 {
-    throw not_implemented("big_integer big_integer::operator&(std::pair<big_integer, allocator *> const &) const", "your code should be here...");
+    if (divisor.is_zero())
+    {
+        throw std::logic_error("attempt to divide by zero");
+    }
 }
 
-big_integer &big_integer::operator|=(
-    big_integer const &other)
+big_integer::modular_context::modular_context(
+    big_integer const &modulus,
+    big_integer::reduction_rule reduction_rule,
+    allocator *allocator):
+        _modulus(modulus._digits, modulus._digits_count, modulus._is_negative, nullptr),
+        _reduction_rule(reduction_rule),
+        _Montgomery_digit_inverse(0),
+        _allocator(allocator)
 {
-    throw not_implemented("big_integer &big_integer::operator|=(big_integer const &)", "your code should be here...");
+    if (modulus._is_negative || modulus.is_zero() || (modulus._digits_count == 1 && modulus._digits[0] == 1))
+    {
+        throw std::invalid_argument("modulus must be greater than one");
+    }
+
+    bool const is_odd = (modulus._digits[0] & 1) != 0;
+    if (_reduction_rule == big_integer::reduction_rule::automatic)
+    {
+        _reduction_rule = is_odd
+            ? big_integer::reduction_rule::Montgomery
+            : big_integer::reduction_rule::Barrett;
+    }
+    else if (_reduction_rule == big_integer::reduction_rule::Montgomery && !is_odd)
+    {
+        throw std::invalid_argument("Montgomery reduction needs an odd modulus");
+    }
+
+    size_t const size = get_digits_count();
+    digit_t const one_digit = 1;
+    big_integer const squared_radix = big_integer(&one_digit, 1, false, nullptr) << 2 * size * digit_bits;
+
+    if (_reduction_rule == big_integer::reduction_rule::Montgomery)
+    {
+        _Montgomery_digit_inverse = 0 - inverse_digit(_modulus._digits[0]);
+        _Montgomery_inverse = inverse_digits(_modulus._digits, size);
+        negate_digits(_Montgomery_inverse.data(), size);
+
+        big_integer const square = big_integer::modulo(squared_radix, _modulus, nullptr, big_integer::division_rule::BurnikelZiegler);
+        _Montgomery_square.assign(size, 0);
+        std::copy(square._digits, square._digits + square._digits_count, _Montgomery_square.begin());
+    }
+    else
+    {
+        big_integer const reciprocal = big_integer::divide(squared_radix, _modulus, nullptr, big_integer::division_rule::BurnikelZiegler);
+        if (reciprocal._digits_count > size + 1)
+        {
+            // a power of the radix leaves 2^(64 * (size + 1)), a digit too long; one less makes the estimate
+            // fall short by one more multiple, which the correction takes off
+            _Barrett_reciprocal.assign(size + 1, ~digit_t(0));
+        }
+        else
+        {
+            _Barrett_reciprocal.assign(size + 1, 0);
+            std::copy(reciprocal._digits, reciprocal._digits + reciprocal._digits_count, _Barrett_reciprocal.begin());
+        }
+    }
+
+    _scratch.resize(6 * size + 4);
 }
 
-big_integer big_integer::operator|(
-    big_integer const &other) const
+big_integer const &big_integer::modular_context::get_modulus() const noexcept
 {
-    throw not_implemented("big_integer big_integer::operator|(big_integer const &) const", "your code should be here...");
+    return _modulus;
 }
 
-big_integer big_integer::operator|(
-    std::pair<big_integer, allocator *> const &other) const
+big_integer::reduction_rule big_integer::modular_context::get_reduction_rule() const noexcept
 {
-    throw not_implemented("big_integer big_integer::operator|(std::pair<big_integer, allocator *> const &) const", "your code should be here...");
+    return _reduction_rule;
 }
 
-big_integer &big_integer::operator^=(
-    big_integer const &other)
+big_integer big_integer::modular_context::reduce(
+    big_integer const &value)
 {
-    throw not_implemented("big_integer &big_integer::operator^=(big_integer const &)", "your code should be here...");
+    size_t const size = get_digits_count();
+    digits_buffer residue(size);
+    load_reduced(value, residue.data());
+    return big_integer(residue.data(), size, false, _allocator);
 }
 
-big_integer big_integer::operator^(
-    big_integer const &other) const
+big_integer big_integer::modular_context::multiply(
+    big_integer const &first_multiplier,
+    big_integer const &second_multiplier)
 {
-    throw not_implemented("big_integer big_integer::operator^(big_integer const &) const", "your code should be here...");
+    size_t const size = get_digits_count();
+    digits_buffer first(size);
+    digits_buffer second(size);
+    load_reduced(first_multiplier, first.data());
+    load_reduced(second_multiplier, second.data());
+
+    multiply_residues(first.data(), first.data(), second.data());
+    if (_reduction_rule == big_integer::reduction_rule::Montgomery)
+    {
+        // the product came out divided by R
+        multiply_residues(first.data(), first.data(), _Montgomery_square.data());
+    }
+
+    return big_integer(first.data(), size, false, _allocator);
 }
 
-big_integer big_integer::operator^(
-    std::pair<big_integer, allocator *> const &other) const
+big_integer big_integer::modular_context::power(
+    big_integer const &base,
+    big_integer const &exponent)
 {
-    throw not_implemented("big_integer big_integer::operator^(std::pair<big_integer, allocator *> const &) const", "your code should be here...");
+    if (exponent._is_negative)
+    {
+        return power(inverse(base), -exponent);
+    }
+
+    digit_t const one_digit = 1;
+    if (exponent.is_zero())
+    {
+        return big_integer(&one_digit, 1, false, _allocator);
+    }
+
+    size_t const size = get_digits_count();
+    size_t const exponent_bits = exponent._digits_count * digit_bits - leading_zero_bits(exponent._digits[exponent._digits_count - 1]);
+    size_t const window_bits = sliding_window_bits(exponent_bits);
+    size_t const odd_powers_count = size_t(1) << (window_bits - 1);
+
+    // base, base^3, ..., base^(2^window_bits - 1), then base^2 and the accumulator
+    _residues.resize((odd_powers_count + 2) * size);
+    digit_t *odd_powers = _residues.data();
+    digit_t *square = odd_powers + odd_powers_count * size;
+    digit_t *accumulator = square + size;
+
+    load(base, odd_powers);
+    multiply_residues(square, odd_powers, odd_powers);
+    for (size_t i = 1; i < odd_powers_count; ++i)
+    {
+        multiply_residues(odd_powers + i * size, odd_powers + (i - 1) * size, square);
+    }
+
+    auto const exponent_bit = [&exponent](size_t bit) -> digit_t
+    {
+        return exponent._digits[bit / digit_bits] >> (bit % digit_bits) & 1;
+    };
+
+    // windows start at a set bit and end at the lowest set bit among the next window_bits ones
+    bool accumulator_is_one = true;
+    for (size_t bit = exponent_bits; bit-- > 0;)
+    {
+        if (exponent_bit(bit) == 0)
+        {
+            multiply_residues(accumulator, accumulator, accumulator);
+            continue;
+        }
+
+        size_t window_end = bit + 1 > window_bits
+            ? bit + 1 - window_bits
+            : 0;
+        while (exponent_bit(window_end) == 0)
+        {
+            ++window_end;
+        }
+
+        size_t window = 0;
+        for (size_t i = bit + 1; i-- > window_end;)
+        {
+            window = window << 1 | exponent_bit(i);
+        }
+
+        if (accumulator_is_one)
+        {
+            std::copy(odd_powers + window / 2 * size, odd_powers + (window / 2 + 1) * size, accumulator);
+            accumulator_is_one = false;
+        }
+        else
+        {
+            for (size_t i = window_end; i <= bit; ++i)
+            {
+                multiply_residues(accumulator, accumulator, accumulator);
+            }
+            multiply_residues(accumulator, accumulator, odd_powers + window / 2 * size);
+        }
+
+        bit = window_end;
+    }
+
+    return store(accumulator);
 }
 
-big_integer &big_integer::operator<<=(
-    size_t shift)
+big_integer big_integer::modular_context::inverse(
+    big_integer const &value)
 {
-    throw not_implemented("big_integer &big_integer::operator<<=(size_t)", "your code should be here...");
+    big_integer coefficient(nullptr, 0, false, nullptr);
+    big_integer modulus_coefficient(nullptr, 0, false, nullptr);
+    big_integer const divisor = extended_gcd(reduce(value), _modulus, coefficient, modulus_coefficient, _allocator);
+
+    digit_t const one_digit = 1;
+    if (divisor != big_integer(&one_digit, 1, false, nullptr))
+    {
+        throw std::invalid_argument("value isn't invertible modulo the modulus");
+    }
+
+    // the coefficient of value is already in [0, modulus)
+    return coefficient;
 }
 
-big_integer big_integer::operator<<(
-    size_t shift) const
+size_t big_integer::modular_context::get_digits_count() const noexcept
 {
-    throw not_implemented("big_integer big_integer::operator<<(size_t) const", "your code should be here...");
+    return _modulus._digits_count;
 }
 
-big_integer big_integer::operator<<(
-    std::pair<size_t, allocator *> const &shift) const
+void big_integer::modular_context::load_reduced(
+    big_integer const &value,
+    digit_t *residue)
 {
-    throw not_implemented("big_integer big_integer::operator<<(std::pair<size_t, allocator *> const &) const", "your code should be here...");
+    size_t const size = get_digits_count();
+    size_t const value_size = value._digits_count;
+
+    if (!value._is_negative && compare_magnitudes(value, _modulus) < 0)
+    {
+        std::copy(value._digits, value._digits + value_size, residue);
+        std::fill(residue + value_size, residue + size, 0);
+        return;
+    }
+
+    // Montgomery reduction needs its input below modulus * R, Barrett reduction below R^2
+    size_t const reducible_size = _reduction_rule == big_integer::reduction_rule::Montgomery
+        ? size
+        : 2 * size;
+    if (value_size > reducible_size)
+    {
+        big_integer reduced = big_integer::modulo(value, _modulus, nullptr, big_integer::division_rule::BurnikelZiegler);
+        if (reduced._is_negative)
+        {
+            reduced += _modulus;
+        }
+        std::copy(reduced._digits, reduced._digits + reduced._digits_count, residue);
+        std::fill(residue + reduced._digits_count, residue + size, 0);
+        return;
+    }
+
+    // a short enough magnitude goes through the reduction itself
+    std::copy(value._digits, value._digits + value_size, _scratch.data());
+    std::fill(_scratch.data() + value_size, _scratch.data() + 2 * size, 0);
+    reduce_product(residue);
+    if (_reduction_rule == big_integer::reduction_rule::Montgomery)
+    {
+        multiply_residues(residue, residue, _Montgomery_square.data());
+    }
+
+    if (value._is_negative && normalized_size(residue, size) != 0)
+    {
+        subtract_digits(residue, _modulus._digits, residue, size);
+    }
 }
 
-big_integer &big_integer::operator>>=(
-    size_t shift)
+void big_integer::modular_context::load(
+    big_integer const &value,
+    digit_t *residue)
 {
-    throw not_implemented("big_integer &big_integer::operator>>=(size_t)", "your code should be here...");
+    load_reduced(value, residue);
+    if (_reduction_rule == big_integer::reduction_rule::Montgomery)
+    {
+        multiply_residues(residue, residue, _Montgomery_square.data());
+    }
 }
 
-big_integer big_integer::operator>>(
-    size_t shift) const
+big_integer big_integer::modular_context::store(
+    digit_t const *residue)
 {
-    throw not_implemented("big_integer big_integer::operator>>(size_t) const", "your code should be here...");
+    size_t const size = get_digits_count();
+    if (_reduction_rule != big_integer::reduction_rule::Montgomery)
+    {
+        return big_integer(residue, size, false, _allocator);
+    }
+
+    digits_buffer result(size);
+    std::copy(residue, residue + size, _scratch.data());
+    std::fill(_scratch.data() + size, _scratch.data() + 2 * size, 0);
+    reduce_product(result.data());
+    return big_integer(result.data(), size, false, _allocator);
 }
 
-big_integer big_integer::operator>>(
-    std::pair<size_t, allocator *> const &other) const
+void big_integer::modular_context::multiply_residues(
+    digit_t *result,
+    digit_t const *first,
+    digit_t const *second)
 {
-    throw not_implemented("big_integer big_integer::operator>>(std::pair<size_t, allocator *> const &) const", "your code should be here...");
+    size_t const size = get_digits_count();
+    multiply_digits_automatic(_scratch.data(), first, size, second, size);
+    reduce_product(result);
 }
 
-big_integer &big_integer::multiply(
-    big_integer &first_multiplier,
-    big_integer const &second_multiplier,
-    allocator *allocator,
-    big_integer::multiplication_rule multiplication_rule)
+void big_integer::modular_context::reduce_product(
+    digit_t *result)
 {
-    throw not_implemented("big_integer &big_integer::multiply(big_integer &, big_integer const &, allocator *, big_integer::multiplication_rule)", "your code should be here...");
+    size_t const size = get_digits_count();
+    digit_t *product = _scratch.data();
+    digit_t *scratch = product + 2 * size;
+
+    if (_reduction_rule == big_integer::reduction_rule::Barrett)
+    {
+        reduce_Barrett(result, product, _modulus._digits, _Barrett_reciprocal.data(), size, scratch);
+    }
+    else if (size < automatic_Karatsuba_threshold.load(std::memory_order_relaxed))
+    {
+        reduce_Montgomery_basecase(result, product, _modulus._digits, size, _Montgomery_digit_inverse);
+    }
+    else
+    {
+        reduce_Montgomery(result, product, _modulus._digits, _Montgomery_inverse.data(), size, scratch);
+    }
 }
 
-big_integer big_integer::multiply(
-    big_integer const &first_multiplier,
-    big_integer const &second_multiplier,
-    allocator *allocator,
-    big_integer::multiplication_rule multiplication_rule)
+big_integer::Newton_divisor::Newton_divisor(
+    big_integer const &divisor,
+    big_integer::multiplication_rule multiplication_rule):
+        _divisor(divisor._digits, divisor._digits_count, divisor._is_negative, nullptr),
+        _multiplication_rule(multiplication_rule)
 {
-    throw not_implemented("big_integer big_integer::multiply(big_integer const &, big_integer const &, allocator *, big_integer::multiplication_rule)", "your code should be here...");
+    throw_if_division_by_zero(divisor);
+
+    if (divisor._digits_count >= Newton_threshold)
+    {
+        _reciprocal = Newton_reciprocal(
+            make_magnitude(divisor._digits, divisor._digits_count),
+            2 * divisor._digits_count,
+            get_digits_multiplication(multiplication_rule));
+    }
 }
 
-big_integer &big_integer::divide(
-    big_integer &dividend,
-    big_integer const &divisor,
-    allocator *allocator,
-    big_integer::division_rule division_rule,
-    big_integer::multiplication_rule multiplication_rule)
+big_integer const &big_integer::Newton_divisor::get_divisor() const noexcept
 {
-    throw not_implemented("big_integer &big_integer::divide(big_integer &, big_integer const &, allocator *, big_integer::division_rule, big_integer::multiplication_rule)", "your code should be here...");
+    return _divisor;
 }
 
-big_integer big_integer::divide(
+big_integer big_integer::Newton_divisor::divide(
     big_integer const &dividend,
-    big_integer const &divisor,
-    allocator *allocator,
-    big_integer::division_rule division_rule,
-    big_integer::multiplication_rule multiplication_rule)
+    allocator *allocator) const
 {
-    throw not_implemented("big_integer big_integer::divide(big_integer const &, big_integer const &, allocator *, big_integer::division_rule, big_integer::multiplication_rule)", "your code should be here...");
+    magnitude quotient;
+    divide_digits(dividend, &quotient, nullptr);
+    return big_integer(quotient.data(), quotient.size(), dividend._is_negative != _divisor._is_negative, allocator);
 }
 
-big_integer &big_integer::modulo(
-    big_integer &dividend,
-    big_integer const &divisor,
-    allocator *allocator,
-    big_integer::division_rule division_rule,
-    big_integer::multiplication_rule multiplication_rule)
+big_integer big_integer::Newton_divisor::modulo(
+    big_integer const &dividend,
+    allocator *allocator) const
 {
-    throw not_implemented("big_integer &big_integer::modulo(big_integer &, big_integer const &, allocator *, big_integer::division_rule, big_integer::multiplication_rule)", "your code should be here...");
+    magnitude remainder;
+    divide_digits(dividend, nullptr, &remainder);
+    return big_integer(remainder.data(), remainder.size(), dividend._is_negative, allocator);
 }
 
-big_integer big_integer::modulo(
-    big_integer const &dividend,
-    big_integer const &divisor,
-    allocator *allocator,
-    big_integer::division_rule division_rule,
-    big_integer::multiplication_rule multiplication_rule)
+std::vector<big_integer> big_integer::Newton_divisor::divide(
+    std::vector<big_integer> const &dividends,
+    allocator *allocator) const
 {
-    throw not_implemented("big_integer big_integer::modulo(big_integer const &, big_integer const &, allocator *, big_integer::division_rule, big_integer::multiplication_rule)", "your code should be here...");
+    std::vector<magnitude> quotients(dividends.size());
+    divide_all(dividends, &quotients, nullptr);
+
+    std::vector<big_integer> result;
+    result.reserve(dividends.size());
+    for (size_t i = 0; i < dividends.size(); ++i)
+    {
+        result.push_back(big_integer(quotients[i].data(), quotients[i].size(), dividends[i]._is_negative != _divisor._is_negative, allocator));
+    }
+    return result;
 }
 
-std::ostream &operator<<(
-    std::ostream &stream,
-    big_integer const &value)
+std::vector<big_integer> big_integer::Newton_divisor::modulo(
+    std::vector<big_integer> const &dividends,
+    allocator *allocator) const
 {
-    throw not_implemented("std::ostream &operator<<(std::ostream &, big_integer const &)", "your code should be here...");
+    std::vector<magnitude> remainders(dividends.size());
+    divide_all(dividends, nullptr, &remainders);
+
+    std::vector<big_integer> result;
+    result.reserve(dividends.size());
+    for (size_t i = 0; i < dividends.size(); ++i)
+    {
+        result.push_back(big_integer(remainders[i].data(), remainders[i].size(), dividends[i]._is_negative, allocator));
+    }
+    return result;
 }
 
-std::istream &operator>>(
-    std::istream &stream,
-    big_integer &value)
+void big_integer::Newton_divisor::divide_digits(
+    big_integer const &dividend,
+    magnitude *quotient,
+    magnitude *remainder) const
 {
-    throw not_implemented("std::istream &operator>>(std::istream &, big_integer &)", "your code should be here...");
+    magnitude const dividend_digits = make_magnitude(dividend._digits, dividend._digits_count);
+    magnitude const divisor_digits = make_magnitude(_divisor._digits, _divisor._digits_count);
+
+    if (_reciprocal.empty() || compare(dividend_digits, divisor_digits) < 0)
+    {
+        divide_trivial(dividend_digits, divisor_digits, quotient, remainder);
+        return;
+    }
+
+    divide_by_reciprocal(dividend_digits, divisor_digits, _reciprocal, quotient, remainder, get_digits_multiplication(_multiplication_rule));
 }
 
-[[nodiscard]] allocator *big_integer::get_allocator() const noexcept
+void big_integer::Newton_divisor::divide_all(
+    std::vector<big_integer> const &dividends,
+    std::vector<magnitude> *quotients,
+    std::vector<magnitude> *remainders) const
 {
-    throw not_implemented("allocator *big_integer::get_allocator() const noexcept", "your code should be here...");
+    size_t total_size = 0;
+    for (auto const &dividend: dividends)
+    {
+        total_size += dividend._digits_count;
+    }
+
+    // the results become big integers on the calling thread, so the allocator is never shared between threads
+    auto const pool = get_multiplication_pool(total_size);
+    run_products(pool.get(), dividends.size(), [this, &dividends, quotients, remainders](size_t i)
+    {
+        divide_digits(
+            dividends[i],
+            quotients == nullptr
+                ? nullptr
+                : &(*quotients)[i],
+            remainders == nullptr
+                ? nullptr
+                : &(*remainders)[i]);
+    });
 }
\ No newline at end of file
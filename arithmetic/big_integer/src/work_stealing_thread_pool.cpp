@@ -0,0 +1,230 @@
+#include <exception>
+#include <stdexcept>
+
+#include "../include/work_stealing_thread_pool.h"
+
+namespace
+{
+
+    thread_local work_stealing_thread_pool *current_pool = nullptr;
+
+    thread_local size_t current_queue_index = 0;
+
+}
+
+work_stealing_thread_pool::work_stealing_thread_pool(
+    size_t threads_count):
+        _queued_count(0),
+        _stopped(false)
+{
+    if (threads_count == 0)
+    {
+        throw std::invalid_argument("thread pool needs at least one thread");
+    }
+
+    for (size_t i = 0; i < threads_count; ++i)
+    {
+        _queues.push_back(std::make_unique<task_queue>());
+    }
+
+    try
+    {
+        for (size_t i = 0; i + 1 < threads_count; ++i)
+        {
+            _workers.emplace_back(&work_stealing_thread_pool::run_worker, this, i);
+        }
+    }
+    catch (...)
+    {
+        stop();
+        throw;
+    }
+}
+
+work_stealing_thread_pool::~work_stealing_thread_pool() noexcept
+{
+    stop();
+}
+
+size_t work_stealing_thread_pool::get_threads_count() const noexcept
+{
+    return _workers.size() + 1;
+}
+
+void work_stealing_thread_pool::run_all(
+    std::vector<task> &tasks)
+{
+    if (tasks.empty())
+    {
+        return;
+    }
+
+    struct task_group final
+    {
+
+    public:
+
+        std::atomic<size_t> pending;
+
+        std::mutex exception_mutex;
+
+        std::exception_ptr exception;
+
+    } group;
+    group.pending.store(tasks.size());
+
+    auto const run_in_group = [this, &group](task &grouped_task)
+    {
+        try
+        {
+            grouped_task();
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(group.exception_mutex);
+            if (group.exception == nullptr)
+            {
+                group.exception = std::current_exception();
+            }
+        }
+
+        // the group and this closure may be gone right after the last decrement
+        work_stealing_thread_pool *pool = this;
+        if (group.pending.fetch_sub(1) == 1)
+        {
+            pool->notify_all();
+        }
+    };
+
+    for (size_t i = 1; i < tasks.size(); ++i)
+    {
+        push([&run_in_group, &forked_task = tasks[i]]() { run_in_group(forked_task); });
+    }
+    run_in_group(tasks[0]);
+
+    while (group.pending.load() != 0)
+    {
+        if (try_run_queued_task())
+        {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(_wakeup_mutex);
+        _wakeup.wait(lock, [this, &group]() { return group.pending.load() == 0 || _queued_count.load() != 0; });
+    }
+
+    if (group.exception != nullptr)
+    {
+        std::rethrow_exception(group.exception);
+    }
+}
+
+work_stealing_thread_pool *work_stealing_thread_pool::get_current() noexcept
+{
+    return current_pool;
+}
+
+size_t work_stealing_thread_pool::get_own_queue_index() const noexcept
+{
+    return current_pool == this
+        ? current_queue_index
+        : _queues.size() - 1;
+}
+
+void work_stealing_thread_pool::push(
+    task &&forked_task)
+{
+    auto &queue = *_queues[get_own_queue_index()];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(std::move(forked_task));
+    }
+    _queued_count.fetch_add(1);
+
+    {
+        std::lock_guard<std::mutex> lock(_wakeup_mutex);
+    }
+    _wakeup.notify_one();
+}
+
+bool work_stealing_thread_pool::try_run_queued_task()
+{
+    size_t const own_index = get_own_queue_index();
+    task found;
+
+    {
+        auto &own_queue = *_queues[own_index];
+        std::lock_guard<std::mutex> lock(own_queue.mutex);
+        if (!own_queue.tasks.empty())
+        {
+            found = std::move(own_queue.tasks.back());
+            own_queue.tasks.pop_back();
+        }
+    }
+
+    // the oldest tasks of other queues are the largest ones in a recursive split
+    for (size_t i = 1; !found && i < _queues.size(); ++i)
+    {
+        auto &queue = *_queues[(own_index + i) % _queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.tasks.empty())
+        {
+            found = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+    }
+
+    if (!found)
+    {
+        return false;
+    }
+
+    _queued_count.fetch_sub(1);
+    found();
+    return true;
+}
+
+void work_stealing_thread_pool::notify_all()
+{
+    {
+        std::lock_guard<std::mutex> lock(_wakeup_mutex);
+    }
+    _wakeup.notify_all();
+}
+
+void work_stealing_thread_pool::stop() noexcept
+{
+    {
+        std::lock_guard<std::mutex> lock(_wakeup_mutex);
+        _stopped = true;
+    }
+    _wakeup.notify_all();
+
+    for (auto &worker: _workers)
+    {
+        worker.join();
+    }
+    _workers.clear();
+}
+
+void work_stealing_thread_pool::run_worker(
+    size_t index)
+{
+    current_pool = this;
+    current_queue_index = index;
+
+    while (true)
+    {
+        if (try_run_queued_task())
+        {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(_wakeup_mutex);
+        _wakeup.wait(lock, [this]() { return _stopped || _queued_count.load() != 0; });
+        if (_stopped)
+        {
+            return;
+        }
+    }
+}
\ No newline at end of file
@@ -1,9 +1,38 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <sstream>
+
 #include <big_integer.h>
 #include <client_logger.h>
 #include <operation_not_supported.h>
 
+class counting_allocator final:
+    public allocator
+{
+
+public:
+
+    size_t allocations_count = 0;
+
+public:
+
+    [[nodiscard]] void *allocate(
+        size_t value_size,
+        size_t values_count) override
+    {
+        ++allocations_count;
+        return ::operator new(value_size * values_count);
+    }
+
+    void deallocate(
+        void *at) override
+    {
+        ::operator delete(at);
+    }
+
+};
+
 logger *create_logger(
     std::vector<std::pair<std::string, logger::severity>> const &output_file_streams_setup,
     bool use_console_stream = true,
@@ -207,6 +236,920 @@ TEST(positive_tests, test9)
     delete logger;
 }
 
+TEST(positive_tests, test10)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "bigint_logs.txt",
+                logger::severity::information
+            },
+        });
+    
+    counting_allocator allocator;
+    
+    big_integer bigint_1("-340282366920938463463374607431768211455", 10, &allocator);
+    big_integer bigint_2("18446744073709551615", 10, &allocator);
+    big_integer bigint_3(bigint_1);
+    big_integer bigint_4(std::move(bigint_3));
+    bigint_3 = bigint_2;
+    bigint_4 = std::move(bigint_3);
+    
+    big_integer result = (bigint_1 + bigint_2) / bigint_2 * big_integer("3", 10, &allocator) % bigint_4 - (bigint_4 << 60 >> 7);
+    
+    std::stringstream ss;
+    ss << result;
+    
+    EXPECT_TRUE(ss.str() == "-166153499473114484103968683280302083");
+    EXPECT_TRUE(allocator.allocations_count == 0);
+    
+    result <<= 256;
+    
+    EXPECT_TRUE(allocator.allocations_count == 1);
+    
+    delete logger;
+}
+
+TEST(positive_tests, test11)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "bigint_logs.txt",
+                logger::severity::information
+            },
+        });
+    
+    big_integer const bigint_1(std::string(3000, '7') + "123456789");
+    big_integer const bigint_2("-" + std::string(2500, '3') + "987654321");
+    
+    auto const default_thresholds = big_integer::get_multiplication_thresholds();
+    big_integer::set_multiplication_thresholds(big_integer::multiplication_thresholds{ 2, 4, 8, 16, 32 });
+    
+    auto const thresholds = big_integer::get_multiplication_thresholds();
+    EXPECT_EQ(thresholds.Karatsuba, 2);
+    EXPECT_EQ(thresholds.Toom_Cook_3, 4);
+    EXPECT_EQ(thresholds.Toom_Cook_4, 8);
+    EXPECT_EQ(thresholds.Schonhage_Strassen, 16);
+    EXPECT_EQ(thresholds.NTT, 32);
+    
+    big_integer const result = big_integer::multiply(bigint_1, bigint_2, nullptr, big_integer::multiplication_rule::automatic);
+    
+    big_integer::set_multiplication_thresholds(default_thresholds);
+    
+    EXPECT_TRUE(result == big_integer::multiply(bigint_1, bigint_2, nullptr, big_integer::multiplication_rule::trivial));
+    EXPECT_TRUE(result == bigint_1 * bigint_2);
+    
+    // Schonhage-Strassen from a few digits on still ends its recursion, alone and under the other algorithms
+    for (auto const &tiny_thresholds: { big_integer::multiplication_thresholds{ 2, 2, 2, 2, 1000000 }, big_integer::multiplication_thresholds{ 2, 3, 4, 5, 6 }, big_integer::multiplication_thresholds{ 2, 64, 128, 256, 1000000 } })
+    {
+        big_integer::set_multiplication_thresholds(tiny_thresholds);
+        for (size_t digits: { 2, 5, 40, 400, 1300 })
+        {
+            big_integer const first = (big_integer(1) << (64 * digits)) - bigint_1;
+            big_integer const second = (big_integer(1) << (64 * digits - 1)) + bigint_2;
+            big_integer const product = big_integer::multiply(first, second, nullptr, big_integer::multiplication_rule::automatic);
+            big_integer const square = big_integer::multiply(first, first, nullptr, big_integer::multiplication_rule::automatic);
+            
+            EXPECT_TRUE(product == big_integer::multiply(first, second, nullptr, big_integer::multiplication_rule::trivial));
+            EXPECT_TRUE(square == big_integer::multiply(first, first, nullptr, big_integer::multiplication_rule::trivial));
+        }
+    }
+    big_integer::set_multiplication_thresholds(default_thresholds);
+    
+    delete logger;
+}
+
+TEST(positive_tests, test12)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "bigint_logs.txt",
+                logger::severity::information
+            },
+        });
+    
+    big_integer bigint_1("-" + std::string(4000, '9') + "87654321");
+    big_integer const bigint_2(bigint_1);
+    big_integer const expected = big_integer::multiply(static_cast<big_integer const &>(bigint_1), bigint_2, nullptr, big_integer::multiplication_rule::trivial);
+    
+    for (auto multiplication_rule: { big_integer::multiplication_rule::trivial, big_integer::multiplication_rule::Karatsuba,
+        big_integer::multiplication_rule::ToomCook3, big_integer::multiplication_rule::ToomCook4,
+        big_integer::multiplication_rule::SchonhageStrassen, big_integer::multiplication_rule::NTT,
+        big_integer::multiplication_rule::automatic })
+    {
+        EXPECT_TRUE(big_integer::square(bigint_2, nullptr, multiplication_rule) == expected);
+        EXPECT_TRUE(big_integer::multiply(bigint_2, bigint_2, nullptr, multiplication_rule) == expected);
+    }
+    
+    bigint_1 *= bigint_1;
+    
+    EXPECT_TRUE(bigint_1 == expected);
+    
+    delete logger;
+}
+
+TEST(positive_tests, test13)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "bigint_logs.txt",
+                logger::severity::information
+            },
+        });
+    
+    big_integer const bigint_1(std::string(3000, '5') + "123456789");
+    big_integer const bigint_2("-" + std::string(150000, '8') + "987654321");
+    big_integer const expected = big_integer::multiply(bigint_1, bigint_2, nullptr, big_integer::multiplication_rule::trivial);
+    big_integer const expected_square = big_integer::square(bigint_2, nullptr, big_integer::multiplication_rule::trivial);
+    
+    auto const default_parallelism = big_integer::get_multiplication_parallelism();
+    big_integer::set_multiplication_parallelism(big_integer::multiplication_parallelism{ 4, 8 });
+    
+    auto const parallelism = big_integer::get_multiplication_parallelism();
+    EXPECT_EQ(parallelism.threads_count, 4);
+    EXPECT_EQ(parallelism.threshold, 8);
+    
+    for (auto multiplication_rule: { big_integer::multiplication_rule::Karatsuba, big_integer::multiplication_rule::ToomCook3,
+        big_integer::multiplication_rule::ToomCook4, big_integer::multiplication_rule::NTT,
+        big_integer::multiplication_rule::automatic })
+    {
+        EXPECT_TRUE(big_integer::multiply(bigint_1, bigint_2, nullptr, multiplication_rule) == expected);
+        EXPECT_TRUE(big_integer::square(bigint_2, nullptr, multiplication_rule) == expected_square);
+    }
+    
+    big_integer::set_multiplication_parallelism(default_parallelism);
+    
+    delete logger;
+}
+
+TEST(positive_tests, test14)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "bigint_logs.txt",
+                logger::severity::information
+            },
+        });
+    
+    big_integer const power_of_ten("1" + std::string(6000, '0'));
+    big_integer const power_of_two = big_integer("1") << 20000;
+    
+    EXPECT_EQ(power_of_ten.to_string(), "1" + std::string(6000, '0'));
+    EXPECT_EQ((power_of_ten - big_integer("1")).to_string(), std::string(6000, '9'));
+    EXPECT_EQ((-power_of_ten).to_string(10), "-1" + std::string(6000, '0'));
+    EXPECT_EQ(power_of_two.to_string(2), "1" + std::string(20000, '0'));
+    EXPECT_EQ(power_of_two.to_string(16), "1" + std::string(5000, '0'));
+    EXPECT_EQ((power_of_two - big_integer("1")).to_string(8), "3" + std::string(6666, '7'));
+    EXPECT_EQ((power_of_two - big_integer("1")).to_string(32), std::string(4000, 'v'));
+    EXPECT_TRUE(big_integer(std::string(5000, 'z'), 36) == big_integer("1" + std::string(5000, '0'), 36) - big_integer("1"));
+    EXPECT_EQ(big_integer("-ZZ", 36).to_string(36), "-zz");
+    EXPECT_EQ(big_integer("0", 7).to_string(7), "0");
+    
+    delete logger;
+}
+
+TEST(positive_tests, test15)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "bigint_logs.txt",
+                logger::severity::information
+            },
+        });
+    
+    std::string const symbols = "0123456789abcdefghijklmnopqrstuvwxyz";
+    
+    for (size_t base = 2; base <= 36; ++base)
+    {
+        std::string value_as_string;
+        for (size_t i = 0; i < 4000; ++i)
+        {
+            value_as_string.push_back(symbols[(i * 7 + i / 13 + 1) % base]);
+        }
+        
+        big_integer const value("-" + value_as_string, base);
+        EXPECT_EQ(value.to_string(base), "-" + value_as_string);
+        EXPECT_TRUE(big_integer(value.to_string(), 10) == value);
+        EXPECT_TRUE(big_integer(value.to_string(16), 16) == value);
+    }
+    
+    delete logger;
+}
+
+TEST(positive_tests, test16)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "bigint_logs.txt",
+                logger::severity::information
+            },
+        });
+    
+    big_integer const bigint_1("-" + std::string(3000, '7') + "123456789");
+    big_integer const bigint_2("18446744073709551617");
+    
+    for (auto format: { big_integer::serialization_format::fixed, big_integer::serialization_format::varint })
+    {
+        std::vector<unsigned char> buffer(bigint_1.serialized_size(format) + 3);
+        size_t const bytes_written = bigint_1.serialize(buffer.data(), buffer.size(), format);
+        EXPECT_EQ(bytes_written, bigint_1.serialized_size(format));
+        
+        size_t bytes_read = 0;
+        EXPECT_TRUE(big_integer::deserialize(buffer.data(), buffer.size(), bytes_read, format) == bigint_1);
+        EXPECT_EQ(bytes_read, bytes_written);
+        
+        std::stringstream stream;
+        bigint_2.serialize(stream, format);
+        bigint_1.serialize(stream, format);
+        EXPECT_TRUE(big_integer::deserialize(stream, format) == bigint_2);
+        EXPECT_TRUE(big_integer::deserialize(stream, format) == bigint_1);
+    }
+    
+    std::vector<unsigned char> buffer(bigint_2.serialized_size());
+    bigint_2.serialize(buffer.data(), buffer.size());
+    EXPECT_EQ(buffer, (std::vector<unsigned char>{ 0, 2, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0 }));
+    
+    buffer.resize((-bigint_2).serialized_size(big_integer::serialization_format::varint));
+    (-bigint_2).serialize(buffer.data(), buffer.size(), big_integer::serialization_format::varint);
+    EXPECT_EQ(buffer, (std::vector<unsigned char>{ 5, 1, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0 }));
+    
+    delete logger;
+}
+
+TEST(positive_tests, test17)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "bigint_logs.txt",
+                logger::severity::information
+            },
+        });
+    
+    std::vector<big_integer> values;
+    values.emplace_back("0");
+    values.emplace_back("-1");
+    values.emplace_back(std::string(500, '3'));
+    values.emplace_back("-" + std::string(2000, '9'));
+    
+    for (auto format: { big_integer::serialization_format::fixed, big_integer::serialization_format::varint })
+    {
+        std::vector<unsigned char> buffer(big_integer::serialized_size(values, format));
+        EXPECT_EQ(big_integer::serialize(values, buffer.data(), buffer.size(), format), buffer.size());
+        
+        size_t bytes_read = 0;
+        EXPECT_TRUE(big_integer::deserialize_all(buffer.data(), buffer.size(), bytes_read, format) == values);
+        EXPECT_EQ(bytes_read, buffer.size());
+        
+        std::stringstream stream;
+        big_integer::serialize(values, stream, format);
+        EXPECT_EQ(stream.str(), std::string(buffer.begin(), buffer.end()));
+        EXPECT_TRUE(big_integer::deserialize_all(stream, format) == values);
+    }
+    
+    delete logger;
+}
+
+TEST(positive_tests, test18)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "bigint_logs.txt",
+                logger::severity::information
+            },
+        });
+    
+    counting_allocator allocator;
+    
+    big_integer const bigint_1("-" + std::string(300, '7'));
+    big_integer const bigint_2(std::string(250, '3'));
+    big_integer const bigint_3(std::string(400, '9'));
+    big_integer const bigint_4("-" + std::string(100, '5'));
+    big_integer const bigint_5(std::string(600, '1'));
+    big_integer const expected = bigint_1 * bigint_2 + bigint_3 * bigint_4 - bigint_5;
+    
+    big_integer result("0", 10, &allocator);
+    result.assign_product(bigint_1, bigint_2).add_product(bigint_3, bigint_4) -= bigint_5;
+    EXPECT_TRUE(result == expected);
+    
+    size_t allocations_count = 0;
+    for (size_t i = 0; i < 10; ++i)
+    {
+        result.assign_product(bigint_3, bigint_4).subtract_product(bigint_5, bigint_4).add_product(bigint_1, bigint_2) += bigint_1;
+        if (i == 0)
+        {
+            allocations_count = allocator.allocations_count;
+        }
+    }
+    EXPECT_TRUE(result == bigint_3 * bigint_4 - bigint_5 * bigint_4 + bigint_1 * bigint_2 + bigint_1);
+    EXPECT_EQ(allocator.allocations_count, allocations_count);
+    
+    result.subtract_product(result, big_integer("1"));
+    EXPECT_TRUE(result == big_integer("0"));
+    
+    delete logger;
+}
+
+TEST(positive_tests, test19)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "bigint_logs.txt",
+                logger::severity::information
+            },
+        });
+    
+    counting_allocator allocator;
+    
+    big_integer value("1", 10, &allocator);
+    for (size_t i = 0; i < 6400; ++i)
+    {
+        value += value;
+    }
+    EXPECT_TRUE(value == big_integer("1") << 6400);
+    EXPECT_LE(allocator.allocations_count, 16);
+    
+    value = big_integer("1", 10, &allocator);
+    value.reserve(64 * 200);
+    EXPECT_GE(value.capacity(), 64 * 200);
+    
+    size_t const allocations_count = allocator.allocations_count;
+    big_integer const three("3");
+    for (size_t i = 0; i < 5000; ++i)
+    {
+        value *= three;
+        value += three;
+    }
+    EXPECT_EQ(allocator.allocations_count, allocations_count);
+    EXPECT_GE(value.capacity(), 64 * 200);
+    
+    value.shrink_to_fit();
+    EXPECT_LT(value.capacity(), 64 * 200);
+    EXPECT_GE(value.capacity(), 5000 * 3 / 2);
+    
+    big_integer const shrunk_value = value;
+    value.shrink_to_fit();
+    EXPECT_TRUE(value == shrunk_value);
+    
+    value = big_integer("-5", 10, &allocator);
+    value.shrink_to_fit();
+    EXPECT_LT(value.capacity(), 5000);
+    EXPECT_TRUE(value == big_integer("-5"));
+    
+    delete logger;
+}
+
+TEST(positive_tests, test20)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "bigint_logs.txt",
+                logger::severity::information
+            },
+        });
+    
+    big_integer const one("1");
+    big_integer const Mersenne_prime = (one << 127) - one;
+    big_integer const value("123456789012345678901234567890");
+    
+    for (auto reduction_rule: { big_integer::reduction_rule::Montgomery, big_integer::reduction_rule::Barrett })
+    {
+        big_integer::modular_context context(Mersenne_prime, reduction_rule);
+        EXPECT_TRUE(context.power(value, Mersenne_prime - one) == one);
+        EXPECT_TRUE(context.multiply(context.inverse(value), value) == one);
+        EXPECT_TRUE(context.multiply(context.power(value, big_integer("-5")), context.power(value, big_integer("5"))) == one);
+        EXPECT_TRUE(context.reduce(-value) == Mersenne_prime - value);
+    }
+    
+    // wider than the Karatsuba threshold, so Montgomery reduction goes through products
+    big_integer const odd_modulus = (one << 3000) - big_integer("159");
+    big_integer const even_modulus = odd_modulus + one;
+    big_integer const first = (one << 2900) + big_integer("987654321");
+    big_integer const second = -((one << 2500) + big_integer("123456789"));
+    
+    std::vector<std::pair<big_integer, big_integer::reduction_rule>> const moduli
+        {
+            { odd_modulus, big_integer::reduction_rule::Montgomery },
+            { even_modulus, big_integer::reduction_rule::Barrett }
+        };
+    
+    for (auto const &modulus_and_rule: moduli)
+    {
+        big_integer const &modulus = modulus_and_rule.first;
+        big_integer::modular_context context(modulus);
+        EXPECT_TRUE(context.get_reduction_rule() == modulus_and_rule.second);
+        
+        big_integer expected = (first * second) % modulus;
+        if (expected < big_integer("0"))
+        {
+            expected += modulus;
+        }
+        EXPECT_TRUE(context.multiply(first, second) == expected);
+        
+        big_integer cube = (first * first) % modulus;
+        cube = (cube * first) % modulus;
+        EXPECT_TRUE(context.power(first, big_integer("3")) == cube);
+        EXPECT_TRUE(context.power(first, big_integer("0")) == one);
+    }
+    
+    // powers of the radix have the longest Barrett reciprocals
+    for (size_t bits: { 64, 128, 192, 704 })
+    {
+        big_integer const modulus = one << bits;
+        for (auto reduction_rule: { big_integer::reduction_rule::Barrett, big_integer::reduction_rule::automatic })
+        {
+            big_integer::modular_context context(modulus, reduction_rule);
+            EXPECT_TRUE(context.get_reduction_rule() == big_integer::reduction_rule::Barrett);
+    
+            big_integer const mask = modulus - one;
+            EXPECT_TRUE(context.reduce(first) == (first & mask));
+            EXPECT_TRUE(context.reduce(modulus - one) == mask);
+            EXPECT_TRUE(context.reduce(second) == modulus - ((-second) & mask));
+            EXPECT_TRUE(context.multiply(first, first) == ((first * first) & mask));
+            EXPECT_TRUE(context.multiply(mask, mask) == one);
+            EXPECT_TRUE(context.power(first, big_integer("3")) == ((first * first * first) & mask));
+        }
+        EXPECT_THROW(big_integer::modular_context(modulus, big_integer::reduction_rule::Montgomery), std::invalid_argument);
+    }
+    
+    delete logger;
+}
+
+TEST(positive_tests, test21)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "bigint_logs.txt",
+                logger::severity::information
+            },
+        });
+    
+    big_integer const one("1");
+    big_integer const first = (one << 2000) - big_integer("123456789123456789");
+    big_integer const second = -((one << 1500) + (one << 700));
+    
+    std::vector<big_integer> expected;
+    for (auto vectorization: { big_integer::vectorization::scalar, big_integer::vectorization::AVX2, big_integer::vectorization::AVX512 })
+    {
+        if (static_cast<int>(vectorization) > static_cast<int>(big_integer::get_supported_vectorization()))
+        {
+            break;
+        }
+        big_integer::set_vectorization(vectorization);
+        EXPECT_TRUE(big_integer::get_vectorization() == vectorization);
+        
+        std::vector<big_integer> const results
+        {
+            first & second,
+            first | second,
+            first ^ second,
+            first << 77,
+            second >> 77,
+            ~second
+        };
+        EXPECT_TRUE(results[0] + results[1] == first + second);
+        EXPECT_TRUE(results[2] == results[1] - results[0]);
+        EXPECT_TRUE(results[3] >> 77 == first);
+        EXPECT_TRUE(results[5] == -second - one);
+        
+        if (expected.empty())
+        {
+            expected = results;
+        }
+        for (size_t i = 0; i < results.size(); ++i)
+        {
+            EXPECT_TRUE(results[i] == expected[i]);
+        }
+    }
+    big_integer::set_vectorization(big_integer::get_supported_vectorization());
+    
+    delete logger;
+}
+
+TEST(positive_tests, test22)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "bigint_logs.txt",
+                logger::severity::information
+            },
+        });
+    
+    big_integer const one("1");
+    std::vector<big_integer> const divisors
+    {
+        (one << 4000) - big_integer("12345"),
+        -((one << 3500) + big_integer("987654321987654321")),
+        big_integer("1000000007")
+    };
+    std::vector<big_integer> const dividends
+    {
+        (one << 20000) - one,
+        -((one << 13333) + big_integer("55555555555555555555")),
+        (one << 3000) + one,
+        big_integer("0")
+    };
+    
+    for (auto const &divisor: divisors)
+    {
+        big_integer::Newton_divisor const Newton_divisor(divisor);
+        EXPECT_TRUE(Newton_divisor.get_divisor() == divisor);
+        
+        std::vector<big_integer> const quotients = Newton_divisor.divide(dividends);
+        std::vector<big_integer> const remainders = Newton_divisor.modulo(dividends);
+        ASSERT_EQ(quotients.size(), dividends.size());
+        ASSERT_EQ(remainders.size(), dividends.size());
+        
+        for (size_t i = 0; i < dividends.size(); ++i)
+        {
+            big_integer const quotient = big_integer::divide(dividends[i], divisor);
+            big_integer const remainder = big_integer::modulo(dividends[i], divisor);
+            EXPECT_TRUE(Newton_divisor.divide(dividends[i]) == quotient);
+            EXPECT_TRUE(Newton_divisor.modulo(dividends[i]) == remainder);
+            EXPECT_TRUE(quotients[i] == quotient);
+            EXPECT_TRUE(remainders[i] == remainder);
+            EXPECT_TRUE(quotient * divisor + remainder == dividends[i]);
+        }
+    }
+    
+    delete logger;
+}
+
+TEST(positive_tests, test23)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "bigint_logs.txt",
+                logger::severity::information
+            },
+        });
+    
+    big_integer const one("1");
+    std::vector<big_integer> const divisors
+    {
+        big_integer("-97"),
+        (one << 700) + big_integer("31"),
+        -((one << 5000) - big_integer("77777777777777777"))
+    };
+    std::vector<big_integer> const dividends
+    {
+        -((one << 12000) + big_integer("123456789")),
+        (one << 5000) + one,
+        big_integer("42")
+    };
+    
+    for (auto division_rule: { big_integer::division_rule::trivial, big_integer::division_rule::Newton, big_integer::division_rule::BurnikelZiegler })
+    {
+        for (auto const &divisor: divisors)
+        {
+            for (auto const &dividend: dividends)
+            {
+                big_integer const quotient = big_integer::divide(dividend, divisor, nullptr, division_rule);
+                big_integer const remainder = big_integer::modulo(dividend, divisor, nullptr, division_rule);
+                
+                auto const result = big_integer::divmod(dividend, divisor, nullptr, division_rule);
+                EXPECT_TRUE(result.first == quotient);
+                EXPECT_TRUE(result.second == remainder);
+                
+                big_integer in_place_quotient = dividend;
+                big_integer in_place_remainder("5");
+                big_integer::divmod(in_place_quotient, divisor, in_place_remainder, division_rule);
+                EXPECT_TRUE(in_place_quotient == quotient);
+                EXPECT_TRUE(in_place_remainder == remainder);
+                
+                // the remainder may take the place of the divisor
+                big_integer same_quotient = dividend;
+                big_integer same_remainder = divisor;
+                big_integer::divmod(same_quotient, same_remainder, same_remainder, division_rule);
+                EXPECT_TRUE(same_quotient == quotient);
+                EXPECT_TRUE(same_remainder == remainder);
+            }
+        }
+    }
+    
+    delete logger;
+}
+
+TEST(positive_tests, test24)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "bigint_logs.txt",
+                logger::severity::information
+            },
+        });
+    
+    big_integer const one("1");
+    big_integer const zero("0");
+    big_integer const common = (one << 3001) + big_integer("1234567");
+    std::vector<std::pair<big_integer, big_integer>> const operands
+    {
+        { common * ((one << 9000) - one), -(common * ((one << 8500) + big_integer("98765"))) },
+        { (one << 12000) + one, (one << 12000) - one },
+        { big_integer("-1071"), big_integer("462") },
+        { common, zero },
+        { zero, -common }
+    };
+    
+    for (auto const &pair: operands)
+    {
+        big_integer const &first = pair.first;
+        big_integer const &second = pair.second;
+        big_integer expected = first < zero
+            ? -first
+            : first;
+        big_integer remainder = second < zero
+            ? -second
+            : second;
+        while (remainder != zero)
+        {
+            big_integer next = expected % remainder;
+            expected = remainder;
+            remainder = next;
+        }
+        
+        for (auto gcd_rule: { big_integer::gcd_rule::Euclid, big_integer::gcd_rule::Lehmer, big_integer::gcd_rule::HalfGCD })
+        {
+            EXPECT_TRUE(big_integer::gcd(first, second, nullptr, gcd_rule) == expected);
+            
+            big_integer first_coefficient("0");
+            big_integer second_coefficient("0");
+            EXPECT_TRUE(big_integer::extended_gcd(first, second, first_coefficient, second_coefficient, nullptr, gcd_rule) == expected);
+            EXPECT_TRUE(first * first_coefficient + second * second_coefficient == expected);
+            if (second != zero)
+            {
+                EXPECT_TRUE(first_coefficient >= zero);
+                EXPECT_TRUE(first_coefficient * expected < (second < zero
+                    ? -second
+                    : second));
+            }
+        }
+    }
+    
+    EXPECT_TRUE(big_integer::gcd(common * big_integer("6"), common * big_integer("-10")) == common * big_integer("2"));
+    EXPECT_TRUE(big_integer::gcd(zero, zero) == zero);
+    
+    delete logger;
+}
+
+TEST(positive_tests, test25)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "bigint_logs.txt",
+                logger::severity::information
+            },
+        });
+    
+    big_integer const one("1");
+    big_integer const zero("0");
+    big_integer const base = (one << 700) + big_integer("-123456789012345678901234567890");
+    
+    for (auto multiplication_rule: { big_integer::multiplication_rule::trivial, big_integer::multiplication_rule::Karatsuba, big_integer::multiplication_rule::automatic })
+    {
+        big_integer expected = one;
+        for (size_t degree = 0; degree <= 7; ++degree)
+        {
+            EXPECT_TRUE(big_integer::pow(base, degree, nullptr, multiplication_rule) == expected);
+            EXPECT_TRUE(big_integer::pow(-base, degree, nullptr, multiplication_rule) == (degree % 2 == 0
+                ? expected
+                : -expected));
+            
+            if (degree != 0)
+            {
+                EXPECT_TRUE(big_integer::iroot(big_integer(expected), degree, nullptr, multiplication_rule) == base);
+                EXPECT_TRUE(big_integer::iroot(expected - one, degree, nullptr, multiplication_rule) == (degree == 1
+                    ? expected - one
+                    : base - one));
+            }
+            expected *= base;
+        }
+        
+        big_integer const square = base * base;
+        EXPECT_TRUE(big_integer::isqrt(square + base + base, nullptr, multiplication_rule) == base);
+        EXPECT_TRUE(big_integer::iroot(-(square * base) + one, 3, nullptr, multiplication_rule) == -(base - one));
+    }
+    
+    EXPECT_TRUE(big_integer::pow(big_integer("-2"), 1001) == -(one << 1001));
+    EXPECT_TRUE(big_integer::pow(zero, 0) == one);
+    EXPECT_TRUE(big_integer::isqrt(zero) == zero);
+    EXPECT_TRUE(big_integer::isqrt(big_integer("99")) == big_integer("9"));
+    
+    big_integer value("1000000");
+    big_integer::isqrt(value);
+    EXPECT_TRUE(value == big_integer("1000"));
+    big_integer::pow(value, 3);
+    EXPECT_TRUE(value == big_integer("1000000000"));
+    
+    delete logger;
+}
+
+TEST(positive_tests, test26)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "bigint_logs.txt",
+                logger::severity::information
+            },
+        });
+    
+    big_integer const one("1");
+    
+    EXPECT_TRUE(big_integer(uint64_t(0)) == big_integer("0"));
+    EXPECT_TRUE(big_integer(uint64_t(1) << 63) == one << 63);
+    EXPECT_TRUE(big_integer(~uint64_t(0)) == big_integer("18446744073709551615"));
+    EXPECT_EQ(big_integer(~uint64_t(0)).bit_length(), 64U);
+    EXPECT_TRUE(big_integer(0) == big_integer("0"));
+    EXPECT_TRUE(big_integer(-4) == big_integer("-4"));
+    EXPECT_TRUE(big_integer(static_cast<short>(-300)) == big_integer("-300"));
+    EXPECT_TRUE(big_integer(int64_t(-1) << 63) == -(one << 63));
+    EXPECT_TRUE(big_integer(int64_t(-1)) + big_integer(1U) == big_integer(0));
+    
+    for (size_t exponent: { 0, 1, 63, 64, 65, 127, 128, 1000 })
+    {
+        EXPECT_TRUE(big_integer::power_of_two(exponent) == one << exponent);
+        EXPECT_EQ(big_integer::power_of_two(exponent).trailing_zero_bits_count(), exponent);
+        EXPECT_EQ((-(big_integer("12345") << exponent)).trailing_zero_bits_count(), exponent);
+    }
+    EXPECT_EQ(big_integer("0").trailing_zero_bits_count(), 0U);
+    
+    delete logger;
+}
+
+TEST(negative_tests, test1)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "bigint_logs.txt",
+                logger::severity::information
+            },
+        });
+    
+    EXPECT_THROW(big_integer::set_multiplication_thresholds(big_integer::multiplication_thresholds{ 1, 4, 8, 16, 32 }), std::invalid_argument);
+    EXPECT_THROW(big_integer::set_multiplication_thresholds(big_integer::multiplication_thresholds{ 32, 16, 256, 1024, 4096 }), std::invalid_argument);
+    EXPECT_THROW(big_integer::set_multiplication_thresholds(big_integer::multiplication_thresholds{ 32, 128, 64, 1024, 4096 }), std::invalid_argument);
+    EXPECT_THROW(big_integer::set_multiplication_thresholds(big_integer::multiplication_thresholds{ 32, 128, 256, 64, 4096 }), std::invalid_argument);
+    EXPECT_THROW(big_integer::set_multiplication_thresholds(big_integer::multiplication_thresholds{ 32, 128, 256, 1024, 512 }), std::invalid_argument);
+    
+    delete logger;
+}
+
+TEST(negative_tests, test2)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "bigint_logs.txt",
+                logger::severity::information
+            },
+        });
+    
+    EXPECT_THROW(big_integer::set_multiplication_parallelism(big_integer::multiplication_parallelism{ 0, 1024 }), std::invalid_argument);
+    
+    delete logger;
+}
+
+TEST(negative_tests, test3)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "bigint_logs.txt",
+                logger::severity::information
+            },
+        });
+    
+    big_integer const value("123456789");
+    
+    EXPECT_THROW(value.to_string(1), std::invalid_argument);
+    EXPECT_THROW(value.to_string(37), std::invalid_argument);
+    EXPECT_THROW(big_integer("12a", 10), std::invalid_argument);
+    
+    delete logger;
+}
+
+TEST(negative_tests, test4)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "bigint_logs.txt",
+                logger::severity::information
+            },
+        });
+    
+    big_integer const value("-" + std::string(100, '5'));
+    std::vector<unsigned char> buffer(value.serialized_size());
+    value.serialize(buffer.data(), buffer.size());
+    size_t bytes_read = 0;
+    
+    EXPECT_THROW(value.serialize(buffer.data(), buffer.size() - 1), std::length_error);
+    EXPECT_THROW(big_integer::deserialize(buffer.data(), buffer.size() - 1, bytes_read), std::invalid_argument);
+    
+    std::stringstream truncated(std::string(buffer.begin(), buffer.end() - 1));
+    EXPECT_THROW(big_integer::deserialize(truncated), std::invalid_argument);
+    
+    buffer[0] = 2;
+    EXPECT_THROW(big_integer::deserialize(buffer.data(), buffer.size(), bytes_read), std::invalid_argument);
+    
+    // a count of 2^60 digits over a stream of a few of them
+    std::vector<unsigned char> corrupted(buffer.begin(), buffer.begin() + 1 + 8 + 16);
+    corrupted[0] = 0;
+    std::fill(corrupted.begin() + 1, corrupted.begin() + 1 + 8, 0);
+    corrupted[8] = 0x10;
+    std::stringstream huge(std::string(corrupted.begin(), corrupted.end()));
+    EXPECT_THROW(big_integer::deserialize(huge), std::invalid_argument);
+    
+    delete logger;
+}
+
+TEST(negative_tests, test5)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "bigint_logs.txt",
+                logger::severity::information
+            },
+        });
+    
+    EXPECT_THROW(big_integer::modular_context(big_integer("1")), std::invalid_argument);
+    EXPECT_THROW(big_integer::modular_context(big_integer("-7")), std::invalid_argument);
+    EXPECT_THROW(big_integer::modular_context(big_integer("1000"), big_integer::reduction_rule::Montgomery), std::invalid_argument);
+    
+    big_integer::modular_context context(big_integer("1000"));
+    EXPECT_THROW(context.inverse(big_integer("15")), std::invalid_argument);
+    EXPECT_THROW(context.power(big_integer("4"), big_integer("-1")), std::invalid_argument);
+    
+    delete logger;
+}
+
+TEST(negative_tests, test6)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "bigint_logs.txt",
+                logger::severity::information
+            },
+        });
+    
+    EXPECT_THROW(big_integer::Newton_divisor(big_integer("0")), std::logic_error);
+    
+    delete logger;
+}
+
+TEST(negative_tests, test7)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "bigint_logs.txt",
+                logger::severity::information
+            },
+        });
+    
+    big_integer dividend("1000");
+    big_integer remainder("0");
+    EXPECT_THROW(big_integer::divmod(dividend, big_integer("0"), remainder), std::logic_error);
+    EXPECT_THROW(big_integer::divmod(dividend, big_integer("7"), dividend), std::invalid_argument);
+    
+    delete logger;
+}
+
+TEST(negative_tests, test8)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "bigint_logs.txt",
+                logger::severity::information
+            },
+        });
+    
+    EXPECT_THROW(big_integer::isqrt(big_integer("-4")), std::invalid_argument);
+    EXPECT_THROW(big_integer::iroot(big_integer("-16"), 4), std::invalid_argument);
+    EXPECT_THROW(big_integer::iroot(big_integer("16"), 0), std::invalid_argument);
+    
+    delete logger;
+}
+
 int main(
     int argc,
     char **argv)
@@ -0,0 +1,115 @@
+#ifndef MP_OS_CONSTANTS_H
+#define MP_OS_CONSTANTS_H
+
+#include <functional>
+
+#include <big_integer.h>
+
+// fixed point values are integers scaled by 2^bits; the constants and the series sums are truncated
+// and within two units of their last bit
+class constants final
+{
+
+public:
+
+    // the binary splitting trees of the series evaluated to at least threshold bits fork their halves onto
+    // a work-stealing pool of threads_count threads, down to depth levels under the root; deeper nodes stay serial
+    struct series_parallelism final
+    {
+
+        size_t threads_count;
+
+        size_t depth;
+
+        size_t threshold;
+
+    };
+
+    // a hypergeometric series sum over n >= 0 of prod(p(k) / (q(k) 2^q_shift), k = 1..n) / b(n);
+    // b is left empty when all of its values are one, which saves a product per node, and the powers of two
+    // of the denominators go by shifts instead of growing the products
+    struct series final
+    {
+
+        std::function<big_integer(uint64_t)> p;
+
+        std::function<big_integer(uint64_t)> q;
+
+        std::function<uint64_t(uint64_t)> b;
+
+        size_t q_shift;
+
+    };
+
+public:
+
+    constants() = delete;
+
+public:
+
+    // the constants keep the binary splitting of the terms taken so far across calls: more bits merge the split
+    // of the next terms into it instead of starting over, fewer shift the most precise value computed
+
+    // Machin's formula pi = 16 atan(1 / 5) - 4 atan(1 / 239)
+    static big_integer pi(
+        size_t bits);
+
+    // ln 2 = 2 atanh(1 / 3)
+    static big_integer ln2(
+        size_t bits);
+
+    // ln 10 = 3 ln 2 + ln(5 / 4) = 6 atanh(1 / 3) + 2 atanh(1 / 9)
+    static big_integer ln10(
+        size_t bits);
+
+    // e = the sum of 1 / n!
+    static big_integer e(
+        size_t bits);
+
+public:
+
+    // numerator_factor / denominator_factor * the sum of the first count terms, by binary splitting
+    static big_integer series_sum(
+        series const &terms,
+        uint64_t count,
+        big_integer const &numerator_factor,
+        big_integer const &denominator_factor,
+        size_t bits);
+
+    // atan(u / (v 2^scale)), or atanh when is_hyperbolic, for 0 < u / (v 2^scale) <= 1 / 2
+    static big_integer inverse_tangent(
+        big_integer const &u,
+        big_integer const &v,
+        size_t scale,
+        bool is_hyperbolic,
+        size_t bits);
+
+    // the first count with log2 of the count-th term below -bits, a few bits lower to cover the rounding of doubles
+    static uint64_t terms_count(
+        std::function<double(uint64_t)> const &log2_term,
+        size_t bits);
+
+    // log2 n!
+    static double log2_factorial(
+        uint64_t n);
+
+    // log2 of a positive value, to the precision of a double
+    static double log2_magnitude(
+        big_integer const &value);
+
+    // bits over a precision that take the truncations of about as many fixed point operations as bits
+    static size_t guard_bits(
+        size_t bits) noexcept;
+
+public:
+
+    static series_parallelism get_series_parallelism() noexcept;
+
+    // process-wide, applies to series started afterwards; a single thread or a zero depth keeps every series serial;
+    // throws std::invalid_argument for zero threads
+    static void set_series_parallelism(
+        series_parallelism const &parallelism);
+
+};
+
+#endif //MP_OS_CONSTANTS_H
\ No newline at end of file
@@ -0,0 +1,429 @@
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <work_stealing_thread_pool.h>
+
+#include "../include/constants.h"
+
+namespace
+{
+
+    // region series parallelism settings
+
+    size_t const default_parallel_series_depth = 6;
+
+    size_t const default_parallel_series_threshold = 1 << 15;
+
+    std::atomic<size_t> series_threads_count(std::max<size_t>(1, std::thread::hardware_concurrency()));
+
+    std::atomic<size_t> parallel_series_depth(default_parallel_series_depth);
+
+    std::atomic<size_t> parallel_series_threshold(default_parallel_series_threshold);
+
+    std::mutex series_pool_mutex;
+    // replaced when the threads count changes, series running on the former pool keep it alive
+    std::shared_ptr<work_stealing_thread_pool> series_pool;
+
+    // the pool to split a series evaluated to bits over, nullptr if it stays serial; products of the nodes
+    // running on its workers split on the same pool, so the tree and its multiplications share the threads
+    std::shared_ptr<work_stealing_thread_pool> get_series_pool(
+        size_t bits)
+    {
+        size_t const threads_count = series_threads_count.load(std::memory_order_relaxed);
+        if (threads_count < 2
+            || parallel_series_depth.load(std::memory_order_relaxed) == 0
+            || bits < parallel_series_threshold.load(std::memory_order_relaxed))
+        {
+            return nullptr;
+        }
+
+        std::lock_guard<std::mutex> lock(series_pool_mutex);
+        if (series_pool == nullptr || series_pool->get_threads_count() != threads_count)
+        {
+            series_pool = std::make_shared<work_stealing_thread_pool>(threads_count);
+        }
+        return series_pool;
+    }
+
+    // endregion series parallelism settings
+
+    // region binary splitting
+
+    // the terms over [first, last) as T / (B * Q * 2^(q_shift * (last - first))), with the product of p(first..last - 1)
+    // in P and of q in Q; the term of n = 0 is one, so it shifts nothing
+    struct series_split
+    {
+        big_integer P;
+        big_integer Q;
+        big_integer B;
+        big_integer T;
+    };
+
+    // the terms over [first, last) from the ones over [first, middle) and the right_count ones over [middle, last):
+    // T = B_right Q_right T_left + B_left P_left T_right
+    series_split merge(
+        constants::series const &terms,
+        series_split const &left,
+        series_split const &right,
+        uint64_t right_count,
+        bool is_product_needed)
+    {
+        series_split result { big_integer(1), left.Q * right.Q, big_integer(1), right.Q * left.T };
+        result.T <<= terms.q_shift * right_count;
+        if (terms.b)
+        {
+            result.T *= right.B;
+            result.T.add_product(left.B * left.P, right.T);
+            result.B = left.B * right.B;
+        }
+        else
+        {
+            result.T.add_product(left.P, right.T);
+        }
+        if (is_product_needed)
+        {
+            result.P = left.P * right.P;
+        }
+        return result;
+    }
+
+    // halves of the range are merged, so the operands of every product are about the same size and the fast
+    // multiplications take the whole work; the rightmost nodes don't need their P; the halves of the nodes
+    // less than depth levels under the root go to the pool's threads unless it is nullptr
+    series_split split(
+        constants::series const &terms,
+        uint64_t first,
+        uint64_t last,
+        bool is_product_needed,
+        work_stealing_thread_pool *pool,
+        size_t depth)
+    {
+        if (last - first == 1)
+        {
+            big_integer P = first == 0
+                ? big_integer(1)
+                : terms.p(first);
+            big_integer Q = first == 0
+                ? big_integer(1)
+                : terms.q(first);
+            big_integer B = terms.b
+                ? big_integer(terms.b(first))
+                : big_integer(1);
+            big_integer T = P;
+            return series_split { std::move(P), std::move(Q), std::move(B), std::move(T) };
+        }
+
+        uint64_t const middle = first + (last - first) / 2;
+        series_split left { big_integer(0), big_integer(0), big_integer(0), big_integer(0) };
+        series_split right { big_integer(0), big_integer(0), big_integer(0), big_integer(0) };
+        if (pool != nullptr && depth > 0)
+        {
+            std::vector<work_stealing_thread_pool::task> tasks;
+            tasks.reserve(2);
+            tasks.emplace_back([&]() { left = split(terms, first, middle, true, pool, depth - 1); });
+            tasks.emplace_back([&]() { right = split(terms, middle, last, is_product_needed, pool, depth - 1); });
+            pool->run_all(tasks);
+        }
+        else
+        {
+            left = split(terms, first, middle, true, nullptr, 0);
+            right = split(terms, middle, last, is_product_needed, nullptr, 0);
+        }
+
+        return merge(terms, left, right, last - middle, is_product_needed);
+    }
+
+    // the split over [first, last) on the series pool for bits
+    series_split split(
+        constants::series const &terms,
+        uint64_t first,
+        uint64_t last,
+        bool is_product_needed,
+        size_t bits)
+    {
+        auto const pool = get_series_pool(bits);
+        return split(terms, first, last, is_product_needed, pool.get(), parallel_series_depth.load(std::memory_order_relaxed));
+    }
+
+    // numerator_factor / denominator_factor * the sum of the first count terms split into sum, scaled by 2^bits;
+    // the quotient goes by Newton's reciprocal once the divisor is long enough
+    big_integer fixed_split_sum(
+        constants::series const &terms,
+        series_split const &sum,
+        uint64_t count,
+        big_integer const &numerator_factor,
+        big_integer const &denominator_factor,
+        size_t bits)
+    {
+        size_t const q_shift = terms.q_shift * (count - 1);
+        big_integer dividend = sum.T * numerator_factor;
+        big_integer divisor = sum.B * sum.Q;
+        divisor *= denominator_factor;
+        if (bits >= q_shift)
+        {
+            dividend <<= bits - q_shift;
+        }
+        else
+        {
+            divisor <<= q_shift - bits;
+        }
+        return big_integer::divide(dividend, divisor, nullptr, big_integer::division_rule::Newton);
+    }
+
+    // the sum of a series with constant factors kept across calls as the split of the terms taken so far
+    struct cached_series
+    {
+        std::mutex mutex;
+        constants::series const terms;
+        std::function<double(uint64_t)> const log2_term;
+        big_integer const numerator_factor;
+        big_integer const denominator_factor;
+        uint64_t count;
+        series_split sum;
+        size_t bits;
+        big_integer value;
+
+        cached_series(
+            constants::series cached_terms,
+            std::function<double(uint64_t)> cached_log2_term,
+            big_integer const &cached_numerator_factor,
+            big_integer const &cached_denominator_factor):
+            terms(std::move(cached_terms)),
+            log2_term(std::move(cached_log2_term)),
+            numerator_factor(cached_numerator_factor),
+            denominator_factor(cached_denominator_factor),
+            count(1),
+            sum(split(terms, 0, 1, true, nullptr, 0)),
+            bits(0),
+            value(big_integer(0))
+        {
+
+        }
+    };
+
+    // the sum scaled by 2^bits; concurrent callers wait for the one refining it, so no precision is computed twice
+    big_integer fixed_cached_sum(
+        cached_series &cache,
+        size_t bits)
+    {
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        if (bits > cache.bits)
+        {
+            // a precision growing a little at a time refines by a quarter at least, so it doesn't divide at every step
+            size_t const target_bits = std::max(bits, cache.bits + cache.bits / 4);
+            uint64_t const count = constants::terms_count(cache.log2_term, target_bits);
+            if (count > cache.count)
+            {
+                cache.sum = merge(cache.terms, cache.sum, split(cache.terms, cache.count, count, true, target_bits), count - cache.count, true);
+                cache.count = count;
+            }
+            cache.value = fixed_split_sum(cache.terms, cache.sum, cache.count, cache.numerator_factor, cache.denominator_factor, target_bits);
+            cache.bits = target_bits;
+        }
+        return cache.value >> (cache.bits - bits);
+    }
+
+    // endregion binary splitting
+
+    // region inverse tangents
+
+    // the series of atan(u / (v 2^scale)), or atanh when is_hyperbolic, over t = u / v: p(n) = -+u^2, q(n) = v^2
+    // with q_shift = 2 scale, b(n) = 2n + 1
+    constants::series inverse_tangent_terms(
+        big_integer const &u,
+        big_integer const &v,
+        size_t scale,
+        bool is_hyperbolic)
+    {
+        big_integer const u_square = is_hyperbolic
+            ? u * u
+            : -(u * u);
+        big_integer const v_square = v * v;
+        return constants::series
+            {
+                [u_square](uint64_t) { return u_square; },
+                [v_square](uint64_t) { return v_square; },
+                [](uint64_t n) { return 2 * n + 1; },
+                2 * scale
+            };
+    }
+
+    // for 0 < u / (v 2^scale) <= 1 / 2 the tail is below t^(2 count + 1) * 4 / 3
+    std::function<double(uint64_t)> inverse_tangent_log2_term(
+        big_integer const &u,
+        big_integer const &v,
+        size_t scale)
+    {
+        double const log2_t = constants::log2_magnitude(u) - constants::log2_magnitude(v) - static_cast<double>(scale);
+        return [log2_t](uint64_t n)
+            {
+                return (2 * n + 1) * log2_t + 1;
+            };
+    }
+
+    // atan(1 / v), or atanh when is_hyperbolic
+    std::unique_ptr<cached_series> make_inverse_tangent_cache(
+        uint64_t v,
+        bool is_hyperbolic)
+    {
+        big_integer const denominator(v);
+        return std::unique_ptr<cached_series>(new cached_series(
+            inverse_tangent_terms(big_integer(1), denominator, 0, is_hyperbolic),
+            inverse_tangent_log2_term(big_integer(1), denominator, 0),
+            big_integer(1),
+            denominator));
+    }
+
+    // ln 2 and ln 10 take it both
+    cached_series &get_hyperbolic_arctangent_third()
+    {
+        static std::unique_ptr<cached_series> const cache = make_inverse_tangent_cache(3, true);
+        return *cache;
+    }
+
+    // endregion inverse tangents
+
+}
+
+big_integer constants::pi(
+    size_t bits)
+{
+    static std::unique_ptr<cached_series> const arctangent_fifth = make_inverse_tangent_cache(5, false);
+    static std::unique_ptr<cached_series> const arctangent_239th = make_inverse_tangent_cache(239, false);
+
+    big_integer result = fixed_cached_sum(*arctangent_fifth, bits + 8) << 4;
+    result -= fixed_cached_sum(*arctangent_239th, bits + 8) << 2;
+    result >>= 8;
+    return result;
+}
+
+big_integer constants::ln2(
+    size_t bits)
+{
+    big_integer result = fixed_cached_sum(get_hyperbolic_arctangent_third(), bits + 8) << 1;
+    result >>= 8;
+    return result;
+}
+
+big_integer constants::ln10(
+    size_t bits)
+{
+    static std::unique_ptr<cached_series> const hyperbolic_arctangent_ninth = make_inverse_tangent_cache(9, true);
+
+    big_integer result = fixed_cached_sum(get_hyperbolic_arctangent_third(), bits + 8) * big_integer(6);
+    result += fixed_cached_sum(*hyperbolic_arctangent_ninth, bits + 8) << 1;
+    result >>= 8;
+    return result;
+}
+
+big_integer constants::e(
+    size_t bits)
+{
+    // p(n) = 1, q(n) = n; the tail is below twice its first term
+    static std::unique_ptr<cached_series> const cache(new cached_series(
+        series
+        {
+            [](uint64_t) { return big_integer(1); },
+            [](uint64_t n) { return big_integer(n); },
+            nullptr,
+            0
+        },
+        [](uint64_t n) { return 1 - log2_factorial(n); },
+        big_integer(1),
+        big_integer(1)));
+
+    return fixed_cached_sum(*cache, bits);
+}
+
+big_integer constants::series_sum(
+    series const &terms,
+    uint64_t count,
+    big_integer const &numerator_factor,
+    big_integer const &denominator_factor,
+    size_t bits)
+{
+    return fixed_split_sum(terms, split(terms, 0, count, false, bits), count, numerator_factor, denominator_factor, bits);
+}
+
+big_integer constants::inverse_tangent(
+    big_integer const &u,
+    big_integer const &v,
+    size_t scale,
+    bool is_hyperbolic,
+    size_t bits)
+{
+    uint64_t const count = terms_count(inverse_tangent_log2_term(u, v, scale), bits);
+
+    // t = u / (v 2^scale) takes 2^-scale off the bits
+    return series_sum(inverse_tangent_terms(u, v, scale, is_hyperbolic), count, u, v, bits - scale);
+}
+
+uint64_t constants::terms_count(
+    std::function<double(uint64_t)> const &log2_term,
+    size_t bits)
+{
+    double const target = -static_cast<double>(bits) - 4;
+    uint64_t count = 1;
+    while (log2_term(count) >= target)
+    {
+        ++count;
+    }
+    return count;
+}
+
+double constants::log2_factorial(
+    uint64_t n)
+{
+    return std::lgamma(static_cast<double>(n) + 1) / std::log(2.0);
+}
+
+double constants::log2_magnitude(
+    big_integer const &value)
+{
+    size_t const bits = value.bit_length();
+    size_t const shift = bits > 53
+        ? bits - 53
+        : 0;
+    return static_cast<double>(shift) + std::log2(std::stod((value >> shift).to_string()));
+}
+
+size_t constants::guard_bits(
+    size_t bits) noexcept
+{
+    size_t width = 0;
+    for (size_t value = bits; value != 0; value >>= 1)
+    {
+        ++width;
+    }
+    return 2 * width + 16;
+}
+
+constants::series_parallelism constants::get_series_parallelism() noexcept
+{
+    series_parallelism parallelism{};
+    parallelism.threads_count = series_threads_count.load(std::memory_order_relaxed);
+    parallelism.depth = parallel_series_depth.load(std::memory_order_relaxed);
+    parallelism.threshold = parallel_series_threshold.load(std::memory_order_relaxed);
+    return parallelism;
+}
+
+void constants::set_series_parallelism(
+    series_parallelism const &parallelism)
+{
+    if (parallelism.threads_count == 0)
+    {
+        throw std::invalid_argument("series need at least one thread");
+    }
+
+    series_threads_count.store(parallelism.threads_count, std::memory_order_relaxed);
+    parallel_series_depth.store(parallelism.depth, std::memory_order_relaxed);
+    parallel_series_threshold.store(parallelism.threshold, std::memory_order_relaxed);
+}
\ No newline at end of file
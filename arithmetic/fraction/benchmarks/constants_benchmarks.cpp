@@ -0,0 +1,94 @@
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fraction.h>
+
+namespace
+{
+
+    double nanoseconds_per_operation(
+        std::function<void()> const &operation)
+    {
+        size_t iterations = 1;
+        while (true)
+        {
+            auto const started_at = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < iterations; ++i)
+            {
+                operation();
+            }
+            auto const elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - started_at).count();
+
+            if (elapsed > 2e8)
+            {
+                return elapsed / static_cast<double>(iterations);
+            }
+            iterations *= 2;
+        }
+    }
+
+    double nanoseconds_of_first_operation(
+        std::function<void()> const &operation)
+    {
+        auto const started_at = std::chrono::steady_clock::now();
+        operation();
+        return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - started_at).count();
+    }
+
+}
+
+int main(
+    int argc,
+    char *argv[])
+{
+    size_t const max_digits = argc > 1
+        ? std::stoul(argv[1])
+        : 64000;
+
+    std::cout
+        << std::left << std::setw(10) << "constant"
+        << std::right << std::setw(10) << "digits"
+        << std::setw(18) << "first ns"
+        << std::setw(18) << "cached ns/op"
+        << std::setw(14) << "vs first"
+        << std::endl;
+
+    fraction const half(big_integer("1"), big_integer("2"));
+
+    std::vector<std::pair<std::string, std::function<fraction(fraction const &)>>> const constants =
+    {
+        { "pi", [](fraction const &epsilon) { return fraction::pi(epsilon); } },
+        { "e", [](fraction const &epsilon) { return fraction::e(epsilon); } },
+        { "ln 2", [&half](fraction const &epsilon) { return half.ln(epsilon); } }
+    };
+
+    // every first call refines the values the previous, four times less precise one left in the caches,
+    // the next calls truncate them
+    for (auto const &constant: constants)
+    {
+        for (size_t digits_count = 1000; digits_count <= max_digits; digits_count *= 4)
+        {
+            fraction const epsilon(big_integer("1"), big_integer("1" + std::string(digits_count, '0')));
+
+            double const first_time = nanoseconds_of_first_operation([&]() { constant.second(epsilon); });
+            double const cached_time = nanoseconds_per_operation([&]() { constant.second(epsilon); });
+
+            std::cout
+                << std::left << std::setw(10) << constant.first
+                << std::right << std::setw(10) << digits_count
+                << std::fixed << std::setprecision(0)
+                << std::setw(18) << first_time
+                << std::setw(18) << cached_time
+                << std::setprecision(2)
+                << std::setw(13) << first_time / cached_time << 'x'
+                << std::endl;
+        }
+    }
+
+    return 0;
+}
\ No newline at end of file
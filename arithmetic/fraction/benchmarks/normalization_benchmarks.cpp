@@ -0,0 +1,130 @@
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fraction.h>
+
+namespace
+{
+
+    double nanoseconds_per_operation(
+        std::function<void()> const &operation)
+    {
+        size_t iterations = 1;
+        while (true)
+        {
+            auto const started_at = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < iterations; ++i)
+            {
+                operation();
+            }
+            auto const elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - started_at).count();
+
+            if (elapsed > 2e8)
+            {
+                return elapsed / static_cast<double>(iterations);
+            }
+            iterations *= 2;
+        }
+    }
+
+    fraction make_fraction(
+        std::string const &numerator,
+        std::string const &denominator = "1")
+    {
+        return fraction(big_integer(numerator), big_integer(denominator));
+    }
+
+}
+
+int main(
+    int argc,
+    char *argv[])
+{
+    size_t const max_terms = argc > 1
+        ? std::stoul(argv[1])
+        : 800;
+
+    std::vector<std::pair<std::string, fraction::normalization_rule>> const rules =
+    {
+        { "eager", fraction::normalization_rule::eager },
+        { "lazy", fraction::normalization_rule::lazy }
+    };
+
+    std::cout
+        << std::left << std::setw(10) << "sum"
+        << std::right << std::setw(10) << "terms"
+        << std::setw(10) << "rule"
+        << std::setw(16) << "ns/op"
+        << std::setw(14) << "vs eager"
+        << std::endl;
+
+    // sums taken term by term through the fraction arithmetic, the way series are written against the class
+    for (size_t terms_count = 50; terms_count <= max_terms; terms_count *= 2)
+    {
+        std::vector<std::pair<std::string, std::function<void()>>> const sums =
+        {
+            { "e", [terms_count]()
+                {
+                    fraction sum = make_fraction("0");
+                    fraction term = make_fraction("1");
+                    for (size_t n = 1; n <= terms_count; ++n)
+                    {
+                        sum += term;
+                        term *= make_fraction("1", std::to_string(n));
+                    }
+                } },
+            { "harmonic", [terms_count]()
+                {
+                    fraction sum = make_fraction("0");
+                    for (size_t n = 1; n <= terms_count; ++n)
+                    {
+                        sum += make_fraction("1", std::to_string(n));
+                    }
+                } },
+            { "atan 1/5", [terms_count]()
+                {
+                    fraction const square = make_fraction("-1", "25");
+                    fraction sum = make_fraction("0");
+                    fraction power = make_fraction("1", "5");
+                    for (size_t n = 0; n < terms_count; ++n)
+                    {
+                        sum += power * make_fraction("1", std::to_string(2 * n + 1));
+                        power *= square;
+                    }
+                } }
+        };
+
+        for (auto const &sum: sums)
+        {
+            double eager_time = 0;
+            for (auto const &rule: rules)
+            {
+                fraction::set_normalization(rule.second);
+                double const time = nanoseconds_per_operation(sum.second);
+                if (rule.second == fraction::normalization_rule::eager)
+                {
+                    eager_time = time;
+                }
+
+                std::cout
+                    << std::left << std::setw(10) << sum.first
+                    << std::right << std::setw(10) << terms_count
+                    << std::setw(10) << rule.first
+                    << std::fixed << std::setprecision(0)
+                    << std::setw(16) << time
+                    << std::setprecision(2)
+                    << std::setw(13) << eager_time / time << 'x'
+                    << std::endl;
+            }
+        }
+    }
+
+    fraction::set_normalization(fraction::normalization_rule::eager);
+
+    return 0;
+}
\ No newline at end of file
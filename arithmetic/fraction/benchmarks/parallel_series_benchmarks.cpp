@@ -0,0 +1,118 @@
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <fraction.h>
+
+namespace
+{
+
+    double nanoseconds_per_operation(
+        std::function<void()> const &operation)
+    {
+        size_t iterations = 1;
+        while (true)
+        {
+            auto const started_at = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < iterations; ++i)
+            {
+                operation();
+            }
+            auto const elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - started_at).count();
+
+            if (elapsed > 2e8)
+            {
+                return elapsed / static_cast<double>(iterations);
+            }
+            iterations *= 2;
+        }
+    }
+
+    // 0.123456789012... with digits_count digits after the point, so the argument is as long as the precision
+    fraction make_argument(
+        size_t digits_count)
+    {
+        std::string digits(digits_count, '0');
+        for (size_t i = 0; i < digits_count; ++i)
+        {
+            digits[i] = static_cast<char>('0' + (i + 1) % 10);
+        }
+        return fraction(big_integer(digits), big_integer("1" + std::string(digits_count, '0')));
+    }
+
+}
+
+int main(
+    int argc,
+    char *argv[])
+{
+    size_t const digits_count = argc > 1
+        ? std::stoul(argv[1])
+        : 64000;
+    size_t const max_threads_count = argc > 2
+        ? std::stoul(argv[2])
+        : std::max<size_t>(1, std::thread::hardware_concurrency());
+    size_t const depth = argc > 3
+        ? std::stoul(argv[3])
+        : fraction::get_series_parallelism().depth;
+
+    fraction::series_parallelism const series_parallelism = fraction::get_series_parallelism();
+    big_integer::multiplication_parallelism const multiplication_parallelism = big_integer::get_multiplication_parallelism();
+
+    std::cout
+        << std::left << std::setw(10) << "function"
+        << std::right << std::setw(10) << "digits"
+        << std::setw(10) << "threads"
+        << std::setw(10) << "depth"
+        << std::setw(18) << "ns/op"
+        << std::setw(14) << "vs 1 thread"
+        << std::endl;
+
+    std::vector<std::pair<std::string, std::function<fraction(fraction const &, fraction const &)>>> const functions =
+    {
+        { "sin", [](fraction const &x, fraction const &epsilon) { return x.sin(epsilon); } },
+        { "arctg", [](fraction const &x, fraction const &epsilon) { return x.arctg(epsilon); } },
+        { "ln", [](fraction const &x, fraction const &epsilon) { return x.ln(epsilon); } }
+    };
+
+    fraction const x = make_argument(digits_count);
+    fraction const epsilon(big_integer("1"), big_integer("1" + std::string(digits_count, '0')));
+
+    // the trees and the products of their nodes take the same threads count, so one thread is the serial evaluation
+    for (auto const &function: functions)
+    {
+        double serial_time = 0;
+        for (size_t threads_count = 1; threads_count <= max_threads_count; threads_count *= 2)
+        {
+            fraction::set_series_parallelism(fraction::series_parallelism { threads_count, depth, 0 });
+            big_integer::set_multiplication_parallelism(big_integer::multiplication_parallelism { threads_count, multiplication_parallelism.threshold });
+
+            double const time = nanoseconds_per_operation([&]() { function.second(x, epsilon); });
+            if (threads_count == 1)
+            {
+                serial_time = time;
+            }
+
+            std::cout
+                << std::left << std::setw(10) << function.first
+                << std::right << std::setw(10) << digits_count
+                << std::setw(10) << threads_count
+                << std::setw(10) << depth
+                << std::fixed << std::setprecision(0)
+                << std::setw(18) << time
+                << std::setprecision(2)
+                << std::setw(13) << serial_time / time << 'x'
+                << std::endl;
+        }
+    }
+
+    fraction::set_series_parallelism(series_parallelism);
+    big_integer::set_multiplication_parallelism(multiplication_parallelism);
+
+    return 0;
+}
\ No newline at end of file
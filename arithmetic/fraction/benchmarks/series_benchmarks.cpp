@@ -0,0 +1,101 @@
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fraction.h>
+
+namespace
+{
+
+    double nanoseconds_per_operation(
+        std::function<void()> const &operation)
+    {
+        size_t iterations = 1;
+        while (true)
+        {
+            auto const started_at = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < iterations; ++i)
+            {
+                operation();
+            }
+            auto const elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - started_at).count();
+
+            if (elapsed > 2e8)
+            {
+                return elapsed / static_cast<double>(iterations);
+            }
+            iterations *= 2;
+        }
+    }
+
+    // 0.123456789012... with digits_count digits after the point, so the argument is as long as the precision
+    fraction make_argument(
+        size_t digits_count)
+    {
+        std::string digits(digits_count, '0');
+        for (size_t i = 0; i < digits_count; ++i)
+        {
+            digits[i] = static_cast<char>('0' + (i + 1) % 10);
+        }
+        return fraction(big_integer(digits), big_integer("1" + std::string(digits_count, '0')));
+    }
+
+}
+
+int main(
+    int argc,
+    char *argv[])
+{
+    size_t const max_digits = argc > 1
+        ? std::stoul(argv[1])
+        : 64000;
+
+    std::cout
+        << std::left << std::setw(10) << "function"
+        << std::right << std::setw(10) << "digits"
+        << std::setw(18) << "ns/op"
+        << std::setw(20) << "vs 4x fewer digits"
+        << std::endl;
+
+    std::vector<std::pair<std::string, std::function<fraction(fraction const &, fraction const &)>>> const functions =
+    {
+        { "sin", [](fraction const &x, fraction const &epsilon) { return x.sin(epsilon); } },
+        { "arctg", [](fraction const &x, fraction const &epsilon) { return x.arctg(epsilon); } },
+        { "ln", [](fraction const &x, fraction const &epsilon) { return x.ln(epsilon); } },
+        { "arcsin", [](fraction const &x, fraction const &epsilon) { return x.arcsin(epsilon); } }
+    };
+
+    // binary splitting grows as the products do: about nine times for four times more digits in the Karatsuba range,
+    // a bit over four once the NTT takes them; term by term summation grows sixteen times and more
+    for (auto const &function: functions)
+    {
+        double previous_time = 0;
+        for (size_t digits_count = 1000; digits_count <= max_digits; digits_count *= 4)
+        {
+            fraction const x = make_argument(digits_count);
+            fraction const epsilon(big_integer("1"), big_integer("1" + std::string(digits_count, '0')));
+
+            double const time = nanoseconds_per_operation([&]() { function.second(x, epsilon); });
+
+            std::cout
+                << std::left << std::setw(10) << function.first
+                << std::right << std::setw(10) << digits_count
+                << std::fixed << std::setprecision(0)
+                << std::setw(18) << time;
+            if (previous_time != 0)
+            {
+                std::cout
+                    << std::setprecision(2)
+                    << std::setw(19) << time / previous_time << 'x';
+            }
+            std::cout << std::endl;
+            previous_time = time;
+        }
+    }
+
+    return 0;
+}
\ No newline at end of file
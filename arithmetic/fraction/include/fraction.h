@@ -1,156 +1,258 @@
-#ifndef MP_OS_FRACTION_H
-#define MP_OS_FRACTION_H
-
-#include <big_integer.h>
-
-class fraction final
-{
-
-private:
-
-    big_integer _numerator;
-    big_integer _denominator;
-
-public:
-
-    fraction(
-        big_integer &&numerator,
-        big_integer &&denominator);
-
-public:
-
-    ~fraction() noexcept;
-
-    fraction(
-        fraction const &other);
-
-    fraction &operator=(
-        fraction const &other);
-
-    fraction(
-        fraction &&other) noexcept;
-
-    fraction &operator=(
-        fraction &&other) noexcept;
-
-public:
-
-    fraction &operator+=(
-        fraction const &other);
-
-    fraction operator+(
-        fraction const &other) const;
-
-    fraction &operator-=(
-        fraction const &other);
-
-    fraction operator-(
-        fraction const &other) const;
-
-    fraction &operator*=(
-        fraction const &other);
-
-    fraction operator*(
-        fraction const &other) const;
-
-    fraction &operator/=(
-        fraction const &other);
-
-    fraction operator/(
-        fraction const &other) const;
-
-public:
-
-    bool operator==(
-        fraction const &other) const;
-
-    bool operator!=(
-        fraction const &other) const;
-
-public:
-
-    bool operator>=(
-        fraction const &other) const;
-
-    bool operator>(
-        fraction const &other) const;
-
-    bool operator<=(
-        fraction const &other) const;
-
-    bool operator<(
-        fraction const &other) const;
-
-public:
-
-    friend std::ostream &operator<<(
-        std::ostream &stream,
-        fraction const &obj);
-
-    friend std::istream &operator>>(
-        std::istream &stream,
-        fraction &obj);
-
-public:
-
-    fraction sin(
-        fraction const &epsilon) const;
-
-    fraction cos(
-        fraction const &epsilon) const;
-
-    fraction tg(
-        fraction const &epsilon) const;
-
-    fraction ctg(
-        fraction const &epsilon) const;
-
-    fraction sec(
-        fraction const &epsilon) const;
-
-    fraction cosec(
-        fraction const &epsilon) const;
-
-    fraction arcsin(
-        fraction const &epsilon) const;
-
-    fraction arccos(
-        fraction const &epsilon) const;
-
-    fraction arctg(
-        fraction const &epsilon) const;
-
-    fraction arcctg(
-        fraction const &epsilon) const;
-
-    fraction arcsec(
-        fraction const &epsilon) const;
-
-    fraction arccosec(
-        fraction const &epsilon) const;
-
-public:
-
-    fraction pow(
-        size_t degree) const;
-
-public:
-
-    fraction root(
-        size_t degree,
-        fraction const &epsilon) const;
-
-public:
-
-    fraction log2(
-        fraction const &epsilon) const;
-
-    fraction ln(
-        fraction const &epsilon) const;
-
-    fraction lg(
-        fraction const &epsilon) const;
-
-};
-
+#ifndef MP_OS_FRACTION_H
+#define MP_OS_FRACTION_H
+
+#include <big_integer.h>
+#include <constants.h>
+
+class fraction final
+{
+
+public:
+
+    // eager normalization reduces every result by the gcd of its numerator and denominator;
+    // lazy normalization strips common powers of two only, and takes the gcd once the size of a value
+    // doubles since its last reduction and exceeds the threshold
+    enum class normalization_rule
+    {
+        eager,
+        lazy
+    };
+
+    // the binary splitting trees of the series are shared with the constants
+    using series_parallelism = constants::series_parallelism;
+
+private:
+
+    // the denominator is positive, the sign goes with the numerator
+    big_integer _numerator;
+    big_integer _denominator;
+
+    // bits of the numerator and denominator after the last full reduction
+    size_t _normalized_bits;
+
+public:
+
+    // throws std::invalid_argument for a zero denominator
+    fraction(
+        big_integer &&numerator,
+        big_integer &&denominator);
+
+public:
+
+    ~fraction() noexcept;
+
+    fraction(
+        fraction const &other);
+
+    fraction &operator=(
+        fraction const &other);
+
+    fraction(
+        fraction &&other) noexcept;
+
+    fraction &operator=(
+        fraction &&other) noexcept;
+
+public:
+
+    fraction &operator+=(
+        fraction const &other);
+
+    fraction operator+(
+        fraction const &other) const;
+
+    fraction &operator-=(
+        fraction const &other);
+
+    fraction operator-(
+        fraction const &other) const;
+
+    fraction &operator*=(
+        fraction const &other);
+
+    fraction operator*(
+        fraction const &other) const;
+
+    fraction &operator/=(
+        fraction const &other);
+
+    fraction operator/(
+        fraction const &other) const;
+
+public:
+
+    bool operator==(
+        fraction const &other) const;
+
+    bool operator!=(
+        fraction const &other) const;
+
+public:
+
+    bool operator>=(
+        fraction const &other) const;
+
+    bool operator>(
+        fraction const &other) const;
+
+    bool operator<=(
+        fraction const &other) const;
+
+    bool operator<(
+        fraction const &other) const;
+
+public:
+
+    // "numerator/denominator" reduced, or the numerator alone for an integer
+    friend std::ostream &operator<<(
+        std::ostream &stream,
+        fraction const &obj);
+
+    friend std::istream &operator>>(
+        std::istream &stream,
+        fraction &obj);
+
+public:
+
+    // the functions are within a positive epsilon of their values, otherwise they throw std::invalid_argument,
+    // as they do outside their domains; poles throw std::logic_error;
+    // the series are summed by binary splitting after a bit-burst reduction of the argument, so the time follows
+    // the products of as many digits as epsilon asks for, up to logarithmic factors
+
+    fraction sin(
+        fraction const &epsilon) const;
+
+    fraction cos(
+        fraction const &epsilon) const;
+
+    fraction tg(
+        fraction const &epsilon) const;
+
+    fraction ctg(
+        fraction const &epsilon) const;
+
+    fraction sec(
+        fraction const &epsilon) const;
+
+    fraction cosec(
+        fraction const &epsilon) const;
+
+    fraction arcsin(
+        fraction const &epsilon) const;
+
+    fraction arccos(
+        fraction const &epsilon) const;
+
+    fraction arctg(
+        fraction const &epsilon) const;
+
+    // in (0, pi)
+    fraction arcctg(
+        fraction const &epsilon) const;
+
+    fraction arcsec(
+        fraction const &epsilon) const;
+
+    fraction arccosec(
+        fraction const &epsilon) const;
+
+public:
+
+    // 0^0 = 1
+    fraction pow(
+        size_t degree) const;
+
+public:
+
+    fraction root(
+        size_t degree,
+        fraction const &epsilon) const;
+
+public:
+
+    fraction log2(
+        fraction const &epsilon) const;
+
+    fraction ln(
+        fraction const &epsilon) const;
+
+    fraction lg(
+        fraction const &epsilon) const;
+
+public:
+
+    // pi, e and the logarithms of 2 and 10 the functions take come from process-wide caches of the most precise
+    // values computed so far, which less precise requests truncate and more precise ones refine
+
+    static fraction pi(
+        fraction const &epsilon);
+
+    static fraction e(
+        fraction const &epsilon);
+
+public:
+
+    // process-wide; a zero threshold takes the default one
+    static void set_normalization(
+        normalization_rule rule,
+        size_t lazy_normalization_threshold = 0);
+
+    static normalization_rule get_normalization_rule() noexcept;
+
+    static size_t get_lazy_normalization_threshold() noexcept;
+
+    static series_parallelism get_series_parallelism() noexcept;
+
+    // process-wide, applies to series started afterwards; a single thread or a zero depth keeps every series serial
+    static void set_series_parallelism(
+        series_parallelism const &parallelism);
+
+private:
+
+    // reduces by the gcd
+    void normalize();
+
+    // takes the sign to the numerator, then reduces as the normalization rule tells
+    void settle();
+
+    // *this * 2^bits, rounded towards zero
+    big_integer to_fixed(
+        size_t bits) const;
+
+    // the bits the functions are evaluated with to be within epsilon
+    static size_t get_working_bits(
+        fraction const &epsilon);
+
+    // sine and cosine scaled by 2^bits
+    void fixed_sin_cos(
+        big_integer &sine,
+        big_integer &cosine,
+        size_t bits) const;
+
+    // |*this| <= 1
+    big_integer fixed_arcsin(
+        size_t bits) const;
+
+    big_integer fixed_arctangent(
+        size_t bits) const;
+
+    // *this > 0
+    big_integer fixed_ln(
+        size_t bits) const;
+
+    size_t get_bits_count() const noexcept;
+
+    bool is_zero() const;
+
+    bool is_negative() const;
+
+    static int compare(
+        fraction const &first,
+        fraction const &second);
+
+    static void throw_if_invalid_epsilon(
+        fraction const &epsilon);
+
+};
+
 #endif //MP_OS_FRACTION_H
\ No newline at end of file
@@ -1,244 +1,961 @@
-#include "../include/fraction.h"
-
-fraction::fraction(
-    big_integer &&numerator,
-    big_integer &&denominator):
-        _numerator(std::forward<big_integer>(numerator)),
-        _denominator(std::forward<big_integer>(denominator))
-{
-    throw not_implemented("fraction::fraction(big_integer &&, big_integer &&)", "your code should be here...");
-}
-
-fraction::~fraction()
-{
-    throw not_implemented("fraction::~fraction()", "your code should be here...");
-}
-
-fraction::fraction(
-    fraction const &other):
-        _numerator(other._numerator),
-        _denominator(other._denominator)
-{
-    throw not_implemented("fraction::fraction(fraction const &)", "your code should be here...");
-}
-
-fraction &fraction::operator=(
-    fraction const &other)
-{
-    throw not_implemented("fraction &fraction::operator=(fraction const &)", "your code should be here...");
-}
-
-fraction::fraction(
-    fraction &&other) noexcept:
-        _numerator(std::move(other._numerator)),
-        _denominator(std::move(other._denominator))
-{
-    throw not_implemented("fraction::fraction(fraction &&) noexcept", "your code should be here...");
-}
-
-fraction &fraction::operator=(
-    fraction &&other) noexcept
-{
-    throw not_implemented("fraction &fraction::operator=(fraction &&) noexcept", "your code should be here...");
-}
-
-fraction &fraction::operator+=(
-    fraction const &other)
-{
-    throw not_implemented("fraction &fraction::operator+=(fraction const &)", "your code should be here...");
-}
-
-fraction fraction::operator+(
-    fraction const &other) const
-{
-    throw not_implemented("fraction fraction::operator+(fraction const &) const", "your code should be here...");
-}
-
-fraction &fraction::operator-=(
-    fraction const &other)
-{
-    throw not_implemented("fraction &fraction::operator-=(fraction const &)", "your code should be here...");
-}
-
-fraction fraction::operator-(
-    fraction const &other) const
-{
-    throw not_implemented("fraction fraction::operator-(fraction const &) const", "your code should be here...");
-}
-
-fraction &fraction::operator*=(
-    fraction const &other)
-{
-    throw not_implemented("fraction &fraction::operator*=(fraction const &)", "your code should be here...");
-}
-
-fraction fraction::operator*(
-    fraction const &other) const
-{
-    throw not_implemented("fraction fraction::operator*(fraction const &) const", "your code should be here...");
-}
-
-fraction &fraction::operator/=(
-    fraction const &other)
-{
-    throw not_implemented("fraction &fraction::operator/=(fraction const &)", "your code should be here...");
-}
-
-fraction fraction::operator/(
-    fraction const &other) const
-{
-    throw not_implemented("fraction fraction::operator/(fraction const &) const", "your code should be here...");
-}
-
-bool fraction::operator==(
-    fraction const &other) const
-{
-    throw not_implemented("bool fraction::operator==(fraction const &) const", "your code should be here...");
-}
-
-bool fraction::operator!=(
-    fraction const &other) const
-{
-    throw not_implemented("bool fraction::operator!=(fraction const &) const", "your code should be here...");
-}
-
-bool fraction::operator>=(
-    fraction const &other) const
-{
-    throw not_implemented("bool fraction::operator>=(fraction const &) const", "your code should be here...");
-}
-
-bool fraction::operator>(
-    fraction const &other) const
-{
-    throw not_implemented("bool fraction::operator>(fraction const &) const", "your code should be here...");
-}
-
-bool fraction::operator<=(
-    fraction const &other) const
-{
-    throw not_implemented("bool fraction::operator<=(fraction const &) const", "your code should be here...");
-}
-
-bool fraction::operator<(
-    fraction const &other) const
-{
-    throw not_implemented("bool fraction::operator<(fraction const &) const", "your code should be here...");
-}
-
-std::ostream &operator<<(
-    std::ostream &stream,
-    fraction const &obj)
-{
-    throw not_implemented("std::ostream &operator<<(std::ostream &, fraction const &)", "your code should be here...");
-}
-
-std::istream &operator>>(
-    std::istream &stream,
-    fraction &obj)
-{
-    throw not_implemented("std::istream &operator>>(std::istream &, fraction &)", "your code should be here...");
-}
-
-fraction fraction::sin(
-    fraction const &epsilon) const
-{
-    throw not_implemented("fraction fraction::sin(fraction const &) const", "your code should be here...");
-}
-
-fraction fraction::cos(
-    fraction const &epsilon) const
-{
-    throw not_implemented("fraction fraction::cos(fraction const &) const", "your code should be here...");
-}
-
-fraction fraction::tg(
-    fraction const &epsilon) const
-{
-    throw not_implemented("fraction fraction::tg(fraction const &) const", "your code should be here...");
-}
-
-fraction fraction::ctg(
-    fraction const &epsilon) const
-{
-    throw not_implemented("fraction fraction::ctg(fraction const &) const", "your code should be here...");
-}
-
-fraction fraction::sec(
-    fraction const &epsilon) const
-{
-    throw not_implemented("fraction fraction::sec(fraction const &) const", "your code should be here...");
-}
-
-fraction fraction::cosec(
-    fraction const &epsilon) const
-{
-    throw not_implemented("fraction fraction::cosec(fraction const &) const", "your code should be here...");
-}
-
-fraction fraction::arcsin(
-    fraction const &epsilon) const
-{
-    throw not_implemented("fraction fraction::arcsin(fraction const &) const", "your code should be here...");
-}
-
-fraction fraction::arccos(
-    fraction const &epsilon) const
-{
-    throw not_implemented("fraction fraction::arccos(fraction const &) const", "your code should be here...");
-}
-
-fraction fraction::arctg(
-    fraction const &epsilon) const
-{
-    throw not_implemented("fraction fraction::arctg(fraction const &) const", "your code should be here...");
-}
-
-fraction fraction::arcctg(
-    fraction const &epsilon) const
-{
-    throw not_implemented("fraction fraction::arcctg(fraction const &) const", "your code should be here...");
-}
-
-fraction fraction::arcsec(
-    fraction const &epsilon) const
-{
-    throw not_implemented("fraction fraction::arcsec(fraction const &) const", "your code should be here...");
-}
-
-fraction fraction::arccosec(
-    fraction const &epsilon) const
-{
-    throw not_implemented("fraction fraction::arccosec(fraction const &) const", "your code should be here...");
-}
-
-fraction fraction::pow(
-    size_t degree) const
-{
-    throw not_implemented("fraction fraction::pow(size_t) const", "your code should be here...");
-}
-
-fraction fraction::root(
-    size_t degree,
-    fraction const &epsilon) const
-{
-    throw not_implemented("fraction fraction::root(size_t, fraction const &) const", "your code should be here...");
-}
-
-fraction fraction::log2(
-    fraction const &epsilon) const
-{
-    throw not_implemented("fraction fraction::log2(fraction const &) const", "your code should be here...");
-}
-
-fraction fraction::ln(
-    fraction const &epsilon) const
-{
-    throw not_implemented("fraction fraction::ln(fraction const &) const", "your code should be here...");
-}
-
-fraction fraction::lg(
-    fraction const &epsilon) const
-{
-    throw not_implemented("fraction fraction::lg(fraction const &) const", "your code should be here...");
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "../include/fraction.h"
+
+namespace
+{
+
+    // region normalization settings
+
+    size_t const default_lazy_normalization_threshold = 2048;
+
+    std::atomic<fraction::normalization_rule> normalization(fraction::normalization_rule::eager);
+
+    std::atomic<size_t> normalization_threshold(default_lazy_normalization_threshold);
+
+    // endregion normalization settings
+
+    // region fixed point kernels
+
+    // fixed point values are integers scaled by 2^bits, every operation truncates
+
+    // dividend / divisor for nonnegative operands, by Newton's reciprocal once the divisor is long enough
+    big_integer fixed_quotient(
+        big_integer const &dividend,
+        big_integer const &divisor)
+    {
+        return big_integer::divide(dividend, divisor, nullptr, big_integer::division_rule::Newton);
+    }
+
+    // sin(u / 2^scale) and cos(u / 2^scale) for 0 < u <= 2^scale <= 2^bits: p(n) = -u^2, q(n) = (2n) (2n + 1)
+    // for the sine over x and (2n - 1) (2n) for the cosine, with q_shift = 2 scale; the alternating tails
+    // stay below their first terms
+    void fixed_sin_cos_series(
+        big_integer const &u,
+        size_t scale,
+        size_t bits,
+        big_integer &sine,
+        big_integer &cosine)
+    {
+        big_integer const u_square = -(u * u);
+        double const log2_x = constants::log2_magnitude(u) - static_cast<double>(scale);
+        uint64_t const count = constants::terms_count([log2_x](uint64_t n)
+            {
+                return std::max(2 * n * log2_x - constants::log2_factorial(2 * n), (2 * n + 1) * log2_x - constants::log2_factorial(2 * n + 1));
+            }, bits);
+
+        // the sine takes x = u / 2^scale as 2^-scale off its bits
+        sine = constants::series_sum(constants::series
+            {
+                [&u_square](uint64_t) { return u_square; },
+                [](uint64_t n) { return big_integer(2 * n * (2 * n + 1)); },
+                nullptr,
+                2 * scale
+            }, count, u, big_integer(1), bits - scale);
+        cosine = constants::series_sum(constants::series
+            {
+                [&u_square](uint64_t) { return u_square; },
+                [](uint64_t n) { return big_integer((2 * n - 1) * 2 * n); },
+                nullptr,
+                2 * scale
+            }, count, big_integer(1), big_integer(1), bits);
+    }
+
+    // the bit-burst method: x splits into chunks of 8, 16, 32, ... bits, so every series runs for an argument
+    // of as many bits as it needs terms for the precision over their count, and its splitting stays quasi-linear
+
+    size_t const first_chunk_bits = 8;
+
+    // sine and cosine of 0 <= x <= 1 by sin(a + b) = sin a cos b + cos a sin b, cos(a + b) = cos a cos b - sin a sin b
+    // over the chunks; the angles stay below one, so the sums do as well and never go negative
+    void fixed_sin_cos_reduced(
+        big_integer remainder,
+        size_t bits,
+        big_integer &sine,
+        big_integer &cosine)
+    {
+        sine = big_integer(0);
+        cosine = big_integer::power_of_two(bits);
+        for (size_t chunk_bits = first_chunk_bits; remainder != big_integer(0); chunk_bits *= 2)
+        {
+            size_t const shift = bits > chunk_bits
+                ? bits - chunk_bits
+                : 0;
+            big_integer const chunk = remainder >> shift;
+            if (chunk == big_integer(0))
+            {
+                continue;
+            }
+            remainder -= chunk << shift;
+
+            big_integer chunk_sine(0);
+            big_integer chunk_cosine(0);
+            fixed_sin_cos_series(chunk, bits - shift, bits, chunk_sine, chunk_cosine);
+
+            big_integer next_sine = sine * chunk_cosine;
+            next_sine.add_product(cosine, chunk_sine);
+            cosine *= chunk_cosine;
+            cosine.subtract_product(sine, chunk_sine);
+            sine = std::move(next_sine);
+            sine >>= bits;
+            cosine >>= bits;
+        }
+    }
+
+    // atan x, or atanh x when is_hyperbolic, for 0 <= x <= 1 / 2 by f(x) = f(a) + f((x - a) / (1 +- x a)), with a
+    // the leading chunk of x; the new argument is below the unit of the last bit of a
+    big_integer fixed_inverse_tangent_reduced(
+        big_integer value,
+        bool is_hyperbolic,
+        size_t bits)
+    {
+        big_integer result(0);
+        for (size_t chunk_bits = first_chunk_bits; value != big_integer(0); chunk_bits *= 2)
+        {
+            size_t const shift = bits > chunk_bits
+                ? bits - chunk_bits
+                : 0;
+            big_integer const chunk = value >> shift;
+            if (chunk == big_integer(0))
+            {
+                continue;
+            }
+            size_t const chunk_scale = bits - shift;
+
+            result += constants::inverse_tangent(chunk, big_integer(1), chunk_scale, is_hyperbolic, bits);
+
+            big_integer dividend = value - (chunk << shift);
+            dividend <<= bits + chunk_scale;
+            big_integer divisor = big_integer::power_of_two(bits + chunk_scale);
+            if (is_hyperbolic)
+            {
+                divisor.subtract_product(value, chunk);
+            }
+            else
+            {
+                divisor.add_product(value, chunk);
+            }
+            value = fixed_quotient(dividend, divisor);
+        }
+        return result;
+    }
+
+    // atan x for 0 <= x <= 1; atan x = pi / 4 - atan((1 - x) / (1 + x)) takes the arguments over 7 / 16 below 9 / 23
+    big_integer fixed_arctangent_reduced(
+        big_integer const &value,
+        size_t bits)
+    {
+        if (value <= big_integer(7) << (bits - 4))
+        {
+            return fixed_inverse_tangent_reduced(value, false, bits);
+        }
+
+        big_integer const unit = big_integer::power_of_two(bits);
+        return (constants::pi(bits) >> 2) - fixed_inverse_tangent_reduced(fixed_quotient((unit - value) << bits, unit + value), false, bits);
+    }
+
+    // ln y = 2 atanh((y - 1) / (y + 1)) for 1 / 2 < y < 2, with |(y - 1) / (y + 1)| < 1 / 3
+    big_integer fixed_ln_reduced(
+        big_integer const &value,
+        size_t bits)
+    {
+        big_integer const unit = big_integer::power_of_two(bits);
+        bool const is_below_one = value < unit;
+        big_integer const result = fixed_inverse_tangent_reduced(fixed_quotient((is_below_one
+            ? unit - value
+            : value - unit) << bits, value + unit), true, bits) << 1;
+        return is_below_one
+            ? -result
+            : result;
+    }
+
+    // endregion fixed point kernels
+
+    // region fractions
+
+    fraction make_fraction(
+        uint64_t numerator,
+        uint64_t denominator = 1)
+    {
+        return fraction(big_integer(numerator), big_integer(denominator));
+    }
+
+    fraction from_fixed(
+        big_integer &&value,
+        size_t bits)
+    {
+        return fraction(std::move(value), big_integer::power_of_two(bits));
+    }
+
+    fraction absolute(
+        fraction const &value)
+    {
+        fraction const zero_value = make_fraction(0);
+        return value < zero_value
+            ? zero_value - value
+            : value;
+    }
+
+    // numerator / denominator within epsilon from approximations within delta, refined until
+    // delta * (|n| + |d|) / (|d| * (|d| - delta)) bounds the error by epsilon; the denominator can't be zero
+    fraction quotient(
+        std::function<fraction(fraction const &)> const &numerator,
+        std::function<fraction(fraction const &)> const &denominator,
+        fraction const &epsilon)
+    {
+        fraction delta = epsilon;
+        while (true)
+        {
+            fraction const numerator_value = numerator(delta);
+            fraction const denominator_value = denominator(delta);
+            fraction const denominator_magnitude = absolute(denominator_value);
+            if (denominator_magnitude > delta)
+            {
+                fraction const error_bound = delta * (denominator_magnitude + absolute(numerator_value))
+                    / (denominator_magnitude * (denominator_magnitude - delta));
+                if (error_bound <= epsilon)
+                {
+                    return numerator_value / denominator_value;
+                }
+            }
+            delta *= make_fraction(1, 16);
+        }
+    }
+
+    // endregion fractions
+
+}
+
+fraction::fraction(
+    big_integer &&numerator,
+    big_integer &&denominator):
+        _numerator(std::forward<big_integer>(numerator)),
+        _denominator(std::forward<big_integer>(denominator)),
+        _normalized_bits(0)
+{
+    if (_denominator == big_integer(0))
+    {
+        throw std::invalid_argument("denominator can't be zero");
+    }
+
+    if (_denominator < big_integer(0))
+    {
+        _numerator = -_numerator;
+        _denominator = -_denominator;
+    }
+    normalize();
+}
+
+fraction::~fraction() noexcept = default;
+
+fraction::fraction(
+    fraction const &other) = default;
+
+fraction &fraction::operator=(
+    fraction const &other) = default;
+
+fraction::fraction(
+    fraction &&other) noexcept = default;
+
+fraction &fraction::operator=(
+    fraction &&other) noexcept = default;
+
+fraction &fraction::operator+=(
+    fraction const &other)
+{
+    if (_denominator == other._denominator)
+    {
+        _numerator += other._numerator;
+    }
+    else
+    {
+        _numerator *= other._denominator;
+        _numerator.add_product(other._numerator, _denominator);
+        _denominator *= other._denominator;
+    }
+
+    settle();
+    return *this;
+}
+
+fraction fraction::operator+(
+    fraction const &other) const
+{
+    return fraction(*this) += other;
+}
+
+fraction &fraction::operator-=(
+    fraction const &other)
+{
+    if (_denominator == other._denominator)
+    {
+        _numerator -= other._numerator;
+    }
+    else
+    {
+        _numerator *= other._denominator;
+        _numerator.subtract_product(other._numerator, _denominator);
+        _denominator *= other._denominator;
+    }
+
+    settle();
+    return *this;
+}
+
+fraction fraction::operator-(
+    fraction const &other) const
+{
+    return fraction(*this) -= other;
+}
+
+fraction &fraction::operator*=(
+    fraction const &other)
+{
+    _numerator *= other._numerator;
+    _denominator *= other._denominator;
+
+    settle();
+    return *this;
+}
+
+fraction fraction::operator*(
+    fraction const &other) const
+{
+    return fraction(*this) *= other;
+}
+
+fraction &fraction::operator/=(
+    fraction const &other)
+{
+    if (other.is_zero())
+    {
+        throw std::logic_error("attempt to divide by zero");
+    }
+
+    // other may be *this
+    big_integer const other_numerator = other._numerator;
+    _numerator *= other._denominator;
+    _denominator *= other_numerator;
+
+    settle();
+    return *this;
+}
+
+fraction fraction::operator/(
+    fraction const &other) const
+{
+    return fraction(*this) /= other;
+}
+
+bool fraction::operator==(
+    fraction const &other) const
+{
+    return compare(*this, other) == 0;
+}
+
+bool fraction::operator!=(
+    fraction const &other) const
+{
+    return compare(*this, other) != 0;
+}
+
+bool fraction::operator>=(
+    fraction const &other) const
+{
+    return compare(*this, other) >= 0;
+}
+
+bool fraction::operator>(
+    fraction const &other) const
+{
+    return compare(*this, other) > 0;
+}
+
+bool fraction::operator<=(
+    fraction const &other) const
+{
+    return compare(*this, other) <= 0;
+}
+
+bool fraction::operator<(
+    fraction const &other) const
+{
+    return compare(*this, other) < 0;
+}
+
+std::ostream &operator<<(
+    std::ostream &stream,
+    fraction const &obj)
+{
+    fraction reduced = obj;
+    reduced.normalize();
+
+    stream << reduced._numerator;
+    if (reduced._denominator != big_integer(1))
+    {
+        stream << '/' << reduced._denominator;
+    }
+    return stream;
+}
+
+std::istream &operator>>(
+    std::istream &stream,
+    fraction &obj)
+{
+    std::string value_as_string;
+    if (!(stream >> value_as_string))
+    {
+        return stream;
+    }
+
+    size_t const separator = value_as_string.find('/');
+    obj = separator == std::string::npos
+        ? fraction(big_integer(value_as_string), big_integer(1))
+        : fraction(big_integer(value_as_string.substr(0, separator)), big_integer(value_as_string.substr(separator + 1)));
+    return stream;
+}
+
+fraction fraction::sin(
+    fraction const &epsilon) const
+{
+    throw_if_invalid_epsilon(epsilon);
+
+    size_t const bits = get_working_bits(epsilon);
+    big_integer sine(0);
+    big_integer cosine(0);
+    fixed_sin_cos(sine, cosine, bits);
+    return from_fixed(std::move(sine), bits);
+}
+
+fraction fraction::cos(
+    fraction const &epsilon) const
+{
+    throw_if_invalid_epsilon(epsilon);
+
+    size_t const bits = get_working_bits(epsilon);
+    big_integer sine(0);
+    big_integer cosine(0);
+    fixed_sin_cos(sine, cosine, bits);
+    return from_fixed(std::move(cosine), bits);
+}
+
+fraction fraction::tg(
+    fraction const &epsilon) const
+{
+    throw_if_invalid_epsilon(epsilon);
+
+    return quotient(
+        [this](fraction const &delta) { return sin(delta); },
+        [this](fraction const &delta) { return cos(delta); },
+        epsilon);
+}
+
+fraction fraction::ctg(
+    fraction const &epsilon) const
+{
+    throw_if_invalid_epsilon(epsilon);
+    if (is_zero())
+    {
+        throw std::logic_error("ctg has a pole at zero");
+    }
+
+    return quotient(
+        [this](fraction const &delta) { return cos(delta); },
+        [this](fraction const &delta) { return sin(delta); },
+        epsilon);
+}
+
+fraction fraction::sec(
+    fraction const &epsilon) const
+{
+    throw_if_invalid_epsilon(epsilon);
+
+    return quotient(
+        [](fraction const &) { return make_fraction(1); },
+        [this](fraction const &delta) { return cos(delta); },
+        epsilon);
+}
+
+fraction fraction::cosec(
+    fraction const &epsilon) const
+{
+    throw_if_invalid_epsilon(epsilon);
+    if (is_zero())
+    {
+        throw std::logic_error("cosec has a pole at zero");
+    }
+
+    return quotient(
+        [](fraction const &) { return make_fraction(1); },
+        [this](fraction const &delta) { return sin(delta); },
+        epsilon);
+}
+
+fraction fraction::arcsin(
+    fraction const &epsilon) const
+{
+    throw_if_invalid_epsilon(epsilon);
+    if (absolute(*this) > make_fraction(1))
+    {
+        throw std::invalid_argument("arcsin argument is out of [-1, 1]");
+    }
+
+    size_t const bits = get_working_bits(epsilon);
+    return from_fixed(fixed_arcsin(bits), bits);
+}
+
+fraction fraction::arccos(
+    fraction const &epsilon) const
+{
+    throw_if_invalid_epsilon(epsilon);
+    if (absolute(*this) > make_fraction(1))
+    {
+        throw std::invalid_argument("arccos argument is out of [-1, 1]");
+    }
+
+    size_t const bits = get_working_bits(epsilon);
+    return from_fixed((constants::pi(bits) >> 1) - fixed_arcsin(bits), bits);
+}
+
+fraction fraction::arctg(
+    fraction const &epsilon) const
+{
+    throw_if_invalid_epsilon(epsilon);
+
+    size_t const bits = get_working_bits(epsilon);
+    return from_fixed(fixed_arctangent(bits), bits);
+}
+
+fraction fraction::arcctg(
+    fraction const &epsilon) const
+{
+    throw_if_invalid_epsilon(epsilon);
+
+    size_t const bits = get_working_bits(epsilon);
+    return from_fixed((constants::pi(bits) >> 1) - fixed_arctangent(bits), bits);
+}
+
+fraction fraction::arcsec(
+    fraction const &epsilon) const
+{
+    throw_if_invalid_epsilon(epsilon);
+    if (absolute(*this) < make_fraction(1))
+    {
+        throw std::invalid_argument("arcsec argument is inside (-1, 1)");
+    }
+
+    return (make_fraction(1) / *this).arccos(epsilon);
+}
+
+fraction fraction::arccosec(
+    fraction const &epsilon) const
+{
+    throw_if_invalid_epsilon(epsilon);
+    if (absolute(*this) < make_fraction(1))
+    {
+        throw std::invalid_argument("arccosec argument is inside (-1, 1)");
+    }
+
+    return (make_fraction(1) / *this).arcsin(epsilon);
+}
+
+fraction fraction::pow(
+    size_t degree) const
+{
+    // the powers of coprime values are coprime
+    fraction result = *this;
+    result.normalize();
+    big_integer::pow(result._numerator, degree);
+    big_integer::pow(result._denominator, degree);
+    result._normalized_bits = result.get_bits_count();
+    return result;
+}
+
+fraction fraction::root(
+    size_t degree,
+    fraction const &epsilon) const
+{
+    throw_if_invalid_epsilon(epsilon);
+    if (degree == 0)
+    {
+        throw std::invalid_argument("root degree can't be zero");
+    }
+    if (is_negative() && degree % 2 == 0)
+    {
+        throw std::invalid_argument("even degree root of a negative value");
+    }
+    if (degree == 1)
+    {
+        return *this;
+    }
+
+    // root(a / b) = root(a * b^(degree - 1) * 2^(degree * k)) / (b * 2^k), and the integer root is off by less
+    // than 1 / (b * 2^k) <= epsilon for 2^k over 1 / epsilon
+    size_t const scale_bits = epsilon._denominator.bit_length() >= epsilon._numerator.bit_length()
+        ? epsilon._denominator.bit_length() - epsilon._numerator.bit_length() + 1
+        : 0;
+    big_integer radicand = _numerator < big_integer(0)
+        ? -_numerator
+        : _numerator;
+    radicand *= big_integer::pow(_denominator, degree - 1);
+    radicand <<= degree * scale_bits;
+    big_integer::iroot(radicand, degree);
+
+    return fraction(is_negative()
+        ? -radicand
+        : std::move(radicand), _denominator << scale_bits);
+}
+
+fraction fraction::log2(
+    fraction const &epsilon) const
+{
+    throw_if_invalid_epsilon(epsilon);
+    if (is_zero() || is_negative())
+    {
+        throw std::invalid_argument("logarithm of a non-positive value");
+    }
+
+    // the powers of two are exact
+    fraction reduced = *this;
+    reduced.normalize();
+    if (reduced._numerator == big_integer(1) && reduced._denominator.trailing_zero_bits_count() + 1 == reduced._denominator.bit_length())
+    {
+        return fraction(-big_integer(reduced._denominator.bit_length() - 1), big_integer(1));
+    }
+    if (reduced._denominator == big_integer(1) && reduced._numerator.trailing_zero_bits_count() + 1 == reduced._numerator.bit_length())
+    {
+        return fraction(big_integer(reduced._numerator.bit_length() - 1), big_integer(1));
+    }
+
+    return quotient(
+        [this](fraction const &delta) { return ln(delta); },
+        [](fraction const &delta)
+        {
+            size_t const bits = get_working_bits(delta);
+            return from_fixed(constants::ln2(bits), bits);
+        },
+        epsilon);
+}
+
+fraction fraction::ln(
+    fraction const &epsilon) const
+{
+    throw_if_invalid_epsilon(epsilon);
+    if (is_zero() || is_negative())
+    {
+        throw std::invalid_argument("logarithm of a non-positive value");
+    }
+
+    size_t const bits = get_working_bits(epsilon);
+    return from_fixed(fixed_ln(bits), bits);
+}
+
+fraction fraction::lg(
+    fraction const &epsilon) const
+{
+    throw_if_invalid_epsilon(epsilon);
+    if (is_zero() || is_negative())
+    {
+        throw std::invalid_argument("logarithm of a non-positive value");
+    }
+
+    return quotient(
+        [this](fraction const &delta) { return ln(delta); },
+        [](fraction const &delta)
+        {
+            size_t const bits = get_working_bits(delta);
+            return from_fixed(constants::ln10(bits), bits);
+        },
+        epsilon);
+}
+
+fraction fraction::pi(
+    fraction const &epsilon)
+{
+    throw_if_invalid_epsilon(epsilon);
+
+    size_t const bits = get_working_bits(epsilon);
+    return from_fixed(constants::pi(bits), bits);
+}
+
+fraction fraction::e(
+    fraction const &epsilon)
+{
+    throw_if_invalid_epsilon(epsilon);
+
+    size_t const bits = get_working_bits(epsilon);
+    return from_fixed(constants::e(bits), bits);
+}
+
+void fraction::set_normalization(
+    normalization_rule rule,
+    size_t lazy_normalization_threshold)
+{
+    normalization.store(rule, std::memory_order_relaxed);
+    normalization_threshold.store(lazy_normalization_threshold == 0
+        ? default_lazy_normalization_threshold
+        : lazy_normalization_threshold, std::memory_order_relaxed);
+}
+
+fraction::normalization_rule fraction::get_normalization_rule() noexcept
+{
+    return normalization.load(std::memory_order_relaxed);
+}
+
+size_t fraction::get_lazy_normalization_threshold() noexcept
+{
+    return normalization_threshold.load(std::memory_order_relaxed);
+}
+
+fraction::series_parallelism fraction::get_series_parallelism() noexcept
+{
+    return constants::get_series_parallelism();
+}
+
+void fraction::set_series_parallelism(
+    series_parallelism const &parallelism)
+{
+    constants::set_series_parallelism(parallelism);
+}
+
+void fraction::normalize()
+{
+    if (is_zero())
+    {
+        _denominator = big_integer(1);
+    }
+    else if (_denominator.trailing_zero_bits_count() + 1 == _denominator.bit_length())
+    {
+        // a power of two for a denominator, as the fixed point results have, reduces by a shift
+        size_t const zero_bits = std::min(_numerator.trailing_zero_bits_count(), _denominator.bit_length() - 1);
+        _numerator >>= zero_bits;
+        _denominator >>= zero_bits;
+    }
+    else
+    {
+        big_integer const divisor = big_integer::gcd(_numerator, _denominator);
+        if (divisor != big_integer(1))
+        {
+            big_integer::divide(_numerator, divisor);
+            big_integer::divide(_denominator, divisor);
+        }
+    }
+
+    _normalized_bits = get_bits_count();
+}
+
+void fraction::settle()
+{
+    if (_denominator < big_integer(0))
+    {
+        _numerator = -_numerator;
+        _denominator = -_denominator;
+    }
+
+    if (get_normalization_rule() == normalization_rule::eager)
+    {
+        normalize();
+        return;
+    }
+    if (is_zero())
+    {
+        _denominator = big_integer(1);
+        _normalized_bits = get_bits_count();
+        return;
+    }
+
+    // the common powers of two go by a shift
+    size_t const zero_bits = std::min(_numerator.trailing_zero_bits_count(), _denominator.trailing_zero_bits_count());
+    if (zero_bits != 0)
+    {
+        _numerator >>= zero_bits;
+        _denominator >>= zero_bits;
+    }
+
+    // the gcd waits for the value to double its size since the last one
+    if (get_bits_count() > std::max(get_lazy_normalization_threshold(), 2 * _normalized_bits))
+    {
+        normalize();
+    }
+}
+
+big_integer fraction::to_fixed(
+    size_t bits) const
+{
+    big_integer const magnitude = is_negative()
+        ? -_numerator
+        : _numerator;
+    big_integer const result = fixed_quotient(magnitude << bits, _denominator);
+    return is_negative()
+        ? -result
+        : result;
+}
+
+size_t fraction::get_working_bits(
+    fraction const &epsilon)
+{
+    // 1 / epsilon < 2^(bits of the denominator - bits of the numerator + 1), and the guard bits take the truncations
+    // of about as many fixed point operations as there are bits
+    size_t const numerator_bits = epsilon._numerator.bit_length();
+    size_t const denominator_bits = epsilon._denominator.bit_length();
+    size_t const bits = denominator_bits >= numerator_bits
+        ? denominator_bits - numerator_bits + 1
+        : 1;
+    return bits + constants::guard_bits(bits);
+}
+
+void fraction::fixed_sin_cos(
+    big_integer &sine,
+    big_integer &cosine,
+    size_t bits) const
+{
+    // |x| = k pi / 2 + r with |r| <= pi / 4, taken with the bits of k over the precision
+    size_t const numerator_bits = _numerator.bit_length();
+    size_t const denominator_bits = _denominator.bit_length();
+    size_t const wide_bits = bits + 8 + (numerator_bits > denominator_bits
+        ? numerator_bits - denominator_bits + 1
+        : 0);
+    big_integer const magnitude = is_negative()
+        ? -to_fixed(wide_bits)
+        : to_fixed(wide_bits);
+    big_integer const half_pi = constants::pi(wide_bits) >> 1;
+    big_integer const quarter_pi = half_pi >> 1;
+
+    std::pair<big_integer, big_integer> const quadrant_and_remainder = big_integer::divmod(magnitude + quarter_pi, half_pi);
+    bool const is_remainder_negative = quadrant_and_remainder.second < quarter_pi;
+    big_integer remainder = is_remainder_negative
+        ? quarter_pi - quadrant_and_remainder.second
+        : quadrant_and_remainder.second - quarter_pi;
+    remainder >>= wide_bits - bits;
+
+    fixed_sin_cos_reduced(std::move(remainder), bits, sine, cosine);
+    if (is_remainder_negative)
+    {
+        sine = -sine;
+    }
+
+    // sin(r + pi / 2) = cos r, cos(r + pi / 2) = -sin r
+    big_integer const quadrant = quadrant_and_remainder.first & big_integer(3);
+    if (quadrant == big_integer(1) || quadrant == big_integer(3))
+    {
+        std::swap(sine, cosine);
+        cosine = -cosine;
+    }
+    if (quadrant >= big_integer(2))
+    {
+        sine = -sine;
+        cosine = -cosine;
+    }
+    if (is_negative())
+    {
+        sine = -sine;
+    }
+}
+
+big_integer fraction::fixed_arcsin(
+    size_t bits) const
+{
+    // arcsin x = 2 atan(x / (1 + sqrt(1 - x^2))) with x = n / d, so the argument of atan is
+    // n / (d + sqrt(d^2 - n^2)) and the root is the only rounding ahead of the series
+    big_integer const magnitude = is_negative()
+        ? -_numerator
+        : _numerator;
+    big_integer root = _denominator * _denominator;
+    root.subtract_product(magnitude, magnitude);
+    root <<= 2 * bits;
+    big_integer::isqrt(root);
+    root.add_product(_denominator, big_integer::power_of_two(bits));
+
+    big_integer const result = fixed_arctangent_reduced(fixed_quotient(magnitude << (2 * bits), root), bits) << 1;
+    return is_negative()
+        ? -result
+        : result;
+}
+
+big_integer fraction::fixed_arctangent(
+    size_t bits) const
+{
+    // atan x = pi / 2 - atan(1 / x) over one
+    big_integer const magnitude = is_negative()
+        ? -_numerator
+        : _numerator;
+    big_integer const result = magnitude <= _denominator
+        ? fixed_arctangent_reduced(fixed_quotient(magnitude << bits, _denominator), bits)
+        : (constants::pi(bits) >> 1) - fixed_arctangent_reduced(fixed_quotient(_denominator << bits, magnitude), bits);
+    return is_negative()
+        ? -result
+        : result;
+}
+
+big_integer fraction::fixed_ln(
+    size_t bits) const
+{
+    // x = y 2^power with 1 / 2 < y < 2, and power ln 2 takes the bits of the power over the precision
+    size_t const numerator_bits = _numerator.bit_length();
+    size_t const denominator_bits = _denominator.bit_length();
+    bool const is_power_negative = numerator_bits < denominator_bits;
+    uint64_t const power = is_power_negative
+        ? denominator_bits - numerator_bits
+        : numerator_bits - denominator_bits;
+    big_integer result = fixed_ln_reduced(is_power_negative
+        ? fixed_quotient(_numerator << (bits + power), _denominator)
+        : fixed_quotient(_numerator << bits, _denominator << power), bits);
+    if (power != 0)
+    {
+        size_t const power_bits = big_integer(power).bit_length();
+        big_integer power_ln2 = constants::ln2(bits + power_bits) * big_integer(power);
+        power_ln2 >>= power_bits;
+        if (is_power_negative)
+        {
+            result -= power_ln2;
+        }
+        else
+        {
+            result += power_ln2;
+        }
+    }
+    return result;
+}
+
+size_t fraction::get_bits_count() const noexcept
+{
+    return _numerator.bit_length() + _denominator.bit_length();
+}
+
+bool fraction::is_zero() const
+{
+    return _numerator.bit_length() == 0;
+}
+
+bool fraction::is_negative() const
+{
+    return _numerator < big_integer(0);
+}
+
+int fraction::compare(
+    fraction const &first,
+    fraction const &second)
+{
+    // the denominators are positive
+    big_integer const first_cross = first._numerator * second._denominator;
+    big_integer const second_cross = second._numerator * first._denominator;
+    return first_cross < second_cross
+        ? -1
+        : (first_cross > second_cross
+            ? 1
+            : 0);
+}
+
+void fraction::throw_if_invalid_epsilon(
+    fraction const &epsilon)
+{
+    if (epsilon._numerator <= big_integer(0))
+    {
+        throw std::invalid_argument("epsilon must be positive");
+    }
 }
\ No newline at end of file
@@ -0,0 +1,358 @@
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fraction.h>
+#include <client_logger.h>
+
+logger *create_logger(
+    std::vector<std::pair<std::string, logger::severity>> const &output_file_streams_setup,
+    bool use_console_stream = true,
+    logger::severity console_stream_severity = logger::severity::debug)
+{
+    logger_builder *builder = new client_logger_builder();
+    
+    if (use_console_stream)
+    {
+        builder->add_console_stream(console_stream_severity);
+    }
+    
+    for (auto &output_file_stream_setup: output_file_streams_setup)
+    {
+        builder->add_file_stream(output_file_stream_setup.first, output_file_stream_setup.second);
+    }
+    
+    logger *built_logger = builder->build();
+    
+    delete builder;
+    
+    return built_logger;
+}
+
+fraction make_fraction(
+    std::string const &numerator,
+    std::string const &denominator = "1")
+{
+    return fraction(big_integer(numerator), big_integer(denominator));
+}
+
+// digits of a decimal value 0.d1d2... or i.d1d2... as a fraction
+fraction make_decimal(
+    std::string const &integer_part,
+    std::string const &fractional_part)
+{
+    return make_fraction(integer_part + fractional_part, "1" + std::string(fractional_part.size(), '0'));
+}
+
+bool is_within(
+    fraction const &value,
+    fraction const &expected,
+    fraction const &epsilon)
+{
+    fraction const difference = value - expected;
+    return difference <= epsilon && difference >= make_fraction("0") - epsilon;
+}
+
+std::string to_string(
+    fraction const &value)
+{
+    std::stringstream stream;
+    stream << value;
+    return stream.str();
+}
+
+TEST(positive_tests, test1)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "fraction_logs.txt",
+                logger::severity::information
+            },
+        });
+    
+    fraction const first = make_fraction("6", "-8");
+    fraction const second = make_fraction("5", "6");
+    
+    EXPECT_EQ(to_string(first), "-3/4");
+    EXPECT_EQ(to_string(first + second), "1/12");
+    EXPECT_EQ(to_string(first - second), "-19/12");
+    EXPECT_EQ(to_string(first * second), "-5/8");
+    EXPECT_EQ(to_string(first / second), "-9/10");
+    EXPECT_EQ(to_string(second * make_fraction("12")), "10");
+    EXPECT_EQ(to_string(first - first), "0");
+    EXPECT_EQ(to_string(first.pow(3)), "-27/64");
+    EXPECT_EQ(to_string(first.pow(0)), "1");
+    
+    EXPECT_TRUE(first < second);
+    EXPECT_TRUE(first == make_fraction("-30", "40"));
+    EXPECT_TRUE(second >= make_fraction("10", "12"));
+    
+    std::stringstream stream("-14/21 7");
+    fraction read = make_fraction("0");
+    stream >> read;
+    EXPECT_EQ(to_string(read), "-2/3");
+    stream >> read;
+    EXPECT_EQ(to_string(read), "7");
+    
+    delete logger;
+}
+
+TEST(positive_tests, test2)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "fraction_logs.txt",
+                logger::severity::information
+            },
+        });
+    
+    // lazy normalization gives the same values and the same output as the eager one
+    fraction::normalization_rule const rule = fraction::get_normalization_rule();
+    
+    std::string results[2];
+    for (auto normalization: { fraction::normalization_rule::eager, fraction::normalization_rule::lazy })
+    {
+        fraction::set_normalization(normalization, 64);
+    
+        fraction sum = make_fraction("0");
+        for (size_t i = 1; i <= 60; ++i)
+        {
+            sum += make_fraction("1", std::to_string(i * (i + 1)));
+        }
+        EXPECT_TRUE(sum == make_fraction("60", "61"));
+    
+        fraction product = make_fraction("1");
+        for (size_t i = 2; i <= 40; ++i)
+        {
+            product *= make_fraction(std::to_string(i * i - 1), std::to_string(i * i));
+        }
+        EXPECT_TRUE(product == make_fraction("41", "80"));
+    
+        results[normalization == fraction::normalization_rule::lazy] = to_string(sum) + " " + to_string(product);
+    }
+    EXPECT_EQ(results[0], results[1]);
+    EXPECT_EQ(results[1], "60/61 41/80");
+    EXPECT_EQ(fraction::get_lazy_normalization_threshold(), 64U);
+    
+    fraction::set_normalization(rule);
+    
+    delete logger;
+}
+
+TEST(positive_tests, test3)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "fraction_logs.txt",
+                logger::severity::information
+            },
+        });
+    
+    fraction const epsilon = make_fraction("1", "1" + std::string(30, '0'));
+    fraction const half = make_fraction("1", "2");
+    
+    EXPECT_TRUE(is_within(half.sin(epsilon), make_decimal("0", "479425538604203000273287935215571388"), epsilon));
+    EXPECT_TRUE(is_within(half.cos(epsilon), make_decimal("0", "877582561890372716116281582603829651"), epsilon));
+    EXPECT_TRUE(is_within(half.tg(epsilon), make_decimal("0", "546302489843790513255179465780285383"), epsilon));
+    EXPECT_TRUE(is_within(half.arcsin(epsilon), make_decimal("0", "523598775598298873077107230546583814"), epsilon));
+    EXPECT_TRUE(is_within(half.arccos(epsilon), make_decimal("1", "047197551196597746154214461093167628"), epsilon));
+    EXPECT_TRUE(is_within(half.arctg(epsilon), make_decimal("0", "463647609000806116214256231461214402"), epsilon));
+    EXPECT_TRUE(is_within(half.ln(epsilon), make_fraction("0") - make_decimal("0", "693147180559945309417232121458176568"), epsilon));
+    EXPECT_TRUE(half.log2(epsilon) == make_fraction("-1"));
+    EXPECT_TRUE(is_within(make_fraction("2").root(2, epsilon), make_decimal("1", "414213562373095048801688724209698079"), epsilon));
+    EXPECT_TRUE(make_fraction("-27", "8").root(3, epsilon) == make_fraction("-3", "2"));
+    EXPECT_TRUE(is_within(make_fraction("-3").arctg(epsilon), make_fraction("0") - make_decimal("1", "249045772398254425829917077281090123"), epsilon));
+    EXPECT_TRUE(is_within(make_fraction("1000").lg(epsilon), make_fraction("3"), epsilon));
+    
+    delete logger;
+}
+
+TEST(positive_tests, test4)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "fraction_logs.txt",
+                logger::severity::information
+            },
+        });
+    
+    fraction::normalization_rule const rule = fraction::get_normalization_rule();
+    fraction::set_normalization(fraction::normalization_rule::lazy);
+    
+    fraction const epsilon = make_fraction("1", "1" + std::string(25, '0'));
+    fraction const one = make_fraction("1");
+    fraction const x = make_fraction("123456789", "100000000");
+    
+    fraction const sine = x.sin(epsilon);
+    fraction const cosine = x.cos(epsilon);
+    EXPECT_TRUE(is_within(sine * sine + cosine * cosine, one, epsilon * make_fraction("4")));
+    EXPECT_TRUE(is_within(x.ctg(epsilon) * x.tg(epsilon), one, epsilon * make_fraction("4")));
+    EXPECT_TRUE(is_within(x.sec(epsilon) * cosine, one, epsilon * make_fraction("4")));
+    EXPECT_TRUE(is_within(x.cosec(epsilon) * sine, one, epsilon * make_fraction("4")));
+    EXPECT_TRUE(is_within(x.arcsec(epsilon), (one / x).arccos(epsilon), epsilon * make_fraction("2")));
+    EXPECT_TRUE(is_within(x.arccosec(epsilon), (one / x).arcsin(epsilon), epsilon * make_fraction("2")));
+    EXPECT_TRUE(is_within(x.arcctg(epsilon), (one / x).arctg(epsilon), epsilon * make_fraction("2")));
+    EXPECT_TRUE(is_within(x.log2(epsilon) * make_fraction("2").ln(epsilon), x.ln(epsilon), epsilon * make_fraction("4")));
+    
+    fraction::set_normalization(rule);
+    
+    delete logger;
+}
+
+TEST(positive_tests, test5)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "fraction_logs.txt",
+                logger::severity::information
+            },
+        });
+    
+    // a thousand digits for an argument as long as the precision
+    std::string digits(1000, '0');
+    for (size_t i = 0; i < digits.size(); ++i)
+    {
+        digits[i] = static_cast<char>('0' + (i + 1) % 10);
+    }
+    fraction const x = make_decimal("0", digits);
+    fraction const epsilon = make_fraction("1", "1" + std::string(1000, '0'));
+    fraction const one = make_fraction("1");
+    
+    fraction const sine = x.sin(epsilon);
+    fraction const cosine = x.cos(epsilon);
+    EXPECT_TRUE(is_within(sine * sine + cosine * cosine, one, epsilon * make_fraction("4")));
+    EXPECT_TRUE(is_within(x.tg(epsilon).arctg(epsilon), x, epsilon * make_fraction("4")));
+    EXPECT_TRUE(is_within(x.arcsin(epsilon).sin(epsilon), x, epsilon * make_fraction("4")));
+    EXPECT_TRUE(is_within(x.ln(epsilon) + (one / x).ln(epsilon), make_fraction("0"), epsilon * make_fraction("2")));
+    EXPECT_TRUE(is_within(one.arctg(epsilon) * make_fraction("4"), make_decimal("3", "14159265358979323846264338327950288419"), make_fraction("1", "1" + std::string(38, '0'))));
+    EXPECT_TRUE(is_within(make_fraction("-1000000").sin(epsilon), make_decimal("0", "34999350217129295211"), make_fraction("1", "1" + std::string(20, '0'))));
+    
+    delete logger;
+}
+
+TEST(positive_tests, test6)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "fraction_logs.txt",
+                logger::severity::information
+            },
+        });
+    
+    // the parallel trees take the same products in another order, so the values are the same to the last bit
+    fraction::series_parallelism const parallelism = fraction::get_series_parallelism();
+    
+    fraction const x = make_fraction("1234567", "1000000");
+    fraction const epsilon = make_fraction("1", "1" + std::string(500, '0'));
+    
+    std::string results[2];
+    for (size_t threads_count: { 1, 4 })
+    {
+        fraction::set_series_parallelism(fraction::series_parallelism { threads_count, 3, 0 });
+    
+        results[threads_count != 1] = to_string(x.sin(epsilon)) + " " + to_string(x.arctg(epsilon)) + " "
+            + to_string(x.ln(epsilon)) + " " + to_string((make_fraction("1") / x).arcsin(epsilon));
+    }
+    EXPECT_EQ(results[0], results[1]);
+    EXPECT_EQ(fraction::get_series_parallelism().threads_count, 4U);
+    EXPECT_EQ(fraction::get_series_parallelism().depth, 3U);
+    
+    fraction::set_series_parallelism(parallelism);
+    
+    delete logger;
+}
+
+TEST(positive_tests, test7)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "fraction_logs.txt",
+                logger::severity::information
+            },
+        });
+    
+    fraction const pi = make_decimal("3", "1415926535897932384626433832795028841971693993751058209749445923078164062862089986280348253421170679");
+    fraction const e = make_decimal("2", "7182818284590452353602874713526624977572470936999595749669676277240766303535475945713821785251664274");
+    fraction const ln2 = make_decimal("0", "6931471805599453094172321214581765680755001343602552541206800094933936219696947156058633269964186875");
+    fraction const epsilon = make_fraction("1", "1" + std::string(100, '0'));
+    
+    // the threads ask for the constants at precisions growing and shrinking around one another
+    std::vector<char> results(8, 0);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        threads.emplace_back([&, i]()
+        {
+            fraction const delta = epsilon / make_fraction(std::to_string(1 + (i * 37) % 8 * 1000));
+            results[i] = is_within(fraction::pi(delta), pi, epsilon)
+                && is_within(fraction::e(delta), e, epsilon)
+                && is_within(make_fraction("1", "2").ln(delta), make_fraction("0") - ln2, epsilon)
+                && is_within(make_fraction("1000").lg(delta), make_fraction("3"), delta);
+        });
+    }
+    for (auto &thread: threads)
+    {
+        thread.join();
+    }
+    
+    for (auto result: results)
+    {
+        EXPECT_TRUE(result);
+    }
+    EXPECT_TRUE(is_within(fraction::pi(make_fraction("1", "1000")), make_fraction("355", "113"), make_fraction("1", "1000")));
+    EXPECT_TRUE(is_within(make_fraction("-1").arccos(epsilon), pi, epsilon));
+    
+    delete logger;
+}
+
+TEST(negative_tests, test1)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "fraction_logs.txt",
+                logger::severity::information
+            },
+        });
+    
+    fraction const zero = make_fraction("0");
+    fraction const two = make_fraction("2");
+    fraction const epsilon = make_fraction("1", "1000");
+    
+    EXPECT_THROW(make_fraction("1", "0"), std::invalid_argument);
+    EXPECT_THROW(two / zero, std::logic_error);
+    EXPECT_THROW(two.sin(zero), std::invalid_argument);
+    EXPECT_THROW(two.cos(make_fraction("-1", "10")), std::invalid_argument);
+    EXPECT_THROW(zero.ctg(epsilon), std::logic_error);
+    EXPECT_THROW(zero.cosec(epsilon), std::logic_error);
+    EXPECT_THROW(zero.ln(epsilon), std::invalid_argument);
+    EXPECT_THROW((zero - two).log2(epsilon), std::invalid_argument);
+    EXPECT_THROW(two.arcsin(epsilon), std::invalid_argument);
+    EXPECT_THROW(two.arccos(epsilon), std::invalid_argument);
+    EXPECT_THROW(make_fraction("1", "2").arcsec(epsilon), std::invalid_argument);
+    EXPECT_THROW((zero - two).root(2, epsilon), std::invalid_argument);
+    EXPECT_THROW(two.root(0, epsilon), std::invalid_argument);
+    EXPECT_THROW(fraction::pi(zero), std::invalid_argument);
+    EXPECT_THROW(fraction::set_series_parallelism(fraction::series_parallelism { 0, 1, 0 }), std::invalid_argument);
+    
+    delete logger;
+}
+
+int main(
+    int argc,
+    char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    
+    return RUN_ALL_TESTS();
+}
\ No newline at end of file
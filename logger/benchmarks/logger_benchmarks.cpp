@@ -0,0 +1,279 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <client_logger.h>
+#include <server_logger.h>
+
+namespace
+{
+
+    struct benchmark_result final
+    {
+
+        double messages_per_second;
+
+        double latency_p50_ns;
+
+        double latency_p90_ns;
+
+        double latency_p99_ns;
+
+        double latency_p999_ns;
+
+        double latency_max_ns;
+
+    };
+
+    // swallows console sink output so the terminal does not dominate the measurements
+    class null_stream_buffer final:
+        public std::streambuf
+    {
+
+    protected:
+
+        int_type overflow(
+            int_type character) override
+        {
+            return character;
+        }
+
+        std::streamsize xsputn(
+            char const *data,
+            std::streamsize count) override
+        {
+            return count;
+        }
+
+    };
+
+    using logger_factory = std::function<logger *(logger::severity sink_severity)>;
+
+    std::string const file_sink_path = "logger_benchmark_output.txt";
+
+    double percentile(
+        std::vector<uint64_t> &sorted_latencies,
+        double fraction)
+    {
+        if (sorted_latencies.empty())
+        {
+            return 0;
+        }
+
+        auto const index = static_cast<size_t>(fraction * static_cast<double>(sorted_latencies.size() - 1));
+        return static_cast<double>(sorted_latencies[index]);
+    }
+
+    benchmark_result run_benchmark(
+        logger const *target_logger,
+        size_t threads_count,
+        size_t messages_per_thread,
+        logger::severity message_severity)
+    {
+        std::vector<std::vector<uint64_t>> latencies(threads_count, std::vector<uint64_t>(messages_per_thread));
+        std::vector<std::thread> threads;
+        std::atomic<size_t> ready_threads_count(0);
+        std::atomic<bool> started(false);
+
+        for (size_t thread_index = 0; thread_index < threads_count; ++thread_index)
+        {
+            threads.emplace_back([&, thread_index]()
+            {
+                std::string const message = "benchmark message from thread #" + std::to_string(thread_index);
+                auto &thread_latencies = latencies[thread_index];
+
+                ++ready_threads_count;
+                while (!started.load(std::memory_order_acquire))
+                {
+                    std::this_thread::yield();
+                }
+
+                for (size_t i = 0; i < messages_per_thread; ++i)
+                {
+                    auto const message_started_at = std::chrono::steady_clock::now();
+                    target_logger->log(message, message_severity);
+                    thread_latencies[i] = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now() - message_started_at).count());
+                }
+            });
+        }
+
+        while (ready_threads_count.load() != threads_count)
+        {
+            std::this_thread::yield();
+        }
+
+        auto const started_at = std::chrono::steady_clock::now();
+        started.store(true, std::memory_order_release);
+        for (auto &thread: threads)
+        {
+            thread.join();
+        }
+        auto const elapsed_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started_at).count();
+
+        std::vector<uint64_t> all_latencies;
+        all_latencies.reserve(threads_count * messages_per_thread);
+        for (auto const &thread_latencies: latencies)
+        {
+            all_latencies.insert(all_latencies.end(), thread_latencies.begin(), thread_latencies.end());
+        }
+        std::sort(all_latencies.begin(), all_latencies.end());
+
+        return benchmark_result
+        {
+            static_cast<double>(all_latencies.size()) / elapsed_seconds,
+            percentile(all_latencies, 0.5),
+            percentile(all_latencies, 0.9),
+            percentile(all_latencies, 0.99),
+            percentile(all_latencies, 0.999),
+            all_latencies.empty()
+                ? 0
+                : static_cast<double>(all_latencies.back())
+        };
+    }
+
+    void print_header()
+    {
+        std::cout
+            << std::left << std::setw(10) << "sink"
+            << std::setw(11) << "filtered"
+            << std::right << std::setw(9) << "threads"
+            << std::setw(16) << "messages/sec"
+            << std::setw(12) << "p50, ns"
+            << std::setw(12) << "p90, ns"
+            << std::setw(12) << "p99, ns"
+            << std::setw(12) << "p99.9, ns"
+            << std::setw(14) << "max, ns"
+            << std::endl;
+    }
+
+    void print_result(
+        std::string const &sink_name,
+        bool filtered,
+        size_t threads_count,
+        benchmark_result const &result)
+    {
+        std::cout
+            << std::left << std::setw(10) << sink_name
+            << std::setw(11) << (filtered ? "yes" : "no")
+            << std::right << std::setw(9) << threads_count
+            << std::fixed << std::setprecision(0)
+            << std::setw(16) << result.messages_per_second
+            << std::setw(12) << result.latency_p50_ns
+            << std::setw(12) << result.latency_p90_ns
+            << std::setw(12) << result.latency_p99_ns
+            << std::setw(12) << result.latency_p999_ns
+            << std::setw(14) << result.latency_max_ns
+            << std::endl;
+    }
+
+    void benchmark_sink(
+        std::string const &sink_name,
+        logger_factory const &create_logger,
+        std::vector<size_t> const &threads_counts,
+        size_t messages_per_thread)
+    {
+        for (bool filtered: { false, true })
+        {
+            for (size_t threads_count: threads_counts)
+            {
+                logger *target_logger = nullptr;
+                try
+                {
+                    // the sink accepts information only, so debug messages are dropped by the filter
+                    target_logger = create_logger(logger::severity::information);
+                }
+                catch (std::exception const &error)
+                {
+                    std::cout << std::left << std::setw(10) << sink_name << "skipped: " << error.what() << std::endl;
+                    return;
+                }
+
+                std::streambuf *console_buffer = nullptr;
+                null_stream_buffer discarding_buffer;
+                if (sink_name == "console")
+                {
+                    console_buffer = std::cout.rdbuf(&discarding_buffer);
+                }
+
+                auto const result = run_benchmark(
+                    target_logger,
+                    threads_count,
+                    messages_per_thread,
+                    filtered
+                        ? logger::severity::debug
+                        : logger::severity::information);
+
+                delete target_logger;
+
+                if (console_buffer != nullptr)
+                {
+                    std::cout.rdbuf(console_buffer);
+                }
+
+                print_result(sink_name, filtered, threads_count, result);
+                std::remove(file_sink_path.c_str());
+            }
+        }
+    }
+
+}
+
+int main(
+    int argc,
+    char *argv[])
+{
+    size_t const max_threads_count = argc > 1
+        ? std::stoul(argv[1])
+        : std::max(std::thread::hardware_concurrency(), 1U);
+    size_t const messages_per_thread = argc > 2
+        ? std::stoul(argv[2])
+        : 100000;
+
+    std::vector<size_t> threads_counts;
+    for (size_t threads_count = 1; threads_count < max_threads_count; threads_count <<= 1)
+    {
+        threads_counts.push_back(threads_count);
+    }
+    threads_counts.push_back(max_threads_count);
+
+    std::cout << "messages per thread: " << messages_per_thread << std::endl << std::endl;
+    print_header();
+
+    benchmark_sink("console", [](logger::severity sink_severity)
+    {
+        client_logger_builder builder;
+        builder.add_console_stream(sink_severity);
+        return builder.build();
+    }, threads_counts, messages_per_thread);
+
+    benchmark_sink("file", [](logger::severity sink_severity)
+    {
+        client_logger_builder builder;
+        builder.add_file_stream(file_sink_path, sink_severity);
+        return builder.build();
+    }, threads_counts, messages_per_thread);
+
+    benchmark_sink("staged", [](logger::severity sink_severity)
+    {
+        client_logger_builder builder;
+        builder.add_file_stream(file_sink_path, sink_severity);
+        builder.set_staging_buffer(1 << 16);
+        return builder.build();
+    }, threads_counts, messages_per_thread);
+
+    benchmark_sink("server", [](logger::severity sink_severity)
+    {
+        server_logger_builder builder;
+        builder.add_console_stream(sink_severity);
+        return builder.build();
+    }, threads_counts, messages_per_thread);
+
+    return 0;
+}
\ No newline at end of file
@@ -1,13 +1,48 @@
 #ifndef MATH_PRACTICE_AND_OPERATING_SYSTEMS_CLIENT_LOGGER_H
 #define MATH_PRACTICE_AND_OPERATING_SYSTEMS_CLIENT_LOGGER_H
 
+#include <map>
+#include <mutex>
+#include <set>
+
 #include <logger.h>
 #include "client_logger_builder.h"
+#include "rotating_file_stream.h"
+#include "staging_buffers.h"
 
 class client_logger final:
     public logger
 {
 
+    friend class client_logger_builder;
+
+private:
+
+    // file streams are shared between all client loggers writing to the same path
+    static std::map<std::string, std::pair<rotating_file_stream *, size_t>> _all_file_streams;
+
+    static std::mutex _all_file_streams_mutex;
+
+    static std::mutex _console_stream_mutex;
+
+private:
+
+    std::map<std::string, std::pair<rotating_file_stream *, std::set<logger::severity>>> _file_streams;
+
+    std::set<logger::severity> _console_stream_severities;
+
+    // records are staged per thread and written in batches when not nullptr
+    staging_buffers *_staging_buffers;
+
+private:
+
+    client_logger(
+        std::map<std::string, std::set<logger::severity>> const &file_streams_setup,
+        std::map<std::string, rotating_file_stream::rotation_policy> const &file_streams_rotation_setup,
+        std::set<logger::severity> const &console_stream_severities,
+        size_t staging_buffer_capacity,
+        std::chrono::milliseconds staging_buffer_flush_interval);
+
 public:
 
     client_logger(
@@ -30,6 +65,35 @@ public:
         const std::string &message,
         logger::severity severity) const noexcept override;
 
+private:
+
+    static rotating_file_stream *acquire_file_stream(
+        std::string const &file_path,
+        rotating_file_stream::rotation_policy const &policy);
+
+    static void release_file_stream(
+        std::string const &file_path) noexcept;
+
+    // the streams of file_streams acquired once more, with their severities; if acquiring one throws,
+    // the ones acquired before it are released, so the reference counts are left as they were
+    static std::map<std::string, std::pair<rotating_file_stream *, std::set<logger::severity>>> acquire_file_streams(
+        std::map<std::string, std::pair<rotating_file_stream *, std::set<logger::severity>>> const &file_streams);
+
+    void release_file_streams() noexcept;
+
+    void create_staging_buffers(
+        size_t capacity,
+        std::chrono::milliseconds flush_interval);
+
+    void destroy_staging_buffers() noexcept;
+
+    void flush_file_streams() const noexcept;
+
+    static void write_records(
+        std::vector<rotating_file_stream *> const &file_streams,
+        size_t destination,
+        std::string const &records);
+
 };
 
 #endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_CLIENT_LOGGER_H
\ No newline at end of file
@@ -1,12 +1,28 @@
 #ifndef MATH_PRACTICE_AND_OPERATING_SYSTEMS_CLIENT_LOGGER_BUILDER_H
 #define MATH_PRACTICE_AND_OPERATING_SYSTEMS_CLIENT_LOGGER_BUILDER_H
 
+#include <map>
+#include <set>
+
 #include <logger_builder.h>
+#include "rotating_file_stream.h"
 
 class client_logger_builder final:
     public logger_builder
 {
 
+private:
+
+    std::map<std::string, std::set<logger::severity>> _file_streams_setup;
+
+    std::map<std::string, rotating_file_stream::rotation_policy> _file_streams_rotation_setup;
+
+    std::set<logger::severity> _console_stream_severities;
+
+    size_t _staging_buffer_capacity;
+
+    std::chrono::milliseconds _staging_buffer_flush_interval;
+
 public:
 
     client_logger_builder();
@@ -34,6 +50,17 @@ public:
     logger_builder *add_console_stream(
         logger::severity severity) override;
 
+    client_logger_builder *set_file_stream_rotation(
+        std::string const &stream_file_path,
+        rotating_file_stream::rotation_policy const &policy);
+
+    // 0 capacity writes every record immediately (default),
+    // otherwise records are staged per thread and written in one call when
+    // the buffer is full, the flush interval elapses or an error/critical record arrives
+    client_logger_builder *set_staging_buffer(
+        size_t capacity,
+        std::chrono::milliseconds flush_interval = std::chrono::milliseconds(100));
+
     logger_builder* transform_with_configuration(
         std::string const &configuration_file_path,
         std::string const &configuration_path) override;
@@ -0,0 +1,100 @@
+#ifndef MATH_PRACTICE_AND_OPERATING_SYSTEMS_ROTATING_FILE_STREAM_H
+#define MATH_PRACTICE_AND_OPERATING_SYSTEMS_ROTATING_FILE_STREAM_H
+
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <string>
+
+class rotating_file_stream final
+{
+
+public:
+
+    struct rotation_policy
+    {
+
+    public:
+
+        // 0 disables size-based rotation
+        size_t max_file_size = 0;
+
+        // 0 disables time-based rotation
+        std::chrono::seconds max_file_age = std::chrono::seconds(0);
+
+        // archives kept as <path>.1 ... <path>.<retained_files_count>, the oldest ones are removed
+        size_t retained_files_count = 5;
+
+        // archives are gzipped in background (when built with zlib)
+        bool compress_rotated_files = false;
+
+    public:
+
+        bool rotation_enabled() const noexcept;
+
+    };
+
+public:
+
+    explicit rotating_file_stream(
+        std::string const &file_path,
+        rotation_policy const &policy);
+
+    ~rotating_file_stream() noexcept;
+
+    rotating_file_stream(
+        rotating_file_stream const &other) = delete;
+
+    rotating_file_stream &operator=(
+        rotating_file_stream const &other) = delete;
+
+    rotating_file_stream(
+        rotating_file_stream &&other) = delete;
+
+    rotating_file_stream &operator=(
+        rotating_file_stream &&other) = delete;
+
+public:
+
+    void write(
+        std::string const &record) noexcept;
+
+    void flush() noexcept;
+
+public:
+
+    std::string const &get_file_path() const noexcept;
+
+    rotation_policy const &get_rotation_policy() const noexcept;
+
+public:
+
+    // blocks until all rotated files are renamed, compressed and pruned
+    static void wait_for_pending_rotations();
+
+private:
+
+    bool rotation_required(
+        size_t next_record_size) const noexcept;
+
+    void rotate() noexcept;
+
+    void open() noexcept;
+
+private:
+
+    std::string const _file_path;
+
+    rotation_policy const _policy;
+
+    std::ofstream _stream;
+
+    size_t _written_bytes;
+
+    std::chrono::steady_clock::time_point _opened_at;
+
+    std::mutex _mutex;
+
+};
+
+#endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_ROTATING_FILE_STREAM_H
\ No newline at end of file
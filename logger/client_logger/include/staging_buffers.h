@@ -0,0 +1,109 @@
+#ifndef MATH_PRACTICE_AND_OPERATING_SYSTEMS_STAGING_BUFFERS_H
+#define MATH_PRACTICE_AND_OPERATING_SYSTEMS_STAGING_BUFFERS_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class staging_buffers final
+{
+
+public:
+
+    struct thread_buffer final
+    {
+
+    public:
+
+        std::mutex mutex;
+
+        // accumulated records, one string per destination
+        std::vector<std::string> records;
+
+        size_t size = 0;
+
+    };
+
+    // writes all records staged for one destination with a single call
+    using destination_writer = std::function<void(size_t destination, std::string const &records)>;
+
+private:
+
+    static std::atomic<uint64_t> _instances_count;
+
+private:
+
+    uint64_t const _id;
+
+    size_t const _destinations_count;
+
+    size_t const _capacity;
+
+    std::chrono::milliseconds const _flush_interval;
+
+    destination_writer const _write;
+
+    std::mutex _thread_buffers_mutex;
+
+    std::vector<std::shared_ptr<thread_buffer>> _thread_buffers;
+
+    std::mutex _flusher_mutex;
+
+    std::condition_variable _flusher_wakeup;
+
+    bool _flusher_stopped;
+
+    std::thread _flusher;
+
+public:
+
+    staging_buffers(
+        size_t destinations_count,
+        size_t capacity,
+        std::chrono::milliseconds flush_interval,
+        destination_writer write);
+
+    ~staging_buffers() noexcept;
+
+    staging_buffers(
+        staging_buffers const &other) = delete;
+
+    staging_buffers &operator=(
+        staging_buffers const &other) = delete;
+
+    staging_buffers(
+        staging_buffers &&other) = delete;
+
+    staging_buffers &operator=(
+        staging_buffers &&other) = delete;
+
+public:
+
+    // the calling thread's buffer, created on first use; lock its mutex before touching it
+    thread_buffer &current_thread_buffer();
+
+    size_t get_capacity() const noexcept;
+
+    std::chrono::milliseconds get_flush_interval() const noexcept;
+
+public:
+
+    // the buffer's mutex must be held by the caller
+    void flush(
+        thread_buffer &buffer) noexcept;
+
+    void flush_all() noexcept;
+
+private:
+
+    void run_flusher();
+
+};
+
+#endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_STAGING_BUFFERS_H
\ No newline at end of file
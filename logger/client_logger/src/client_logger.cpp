@@ -1,39 +1,336 @@
-#include <not_implemented.h>
-
 #include "../include/client_logger.h"
 
+std::map<std::string, std::pair<rotating_file_stream *, size_t>> client_logger::_all_file_streams;
+
+std::mutex client_logger::_all_file_streams_mutex;
+
+std::mutex client_logger::_console_stream_mutex;
+
 client_logger::client_logger(
-    client_logger const &other)
+    std::map<std::string, std::set<logger::severity>> const &file_streams_setup,
+    std::map<std::string, rotating_file_stream::rotation_policy> const &file_streams_rotation_setup,
+    std::set<logger::severity> const &console_stream_severities,
+    size_t staging_buffer_capacity,
+    std::chrono::milliseconds staging_buffer_flush_interval):
+        _console_stream_severities(console_stream_severities),
+        _staging_buffers(nullptr)
 {
-    throw not_implemented("client_logger::client_logger(client_logger const &other)", "your code should be here...");
+    try
+    {
+        for (auto const &file_stream_setup: file_streams_setup)
+        {
+            auto const rotation_setup = file_streams_rotation_setup.find(file_stream_setup.first);
+
+            rotating_file_stream *stream = acquire_file_stream(
+                file_stream_setup.first,
+                rotation_setup == file_streams_rotation_setup.end()
+                    ? rotating_file_stream::rotation_policy()
+                    : rotation_setup->second);
+
+            _file_streams[file_stream_setup.first] = std::make_pair(stream, file_stream_setup.second);
+        }
+
+        create_staging_buffers(staging_buffer_capacity, staging_buffer_flush_interval);
+    }
+    catch (...)
+    {
+        release_file_streams();
+        throw;
+    }
+}
+
+client_logger::client_logger(
+    client_logger const &other):
+        _console_stream_severities(other._console_stream_severities),
+        _staging_buffers(nullptr)
+{
+    _file_streams = acquire_file_streams(other._file_streams);
+
+    try
+    {
+        if (other._staging_buffers != nullptr)
+        {
+            create_staging_buffers(other._staging_buffers->get_capacity(), other._staging_buffers->get_flush_interval());
+        }
+    }
+    catch (...)
+    {
+        // the destructor of a logger whose constructor threw never runs
+        release_file_streams();
+        throw;
+    }
 }
 
 client_logger &client_logger::operator=(
     client_logger const &other)
 {
-    throw not_implemented("client_logger &client_logger::operator=(client_logger const &other)", "your code should be here...");
+    if (this != &other)
+    {
+        // the copy holds everything before *this lets its own resources go, so a throw leaves *this as it was
+        client_logger copy(other);
+        *this = std::move(copy);
+    }
+
+    return *this;
 }
 
 client_logger::client_logger(
-    client_logger &&other) noexcept
+    client_logger &&other) noexcept:
+        _file_streams(std::move(other._file_streams)),
+        _console_stream_severities(std::move(other._console_stream_severities)),
+        _staging_buffers(other._staging_buffers)
 {
-    throw not_implemented("client_logger::client_logger(client_logger &&other) noexcept", "your code should be here...");
+    other._file_streams.clear();
+    other._staging_buffers = nullptr;
 }
 
 client_logger &client_logger::operator=(
     client_logger &&other) noexcept
 {
-    throw not_implemented("client_logger &client_logger::operator=(client_logger &&other) noexcept", "your code should be here...");
+    if (this != &other)
+    {
+        destroy_staging_buffers();
+        release_file_streams();
+
+        _file_streams = std::move(other._file_streams);
+        _console_stream_severities = std::move(other._console_stream_severities);
+        _staging_buffers = other._staging_buffers;
+
+        other._file_streams.clear();
+        other._staging_buffers = nullptr;
+    }
+
+    return *this;
 }
 
 client_logger::~client_logger() noexcept
 {
-    throw not_implemented("client_logger::~client_logger() noexcept", "your code should be here...");
+    destroy_staging_buffers();
+    release_file_streams();
 }
 
 logger const *client_logger::log(
     const std::string &text,
     logger::severity severity) const noexcept
 {
-    throw not_implemented("logger const *client_logger::log(const std::string &text, logger::severity severity) const noexcept", "your code should be here...");
+    try
+    {
+        bool const console_stream_accepts = _console_stream_severities.count(severity) != 0;
+
+        bool any_stream_accepts = console_stream_accepts;
+        for (auto const &file_stream: _file_streams)
+        {
+            any_stream_accepts = any_stream_accepts || file_stream.second.second.count(severity) != 0;
+        }
+
+        if (!any_stream_accepts)
+        {
+            return this;
+        }
+
+        std::string const record = '[' + current_datetime_to_string() + "][" + severity_to_string(severity) + "] " + text + '\n';
+
+        if (_staging_buffers == nullptr)
+        {
+            for (auto const &file_stream: _file_streams)
+            {
+                if (file_stream.second.second.count(severity) != 0)
+                {
+                    file_stream.second.first->write(record);
+                }
+            }
+
+            if (console_stream_accepts)
+            {
+                std::lock_guard<std::mutex> lock(_console_stream_mutex);
+                std::cout << record;
+            }
+
+            if (severity == logger::severity::error || severity == logger::severity::critical)
+            {
+                flush_file_streams();
+            }
+
+            return this;
+        }
+
+        auto &buffer = _staging_buffers->current_thread_buffer();
+        std::lock_guard<std::mutex> lock(buffer.mutex);
+
+        size_t destination = 0;
+        for (auto const &file_stream: _file_streams)
+        {
+            if (file_stream.second.second.count(severity) != 0)
+            {
+                buffer.records[destination] += record;
+                buffer.size += record.size();
+            }
+            ++destination;
+        }
+
+        if (console_stream_accepts)
+        {
+            buffer.records[destination] += record;
+            buffer.size += record.size();
+        }
+
+        if (severity == logger::severity::error || severity == logger::severity::critical)
+        {
+            _staging_buffers->flush(buffer);
+            flush_file_streams();
+        }
+        else if (buffer.size >= _staging_buffers->get_capacity())
+        {
+            _staging_buffers->flush(buffer);
+        }
+    }
+    catch (...)
+    {
+
+    }
+
+    return this;
+}
+
+rotating_file_stream *client_logger::acquire_file_stream(
+    std::string const &file_path,
+    rotating_file_stream::rotation_policy const &policy)
+{
+    std::lock_guard<std::mutex> lock(_all_file_streams_mutex);
+
+    auto shared_stream = _all_file_streams.find(file_path);
+    if (shared_stream != _all_file_streams.end())
+    {
+        // the stream is already opened by another logger, its rotation policy wins
+        ++shared_stream->second.second;
+        return shared_stream->second.first;
+    }
+
+    auto *stream = new rotating_file_stream(file_path, policy);
+    try
+    {
+        _all_file_streams.emplace(file_path, std::make_pair(stream, static_cast<size_t>(1)));
+    }
+    catch (...)
+    {
+        delete stream;
+        throw;
+    }
+
+    return stream;
+}
+
+void client_logger::release_file_stream(
+    std::string const &file_path) noexcept
+{
+    std::lock_guard<std::mutex> lock(_all_file_streams_mutex);
+
+    auto shared_stream = _all_file_streams.find(file_path);
+    if (shared_stream == _all_file_streams.end())
+    {
+        return;
+    }
+
+    if (--shared_stream->second.second == 0)
+    {
+        delete shared_stream->second.first;
+        _all_file_streams.erase(shared_stream);
+    }
+}
+
+std::map<std::string, std::pair<rotating_file_stream *, std::set<logger::severity>>> client_logger::acquire_file_streams(
+    std::map<std::string, std::pair<rotating_file_stream *, std::set<logger::severity>>> const &file_streams)
+{
+    std::map<std::string, std::pair<rotating_file_stream *, std::set<logger::severity>>> acquired;
+    try
+    {
+        for (auto const &file_stream: file_streams)
+        {
+            // the entry exists before its stream is acquired, so a failed insertion acquires nothing
+            auto &acquired_stream = acquired[file_stream.first];
+            acquired_stream.second = file_stream.second.second;
+            acquired_stream.first = acquire_file_stream(
+                file_stream.first,
+                file_stream.second.first->get_rotation_policy());
+        }
+    }
+    catch (...)
+    {
+        for (auto const &acquired_stream: acquired)
+        {
+            if (acquired_stream.second.first != nullptr)
+            {
+                release_file_stream(acquired_stream.first);
+            }
+        }
+        throw;
+    }
+
+    return acquired;
+}
+
+void client_logger::release_file_streams() noexcept
+{
+    for (auto const &file_stream: _file_streams)
+    {
+        release_file_stream(file_stream.first);
+    }
+
+    _file_streams.clear();
+}
+
+void client_logger::create_staging_buffers(
+    size_t capacity,
+    std::chrono::milliseconds flush_interval)
+{
+    if (capacity == 0)
+    {
+        return;
+    }
+
+    std::vector<rotating_file_stream *> file_streams;
+    for (auto const &file_stream: _file_streams)
+    {
+        file_streams.push_back(file_stream.second.first);
+    }
+
+    // the last destination is the console
+    _staging_buffers = new staging_buffers(
+        file_streams.size() + 1,
+        capacity,
+        flush_interval,
+        [file_streams](size_t destination, std::string const &records)
+        {
+            write_records(file_streams, destination, records);
+        });
+}
+
+void client_logger::destroy_staging_buffers() noexcept
+{
+    // flushes whatever is still staged while the file streams are alive
+    delete _staging_buffers;
+    _staging_buffers = nullptr;
+}
+
+void client_logger::write_records(
+    std::vector<rotating_file_stream *> const &file_streams,
+    size_t destination,
+    std::string const &records)
+{
+    if (destination < file_streams.size())
+    {
+        file_streams[destination]->write(records);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(_console_stream_mutex);
+    std::cout << records;
+}
+
+void client_logger::flush_file_streams() const noexcept
+{
+    for (auto const &file_stream: _file_streams)
+    {
+        file_stream.second.first->flush();
+    }
 }
\ No newline at end of file
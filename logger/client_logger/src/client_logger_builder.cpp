@@ -1,67 +1,145 @@
-#include <not_implemented.h>
+#include <fstream>
+
+#include <nlohmann/json.hpp>
 
 #include "../include/client_logger_builder.h"
+#include "../include/client_logger.h"
 
-client_logger_builder::client_logger_builder()
+client_logger_builder::client_logger_builder():
+    _staging_buffer_capacity(0),
+    _staging_buffer_flush_interval(0)
 {
-    throw not_implemented("client_logger_builder::client_logger_builder()", "your code should be here...");
+
 }
 
 client_logger_builder::client_logger_builder(
-    client_logger_builder const &other)
-{
-    throw not_implemented("client_logger_builder::client_logger_builder(client_logger_builder const &other)", "your code should be here...");
-}
+    client_logger_builder const &other) = default;
 
 client_logger_builder &client_logger_builder::operator=(
-    client_logger_builder const &other)
-{
-    throw not_implemented("client_logger_builder &client_logger_builder::operator=(client_logger_builder const &other)", "your code should be here...");
-}
+    client_logger_builder const &other) = default;
 
 client_logger_builder::client_logger_builder(
-    client_logger_builder &&other) noexcept
-{
-    throw not_implemented("client_logger_builder::client_logger_builder(client_logger_builder &&other) noexcept", "your code should be here...");
-}
+    client_logger_builder &&other) noexcept = default;
 
 client_logger_builder &client_logger_builder::operator=(
-    client_logger_builder &&other) noexcept
-{
-    throw not_implemented("client_logger_builder &client_logger_builder::operator=(client_logger_builder &&other) noexcept", "your code should be here...");
-}
+    client_logger_builder &&other) noexcept = default;
 
-client_logger_builder::~client_logger_builder() noexcept
-{
-    throw not_implemented("client_logger_builder::~client_logger_builder() noexcept", "your code should be here...");
-}
+client_logger_builder::~client_logger_builder() noexcept = default;
 
 logger_builder *client_logger_builder::add_file_stream(
     std::string const &stream_file_path,
     logger::severity severity)
 {
-    throw not_implemented("logger_builder *client_logger_builder::add_file_stream(std::string const &stream_file_path, logger::severity severity)", "your code should be here...");
+    _file_streams_setup[stream_file_path].insert(severity);
+
+    return this;
 }
 
 logger_builder *client_logger_builder::add_console_stream(
     logger::severity severity)
 {
-    throw not_implemented("logger_builder *client_logger_builder::add_console_stream(logger::severity severity)", "your code should be here...");
+    _console_stream_severities.insert(severity);
+
+    return this;
+}
+
+client_logger_builder *client_logger_builder::set_file_stream_rotation(
+    std::string const &stream_file_path,
+    rotating_file_stream::rotation_policy const &policy)
+{
+    _file_streams_rotation_setup[stream_file_path] = policy;
+
+    return this;
+}
+
+client_logger_builder *client_logger_builder::set_staging_buffer(
+    size_t capacity,
+    std::chrono::milliseconds flush_interval)
+{
+    _staging_buffer_capacity = capacity;
+    _staging_buffer_flush_interval = flush_interval;
+
+    return this;
 }
 
 logger_builder* client_logger_builder::transform_with_configuration(
     std::string const &configuration_file_path,
     std::string const &configuration_path)
 {
-    throw not_implemented("logger_builder* client_logger_builder::transform_with_configuration(std::string const &configuration_file_path, std::string const &configuration_path)", "your code should be here...");
+    std::ifstream configuration_file(configuration_file_path);
+    if (!configuration_file.is_open())
+    {
+        throw std::runtime_error("can't open configuration file \"" + configuration_file_path + "\"");
+    }
+
+    nlohmann::json const configuration = nlohmann::json::parse(configuration_file);
+    nlohmann::json const &logger_configuration = !configuration_path.empty() && configuration_path.front() == '/'
+        ? configuration.at(nlohmann::json::json_pointer(configuration_path))
+        : configuration.at(configuration_path);
+
+    if (logger_configuration.contains("console"))
+    {
+        for (auto const &severity: logger_configuration.at("console"))
+        {
+            add_console_stream(string_to_severity(severity.get<std::string>()));
+        }
+    }
+
+    if (logger_configuration.contains("files"))
+    {
+        for (auto const &file_stream: logger_configuration.at("files"))
+        {
+            auto const file_path = file_stream.at("path").get<std::string>();
+
+            for (auto const &severity: file_stream.at("severities"))
+            {
+                add_file_stream(file_path, string_to_severity(severity.get<std::string>()));
+            }
+
+            if (file_stream.contains("rotation"))
+            {
+                auto const &rotation = file_stream.at("rotation");
+
+                rotating_file_stream::rotation_policy policy;
+                policy.max_file_size = rotation.value("max_file_size", policy.max_file_size);
+                policy.max_file_age = std::chrono::seconds(rotation.value("max_file_age", policy.max_file_age.count()));
+                policy.retained_files_count = rotation.value("retained_files_count", policy.retained_files_count);
+                policy.compress_rotated_files = rotation.value("compress_rotated_files", policy.compress_rotated_files);
+
+                set_file_stream_rotation(file_path, policy);
+            }
+        }
+    }
+
+    if (logger_configuration.contains("staging_buffer"))
+    {
+        auto const &staging_buffer = logger_configuration.at("staging_buffer");
+
+        set_staging_buffer(
+            staging_buffer.value("capacity", static_cast<size_t>(0)),
+            std::chrono::milliseconds(staging_buffer.value("flush_interval", static_cast<long long>(100))));
+    }
+
+    return this;
 }
 
 logger_builder *client_logger_builder::clear()
 {
-    throw not_implemented("logger_builder *client_logger_builder::clear()", "your code should be here...");
+    _file_streams_setup.clear();
+    _file_streams_rotation_setup.clear();
+    _console_stream_severities.clear();
+    _staging_buffer_capacity = 0;
+    _staging_buffer_flush_interval = std::chrono::milliseconds(0);
+
+    return this;
 }
 
 logger *client_logger_builder::build() const
 {
-    throw not_implemented("logger *client_logger_builder::build() const", "your code should be here...");
+    return new client_logger(
+        _file_streams_setup,
+        _file_streams_rotation_setup,
+        _console_stream_severities,
+        _staging_buffer_capacity,
+        _staging_buffer_flush_interval);
 }
\ No newline at end of file
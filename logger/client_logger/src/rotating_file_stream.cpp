@@ -0,0 +1,373 @@
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <queue>
+#include <thread>
+
+#ifdef MP_OS_LGGR_CLNT_LGGR_WITH_ZLIB
+#include <zlib.h>
+#endif
+
+#include "../include/rotating_file_stream.h"
+
+namespace
+{
+
+    std::atomic<size_t> staged_files_count(0);
+
+    class rotation_worker final
+    {
+
+    private:
+
+        struct rotation_job
+        {
+
+            std::string staged_file_path;
+
+            std::string file_path;
+
+            rotating_file_stream::rotation_policy policy;
+
+        };
+
+    private:
+
+        std::queue<rotation_job> _jobs;
+
+        size_t _jobs_in_progress;
+
+        bool _stopped;
+
+        std::mutex _mutex;
+
+        std::condition_variable _jobs_available;
+
+        std::condition_variable _jobs_done;
+
+        std::thread _thread;
+
+    public:
+
+        static rotation_worker &instance()
+        {
+            static rotation_worker worker;
+            return worker;
+        }
+
+    private:
+
+        rotation_worker():
+            _jobs_in_progress(0),
+            _stopped(false),
+            _thread(&rotation_worker::run, this)
+        {
+
+        }
+
+    public:
+
+        ~rotation_worker() noexcept
+        {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _stopped = true;
+            }
+            _jobs_available.notify_all();
+            _thread.join();
+        }
+
+    public:
+
+        void enqueue(
+            std::string const &staged_file_path,
+            std::string const &file_path,
+            rotating_file_stream::rotation_policy const &policy)
+        {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _jobs.push(rotation_job { staged_file_path, file_path, policy });
+            }
+            _jobs_available.notify_one();
+        }
+
+        void wait()
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _jobs_done.wait(lock, [this]() { return _jobs.empty() && _jobs_in_progress == 0; });
+        }
+
+    private:
+
+        void run()
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+
+            while (true)
+            {
+                _jobs_available.wait(lock, [this]() { return _stopped || !_jobs.empty(); });
+                if (_jobs.empty())
+                {
+                    // stopped and drained
+                    return;
+                }
+
+                rotation_job job = std::move(_jobs.front());
+                _jobs.pop();
+                ++_jobs_in_progress;
+
+                lock.unlock();
+                process(job);
+                lock.lock();
+
+                --_jobs_in_progress;
+                if (_jobs.empty() && _jobs_in_progress == 0)
+                {
+                    _jobs_done.notify_all();
+                }
+            }
+        }
+
+        static bool file_exists(
+            std::string const &file_path)
+        {
+            return std::ifstream(file_path).good();
+        }
+
+        static std::string archive_path(
+            std::string const &file_path,
+            size_t index,
+            bool compressed)
+        {
+            return file_path + '.' + std::to_string(index) + (compressed ? ".gz" : "");
+        }
+
+        static void shift_archive(
+            std::string const &file_path,
+            size_t from_index)
+        {
+            for (bool compressed: { false, true })
+            {
+                std::string const from = archive_path(file_path, from_index, compressed);
+                if (file_exists(from))
+                {
+                    std::rename(from.c_str(), archive_path(file_path, from_index + 1, compressed).c_str());
+                }
+            }
+        }
+
+        static void remove_archive(
+            std::string const &file_path,
+            size_t index)
+        {
+            std::remove(archive_path(file_path, index, false).c_str());
+            std::remove(archive_path(file_path, index, true).c_str());
+        }
+
+        static void compress(
+            std::string const &file_path)
+        {
+#ifdef MP_OS_LGGR_CLNT_LGGR_WITH_ZLIB
+            std::ifstream source(file_path, std::ios::binary);
+            std::string const target_path = file_path + ".gz";
+            std::string const staged_target_path = target_path + ".tmp";
+
+            gzFile target = gzopen(staged_target_path.c_str(), "wb");
+            if (!source.is_open() || target == nullptr)
+            {
+                if (target != nullptr)
+                {
+                    gzclose(target);
+                }
+                return;
+            }
+
+            char buffer[1 << 16];
+            bool succeeded = true;
+            while (source.read(buffer, sizeof(buffer)) || source.gcount() > 0)
+            {
+                if (gzwrite(target, buffer, static_cast<unsigned int>(source.gcount())) == 0)
+                {
+                    succeeded = false;
+                    break;
+                }
+            }
+
+            succeeded = gzclose(target) == Z_OK && succeeded;
+            source.close();
+
+            if (succeeded)
+            {
+                std::rename(staged_target_path.c_str(), target_path.c_str());
+                std::remove(file_path.c_str());
+            }
+            else
+            {
+                std::remove(staged_target_path.c_str());
+            }
+#endif
+        }
+
+        static void process(
+            rotation_job const &job)
+        {
+            size_t const retained_files_count = job.policy.retained_files_count;
+
+            if (retained_files_count == 0)
+            {
+                std::remove(job.staged_file_path.c_str());
+                return;
+            }
+
+            remove_archive(job.file_path, retained_files_count);
+            for (size_t index = retained_files_count - 1; index > 0; --index)
+            {
+                shift_archive(job.file_path, index);
+            }
+
+            std::string const first_archive_path = archive_path(job.file_path, 1, false);
+            std::rename(job.staged_file_path.c_str(), first_archive_path.c_str());
+
+            if (job.policy.compress_rotated_files)
+            {
+                compress(first_archive_path);
+            }
+        }
+
+    };
+
+}
+
+bool rotating_file_stream::rotation_policy::rotation_enabled() const noexcept
+{
+    return max_file_size != 0 || max_file_age.count() != 0;
+}
+
+rotating_file_stream::rotating_file_stream(
+    std::string const &file_path,
+    rotation_policy const &policy):
+        _file_path(file_path),
+        _policy(policy),
+        _written_bytes(0)
+{
+    if (_policy.rotation_enabled())
+    {
+        // started before any stream can enqueue work, so it outlives every stream
+        rotation_worker::instance();
+    }
+
+    open();
+}
+
+rotating_file_stream::~rotating_file_stream() noexcept
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stream.close();
+}
+
+void rotating_file_stream::write(
+    std::string const &record) noexcept
+{
+    try
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        if (rotation_required(record.size()))
+        {
+            rotate();
+        }
+
+        _stream.write(record.data(), static_cast<std::streamsize>(record.size()));
+        _written_bytes += record.size();
+    }
+    catch (...)
+    {
+
+    }
+}
+
+void rotating_file_stream::flush() noexcept
+{
+    try
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stream.flush();
+    }
+    catch (...)
+    {
+
+    }
+}
+
+std::string const &rotating_file_stream::get_file_path() const noexcept
+{
+    return _file_path;
+}
+
+rotating_file_stream::rotation_policy const &rotating_file_stream::get_rotation_policy() const noexcept
+{
+    return _policy;
+}
+
+void rotating_file_stream::wait_for_pending_rotations()
+{
+    rotation_worker::instance().wait();
+}
+
+bool rotating_file_stream::rotation_required(
+    size_t next_record_size) const noexcept
+{
+    if (_written_bytes == 0)
+    {
+        return false;
+    }
+
+    if (_policy.max_file_size != 0 && _written_bytes + next_record_size > _policy.max_file_size)
+    {
+        return true;
+    }
+
+    return _policy.max_file_age.count() != 0
+        && std::chrono::steady_clock::now() - _opened_at >= _policy.max_file_age;
+}
+
+void rotating_file_stream::rotate() noexcept
+{
+    // only the O(1) part happens on the logging thread: the active file is atomically renamed
+    // to a unique staged name and reopened, renumbering/compression/pruning is done by the worker
+    std::string const staged_file_path = _file_path + ".rotating." + std::to_string(staged_files_count++);
+
+    _stream.close();
+
+    if (std::rename(_file_path.c_str(), staged_file_path.c_str()) == 0)
+    {
+        try
+        {
+            rotation_worker::instance().enqueue(staged_file_path, _file_path, _policy);
+        }
+        catch (...)
+        {
+
+        }
+    }
+
+    open();
+}
+
+void rotating_file_stream::open() noexcept
+{
+    _written_bytes = 0;
+    {
+        std::ifstream existing(_file_path, std::ios::binary | std::ios::ate);
+        if (existing.is_open())
+        {
+            std::streamoff const existing_size = existing.tellg();
+            _written_bytes = existing_size > 0
+                ? static_cast<size_t>(existing_size)
+                : 0;
+        }
+    }
+
+    _stream.open(_file_path, std::ios::out | std::ios::app | std::ios::binary);
+    _opened_at = std::chrono::steady_clock::now();
+}
\ No newline at end of file
@@ -0,0 +1,143 @@
+#include <unordered_map>
+
+#include "../include/staging_buffers.h"
+
+std::atomic<uint64_t> staging_buffers::_instances_count(0);
+
+staging_buffers::staging_buffers(
+    size_t destinations_count,
+    size_t capacity,
+    std::chrono::milliseconds flush_interval,
+    destination_writer write):
+        _id(_instances_count++),
+        _destinations_count(destinations_count),
+        _capacity(capacity),
+        _flush_interval(flush_interval),
+        _write(std::move(write)),
+        _flusher_stopped(false)
+{
+    if (_flush_interval.count() > 0)
+    {
+        _flusher = std::thread(&staging_buffers::run_flusher, this);
+    }
+}
+
+staging_buffers::~staging_buffers() noexcept
+{
+    if (_flusher.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(_flusher_mutex);
+            _flusher_stopped = true;
+        }
+        _flusher_wakeup.notify_all();
+        _flusher.join();
+    }
+
+    flush_all();
+}
+
+staging_buffers::thread_buffer &staging_buffers::current_thread_buffer()
+{
+    // ids are never reused, so an entry left by a destroyed instance can't be picked up by a new one
+    thread_local std::unordered_map<uint64_t, std::shared_ptr<thread_buffer>> buffers;
+
+    auto found = buffers.find(_id);
+    if (found != buffers.end())
+    {
+        return *found->second;
+    }
+
+    for (auto buffer = buffers.begin(); buffer != buffers.end();)
+    {
+        // the owning instance has released it
+        buffer = buffer->second.use_count() == 1
+            ? buffers.erase(buffer)
+            : std::next(buffer);
+    }
+
+    auto buffer = std::make_shared<thread_buffer>();
+    buffer->records.resize(_destinations_count);
+    for (auto &records: buffer->records)
+    {
+        records.reserve(_capacity);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_thread_buffers_mutex);
+        _thread_buffers.push_back(buffer);
+    }
+
+    return *buffers.emplace(_id, std::move(buffer)).first->second;
+}
+
+size_t staging_buffers::get_capacity() const noexcept
+{
+    return _capacity;
+}
+
+std::chrono::milliseconds staging_buffers::get_flush_interval() const noexcept
+{
+    return _flush_interval;
+}
+
+void staging_buffers::flush(
+    thread_buffer &buffer) noexcept
+{
+    if (buffer.size == 0)
+    {
+        return;
+    }
+
+    for (size_t destination = 0; destination < buffer.records.size(); ++destination)
+    {
+        auto &records = buffer.records[destination];
+        if (records.empty())
+        {
+            continue;
+        }
+
+        try
+        {
+            _write(destination, records);
+        }
+        catch (...)
+        {
+
+        }
+
+        records.clear();
+    }
+
+    buffer.size = 0;
+}
+
+void staging_buffers::flush_all() noexcept
+{
+    std::lock_guard<std::mutex> lock(_thread_buffers_mutex);
+
+    for (auto buffer = _thread_buffers.begin(); buffer != _thread_buffers.end();)
+    {
+        {
+            std::lock_guard<std::mutex> buffer_lock((*buffer)->mutex);
+            flush(**buffer);
+        }
+
+        // the owning thread has exited
+        buffer = buffer->use_count() == 1
+            ? _thread_buffers.erase(buffer)
+            : std::next(buffer);
+    }
+}
+
+void staging_buffers::run_flusher()
+{
+    std::unique_lock<std::mutex> lock(_flusher_mutex);
+
+    while (!_flusher_wakeup.wait_for(lock, _flush_interval, [this]() { return _flusher_stopped; }))
+    {
+        lock.unlock();
+        flush_all();
+        lock.lock();
+    }
+}
\ No newline at end of file
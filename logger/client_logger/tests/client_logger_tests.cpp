@@ -1,6 +1,224 @@
 #include <gtest/gtest.h>
 
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <vector>
 
+#include <client_logger.h>
+
+namespace
+{
+
+    bool file_exists(
+        std::string const &file_path)
+    {
+        return std::ifstream(file_path).good();
+    }
+
+    std::string read_file(
+        std::string const &file_path)
+    {
+        std::ifstream file(file_path);
+        std::stringstream content;
+        content << file.rdbuf();
+        return content.str();
+    }
+
+    void remove_files(
+        std::string const &file_path,
+        size_t archives_count)
+    {
+        std::remove(file_path.c_str());
+        for (size_t index = 1; index <= archives_count; ++index)
+        {
+            std::remove((file_path + '.' + std::to_string(index)).c_str());
+            std::remove((file_path + '.' + std::to_string(index) + ".gz").c_str());
+        }
+    }
+
+}
+
+TEST(positive_tests, test1)
+{
+    std::string const file_path = "client_logger_test1.txt";
+    remove_files(file_path, 0);
+
+    logger_builder *builder = new client_logger_builder();
+    logger *logger = builder
+        ->add_file_stream(file_path, logger::severity::information)
+        ->add_file_stream(file_path, logger::severity::error)
+        ->build();
+    delete builder;
+
+    logger
+        ->information("first message")
+        ->debug("filtered message")
+        ->error("second message");
+    delete logger;
+
+    std::string const content = read_file(file_path);
+    EXPECT_NE(content.find("[INFORMATION] first message"), std::string::npos);
+    EXPECT_NE(content.find("[ERROR] second message"), std::string::npos);
+    EXPECT_EQ(content.find("filtered message"), std::string::npos);
+
+    remove_files(file_path, 0);
+}
+
+TEST(positive_tests, test2)
+{
+    std::string const file_path = "client_logger_test2.txt";
+    remove_files(file_path, 5);
+
+    rotating_file_stream::rotation_policy policy;
+    policy.max_file_size = 256;
+    policy.retained_files_count = 3;
+
+    client_logger_builder builder;
+    builder.add_file_stream(file_path, logger::severity::information);
+    builder.set_file_stream_rotation(file_path, policy);
+    logger *logger = builder.build();
+
+    for (size_t i = 0; i < 100; ++i)
+    {
+        logger->information("message #" + std::to_string(i));
+    }
+    delete logger;
+
+    rotating_file_stream::wait_for_pending_rotations();
+
+    EXPECT_TRUE(file_exists(file_path));
+    EXPECT_LE(read_file(file_path).size(), policy.max_file_size);
+    EXPECT_TRUE(file_exists(file_path + ".1"));
+    EXPECT_TRUE(file_exists(file_path + ".3"));
+    EXPECT_FALSE(file_exists(file_path + ".4"));
+    EXPECT_NE(read_file(file_path).find("message #99"), std::string::npos);
+
+    remove_files(file_path, 5);
+}
+
+TEST(positive_tests, test3)
+{
+    std::string const file_path = "client_logger_test3.txt";
+    remove_files(file_path, 0);
+
+    client_logger_builder builder;
+    builder.add_file_stream(file_path, logger::severity::warning);
+    logger *original_logger = builder.build();
+
+    auto *copied_logger = new client_logger(*dynamic_cast<client_logger *>(original_logger));
+    delete original_logger;
+
+    copied_logger->warning("written through copy");
+    delete copied_logger;
+
+    EXPECT_NE(read_file(file_path).find("[WARNING] written through copy"), std::string::npos);
+
+    remove_files(file_path, 0);
+}
+
+TEST(positive_tests, test4)
+{
+    std::string const file_path = "client_logger_test4.txt";
+    remove_files(file_path, 3);
+
+    rotating_file_stream::rotation_policy policy;
+    policy.max_file_size = 128;
+    policy.retained_files_count = 2;
+    policy.compress_rotated_files = true;
+
+    client_logger_builder builder;
+    builder.add_file_stream(file_path, logger::severity::critical);
+    builder.set_file_stream_rotation(file_path, policy);
+    logger *logger = builder.build();
+
+    for (size_t i = 0; i < 20; ++i)
+    {
+        logger->critical("message #" + std::to_string(i));
+    }
+    delete logger;
+
+    rotating_file_stream::wait_for_pending_rotations();
+
+    // archives are gzipped only when built with zlib
+    EXPECT_TRUE(file_exists(file_path + ".1.gz") || file_exists(file_path + ".1"));
+    EXPECT_FALSE(file_exists(file_path + ".3.gz") || file_exists(file_path + ".3"));
+
+    remove_files(file_path, 3);
+}
+
+TEST(positive_tests, test5)
+{
+    std::string const file_path = "client_logger_test5.txt";
+    remove_files(file_path, 0);
+
+    client_logger_builder builder;
+    builder.add_file_stream(file_path, logger::severity::information);
+    builder.add_file_stream(file_path, logger::severity::error);
+    builder.set_staging_buffer(1 << 20, std::chrono::milliseconds(0));
+    logger *logger = builder.build();
+
+    logger->information("staged message");
+    EXPECT_EQ(read_file(file_path).find("staged message"), std::string::npos);
+
+    logger->error("error message");
+
+    // error records flush the records staged before them
+    std::string const content = read_file(file_path);
+    EXPECT_NE(content.find("staged message"), std::string::npos);
+    EXPECT_LT(content.find("staged message"), content.find("error message"));
+
+    delete logger;
+
+    remove_files(file_path, 0);
+}
+
+TEST(positive_tests, test6)
+{
+    std::string const file_path = "client_logger_test6.txt";
+    remove_files(file_path, 0);
+
+    size_t const threads_count = 4;
+    size_t const messages_count = 500;
+
+    client_logger_builder builder;
+    builder.add_file_stream(file_path, logger::severity::information);
+    builder.set_staging_buffer(512, std::chrono::milliseconds(1));
+    logger *logger = builder.build();
+
+    std::vector<std::thread> threads;
+    for (size_t thread_index = 0; thread_index < threads_count; ++thread_index)
+    {
+        threads.emplace_back([logger, thread_index, messages_count]()
+        {
+            for (size_t i = 0; i < messages_count; ++i)
+            {
+                logger->information("thread " + std::to_string(thread_index) + " message " + std::to_string(i) + ';');
+            }
+        });
+    }
+    for (auto &thread: threads)
+    {
+        thread.join();
+    }
+    delete logger;
+
+    std::string const content = read_file(file_path);
+    for (size_t thread_index = 0; thread_index < threads_count; ++thread_index)
+    {
+        size_t previous_position = 0;
+        for (size_t i = 0; i < messages_count; ++i)
+        {
+            size_t const position = content.find("thread " + std::to_string(thread_index) + " message " + std::to_string(i) + ';');
+            ASSERT_NE(position, std::string::npos);
+            EXPECT_GE(position, previous_position);
+            previous_position = position;
+        }
+    }
+
+    remove_files(file_path, 0);
+}
 
 int main(
     int argc,